@@ -0,0 +1,45 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+
+class AssetLoader;
+class GraphicsAPI;
+
+enum class AssetState {
+    Pending, // Queued, decoding, or waiting for the render thread
+    Ready,   // Resident and usable
+    Failed
+};
+
+// Anything loaded through AssetLoader. Loading is split in two so only the
+// GL part runs on the render thread: decode() reads and parses on a worker,
+// finalize() then creates GL objects from the decoded data.
+class Asset {
+public:
+    explicit Asset(const std::string& name) : name(name), state(AssetState::Pending) {}
+    virtual ~Asset() = default;
+    
+    Asset(const Asset&) = delete;
+    Asset& operator=(const Asset&) = delete;
+    
+    const std::string& getName() const { return name; }
+    AssetState getState() const { return state.load(std::memory_order_acquire); }
+    bool isReady() const { return getState() == AssetState::Ready; }
+    bool isPending() const { return getState() == AssetState::Pending; }
+    bool isFailed() const { return getState() == AssetState::Failed; }
+
+protected:
+    friend class AssetLoader;
+    
+    std::string name;
+    
+    // Worker thread: read source bytes and build CPU-side data
+    virtual bool decode(AssetLoader& loader) = 0;
+    
+    // Render thread: create GL objects from the decoded data
+    virtual bool finalize(GraphicsAPI* graphics) = 0;
+
+private:
+    std::atomic<AssetState> state;
+};
\ No newline at end of file
@@ -0,0 +1,90 @@
+#include "asset_loader.h"
+#include <fstream>
+#include <iostream>
+
+AssetLoader::AssetLoader(GraphicsAPI* graphics, GpuResources* resources, JobSystem* jobs, const AssetPack* pack)
+    : graphics(graphics), resources(resources), jobs(jobs), pack(pack), pending(0) {
+}
+
+AssetLoader::~AssetLoader() {
+    // Workers hold references into this loader until their decode finishes
+    if (jobs) {
+        jobs->wait(inFlight);
+    }
+}
+
+void AssetLoader::request(std::shared_ptr<Asset> asset) {
+    pending.fetch_add(1, std::memory_order_relaxed);
+    if (!jobs) {
+        decodeAsset(asset);
+        return;
+    }
+    jobs->run([this, asset]() { decodeAsset(asset); }, &inFlight);
+}
+
+void AssetLoader::decodeAsset(const std::shared_ptr<Asset>& asset) {
+    if (!asset->decode(*this)) {
+        printf("Failed to load asset: %s\n", asset->getName().c_str());
+        setState(*asset, AssetState::Failed);
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(decodedMutex);
+    decoded.push_back(asset);
+}
+
+int AssetLoader::update() {
+    std::vector<std::shared_ptr<Asset>> ready;
+    {
+        std::lock_guard<std::mutex> lock(decodedMutex);
+        ready.swap(decoded);
+    }
+    
+    int finalized = 0;
+    for (const std::shared_ptr<Asset>& asset : ready) {
+        if (asset->finalize(graphics)) {
+            setState(*asset, AssetState::Ready);
+            finalized++;
+        } else {
+            printf("Failed to finalize asset: %s\n", asset->getName().c_str());
+            setState(*asset, AssetState::Failed);
+        }
+    }
+    return finalized;
+}
+
+void AssetLoader::finishAll() {
+    if (jobs) {
+        jobs->wait(inFlight);
+    }
+    update();
+}
+
+void AssetLoader::setState(Asset& asset, AssetState state) {
+    asset.state.store(state, std::memory_order_release);
+    pending.fetch_sub(1, std::memory_order_relaxed);
+}
+
+AssetSpan AssetLoader::read(const std::string& name, std::vector<uint8_t>& storage) const {
+    // Packed copies are used in place once their hash checks out
+    if (pack && pack->contains(name)) {
+        if (pack->verify(name)) {
+            return pack->find(name);
+        }
+        printf("Asset pack entry corrupt, reading loose file: %s\n", name.c_str());
+    }
+    
+    std::ifstream file(name, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return AssetSpan();
+    }
+    
+    storage.resize((size_t)file.tellg());
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(storage.data()), storage.size());
+    
+    AssetSpan span;
+    span.data = storage.data();
+    span.size = storage.size();
+    return span;
+}
\ No newline at end of file
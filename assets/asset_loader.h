@@ -0,0 +1,71 @@
+#pragma once
+
+#include "asset.h"
+#include "asset_pack.h"
+#include "../core/job_system.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+class GraphicsAPI;
+class GpuResources;
+
+// Loads assets in the background and hands back handles right away; callers
+// draw placeholders until a handle reports ready. Decoding runs on the job
+// system, GL finalization happens in update() on the render thread.
+class AssetLoader {
+public:
+    // Without a job system (or with no workers) every load completes inside load().
+    // The pack, when given, is searched before loose files and must outlive the loader.
+    // GPU objects the assets create are owned through resources.
+    AssetLoader(GraphicsAPI* graphics, GpuResources* resources, JobSystem* jobs, const AssetPack* pack = nullptr);
+    ~AssetLoader();
+    
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+    
+    // Start loading an asset of type T constructed from args
+    template <typename T, typename... Args>
+    std::shared_ptr<T> load(Args&&... args) {
+        std::shared_ptr<T> asset = std::make_shared<T>(std::forward<Args>(args)...);
+        request(asset);
+        return asset;
+    }
+    
+    // Render thread, once per frame: finalize assets decoded since the last call.
+    // Returns how many became ready.
+    int update();
+    
+    // Block until every request has finished (tools and synchronous startup)
+    void finishAll();
+    
+    // Requests not yet ready or failed
+    int getPendingCount() const { return pending.load(std::memory_order_relaxed); }
+    
+    // Worker side: bytes of a named asset, from the pack when it holds a valid
+    // copy, otherwise read from disk into storage
+    AssetSpan read(const std::string& name, std::vector<uint8_t>& storage) const;
+    
+    GraphicsAPI* getGraphics() const { return graphics; }
+    GpuResources* getResources() const { return resources; }
+    JobSystem* getJobs() const { return jobs; }
+
+private:
+    GraphicsAPI* graphics;
+    GpuResources* resources;
+    JobSystem* jobs;
+    const AssetPack* pack;
+    
+    JobCounter inFlight;
+    std::atomic<int> pending;
+    std::mutex decodedMutex;
+    std::vector<std::shared_ptr<Asset>> decoded; // Waiting for finalize on the render thread
+    
+    void request(std::shared_ptr<Asset> asset);
+    void decodeAsset(const std::shared_ptr<Asset>& asset);
+    void setState(Asset& asset, AssetState state);
+};
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include "asset_pack.h"
+#include "../core/job_system.h"
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+AssetPack::AssetPack() : mapped(nullptr), mappedSize(0), header(nullptr), entries(nullptr) {
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::open(const std::string& path) {
+    close();
+    
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        printf("Failed to open asset pack: %s\n", path.c_str());
+        return false;
+    }
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(AssetPackHeader)) {
+        printf("Asset pack too small: %s\n", path.c_str());
+        ::close(fd);
+        return false;
+    }
+    
+    void* memory = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // The mapping keeps its own reference to the file
+    if (memory == MAP_FAILED) {
+        printf("Failed to map asset pack: %s\n", path.c_str());
+        return false;
+    }
+    
+    mapped = static_cast<const uint8_t*>(memory);
+    mappedSize = info.st_size;
+    header = reinterpret_cast<const AssetPackHeader*>(mapped);
+    
+    // Validate header
+    if (memcmp(header->magic, ASSET_PACK_MAGIC, sizeof(ASSET_PACK_MAGIC)) != 0 ||
+        header->version != ASSET_PACK_VERSION ||
+        header->fileSize != mappedSize) {
+        printf("Invalid asset pack header: %s\n", path.c_str());
+        close();
+        return false;
+    }
+    
+    // Validate table of contents bounds and alignment (the mapping itself is page aligned).
+    // Offsets come from the file, so limits are compared by subtraction to stay clear of overflow.
+    uint64_t tocSize = (uint64_t)header->entryCount * sizeof(AssetPackEntry);
+    if (header->tocOffset > mappedSize || tocSize > mappedSize - header->tocOffset ||
+        header->tocOffset % alignof(AssetPackEntry) != 0 || header->namesOffset > mappedSize) {
+        printf("Corrupt asset pack table of contents: %s\n", path.c_str());
+        close();
+        return false;
+    }
+    entries = reinterpret_cast<const AssetPackEntry*>(mapped + header->tocOffset);
+    
+    for (uint32_t i = 0; i < header->entryCount; i++) {
+        const AssetPackEntry& entry = entries[i];
+        uint64_t namesSize = mappedSize - header->namesOffset;
+        if (entry.size > mappedSize || entry.offset > mappedSize - entry.size ||
+            entry.nameOffset > namesSize || entry.nameLength > namesSize - entry.nameOffset) {
+            printf("Corrupt asset pack entry %u: %s\n", i, path.c_str());
+            close();
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+void AssetPack::close() {
+    if (mapped) {
+        munmap(const_cast<uint8_t*>(mapped), mappedSize);
+    }
+    mapped = nullptr;
+    mappedSize = 0;
+    header = nullptr;
+    entries = nullptr;
+}
+
+bool AssetPack::isOpen() const {
+    return mapped != nullptr;
+}
+
+AssetSpan AssetPack::find(std::string_view name) const {
+    const AssetPackEntry* entry = findEntry(name);
+    if (!entry) {
+        return AssetSpan();
+    }
+    
+    AssetSpan span;
+    span.data = mapped + entry->offset;
+    span.size = entry->size;
+    return span;
+}
+
+bool AssetPack::contains(std::string_view name) const {
+    return findEntry(name) != nullptr;
+}
+
+bool AssetPack::verify(std::string_view name) const {
+    const AssetPackEntry* entry = findEntry(name);
+    if (!entry) {
+        return false;
+    }
+    return hash(mapped + entry->offset, entry->size) == entry->contentHash;
+}
+
+bool AssetPack::verifyAll(JobSystem* jobs) const {
+    std::atomic<bool> valid(true);
+    auto verifyRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            const AssetPackEntry& entry = entries[i];
+            if (hash(mapped + entry.offset, entry.size) != entry.contentHash) {
+                printf("Asset pack hash mismatch: %.*s\n", (int)getEntryName(i).size(), getEntryName(i).data());
+                valid = false;
+            }
+        }
+    };
+    
+    // One entry per job; payloads vary from a few bytes to whole fonts
+    if (jobs) {
+        jobs->parallelFor(getEntryCount(), 1, verifyRange);
+    } else {
+        verifyRange(0, getEntryCount());
+    }
+    return valid;
+}
+
+size_t AssetPack::getEntryCount() const {
+    return header ? header->entryCount : 0;
+}
+
+const AssetPackEntry& AssetPack::getEntry(size_t index) const {
+    return entries[index];
+}
+
+std::string_view AssetPack::getEntryName(size_t index) const {
+    const AssetPackEntry& entry = entries[index];
+    return std::string_view(reinterpret_cast<const char*>(mapped + header->namesOffset + entry.nameOffset), entry.nameLength);
+}
+
+AssetSpan AssetPack::getEntryData(size_t index) const {
+    AssetSpan span;
+    span.data = mapped + entries[index].offset;
+    span.size = entries[index].size;
+    return span;
+}
+
+uint64_t AssetPack::hash(const void* data, size_t size) {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint64_t value = 0xcbf29ce484222325ull;
+    for (size_t i = 0; i < size; i++) {
+        value ^= bytes[i];
+        value *= 0x100000001b3ull;
+    }
+    return value;
+}
+
+uint64_t AssetPack::hash(std::string_view text) {
+    return hash(text.data(), text.size());
+}
+
+const AssetPackEntry* AssetPack::findEntry(std::string_view name) const {
+    if (!mapped) {
+        return nullptr;
+    }
+    
+    // Binary search on the sorted name hashes, then confirm the name itself
+    uint64_t nameHash = hash(name);
+    size_t low = 0;
+    size_t high = header->entryCount;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        if (entries[mid].nameHash < nameHash) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    
+    for (size_t i = low; i < header->entryCount && entries[i].nameHash == nameHash; i++) {
+        if (getEntryName(i) == name) {
+            return &entries[i];
+        }
+    }
+    return nullptr;
+}
\ No newline at end of file
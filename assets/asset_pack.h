@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+class JobSystem;
+
+// On-disk layout of an asset pack:
+//   AssetPackHeader
+//   AssetPackEntry[entryCount]   (sorted by nameHash)
+//   name strings                 (not null terminated)
+//   payloads                     (each aligned to header.alignment)
+const char ASSET_PACK_MAGIC[4] = {'E', 'J', 'P', 'K'};
+const uint32_t ASSET_PACK_VERSION = 1;
+const uint32_t ASSET_PACK_ALIGNMENT = 64;
+
+struct AssetPackHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t alignment;
+    uint64_t tocOffset;
+    uint64_t namesOffset;
+    uint64_t fileSize;
+};
+
+struct AssetPackEntry {
+    uint64_t nameHash;
+    uint64_t contentHash;
+    uint64_t offset;
+    uint64_t size;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+};
+
+// Read-only view into a mapped pack; valid while the pack stays open
+struct AssetSpan {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    
+    bool empty() const { return data == nullptr; }
+    std::string_view asString() const { return std::string_view(reinterpret_cast<const char*>(data), size); }
+};
+
+class AssetPack {
+public:
+    AssetPack();
+    ~AssetPack();
+    
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+    
+    // Map a pack file into memory and validate its header and table of contents
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+    
+    // Zero-copy lookup by asset name; returns an empty span if missing
+    AssetSpan find(std::string_view name) const;
+    bool contains(std::string_view name) const;
+    
+    // Recompute content hashes and compare against the table of contents;
+    // verifyAll hashes entries in parallel when given a job system
+    bool verify(std::string_view name) const;
+    bool verifyAll(JobSystem* jobs = nullptr) const;
+    
+    // Table of contents access
+    size_t getEntryCount() const;
+    const AssetPackEntry& getEntry(size_t index) const;
+    std::string_view getEntryName(size_t index) const;
+    AssetSpan getEntryData(size_t index) const;
+    
+    // FNV-1a, used for both names and payloads
+    static uint64_t hash(const void* data, size_t size);
+    static uint64_t hash(std::string_view text);
+
+private:
+    const uint8_t* mapped;
+    size_t mappedSize;
+    const AssetPackHeader* header;
+    const AssetPackEntry* entries;
+    
+    const AssetPackEntry* findEntry(std::string_view name) const;
+};
\ No newline at end of file
@@ -0,0 +1,102 @@
+#include "baked_font.h"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+BakedFont::BakedFont() : data(nullptr), size(0), header(nullptr), faces(nullptr) {
+}
+
+// A table of count records at offset lies inside the buffer and is aligned for its records.
+// Offsets come from the file, so the limit is compared by subtraction to stay clear of overflow.
+static bool tableFits(uint64_t offset, uint64_t count, size_t recordSize, size_t recordAlignment, size_t bufferSize) {
+    return offset <= bufferSize && count <= (bufferSize - offset) / recordSize && offset % recordAlignment == 0;
+}
+
+bool BakedFont::isBakedFont(const uint8_t* data, size_t size) {
+    return size >= sizeof(BakedFontHeader) && memcmp(data, BAKED_FONT_MAGIC, sizeof(BAKED_FONT_MAGIC)) == 0;
+}
+
+bool BakedFont::load(const uint8_t* fontData, size_t fontSize) {
+    data = nullptr;
+    header = nullptr;
+    faces = nullptr;
+    
+    if (!isBakedFont(fontData, fontSize)) {
+        printf("Not a baked font atlas\n");
+        return false;
+    }
+    
+    const BakedFontHeader* candidate = reinterpret_cast<const BakedFontHeader*>(fontData);
+    if (candidate->version != BAKED_FONT_VERSION) {
+        printf("Unsupported baked font version: %u\n", candidate->version);
+        return false;
+    }
+    
+    // Tables and pages must lie inside the buffer
+    uint64_t pageBytes = (uint64_t)candidate->pageWidth * candidate->pageHeight;
+    bool pagesFit = candidate->pagesOffset <= fontSize &&
+                    (pageBytes == 0 || candidate->pageCount <= (fontSize - candidate->pagesOffset) / pageBytes);
+    if (!tableFits(candidate->facesOffset, candidate->faceCount, sizeof(BakedFaceRecord), alignof(BakedFaceRecord), fontSize) ||
+        !pagesFit) {
+        printf("Corrupt baked font header\n");
+        return false;
+    }
+    
+    const BakedFaceRecord* candidateFaces = reinterpret_cast<const BakedFaceRecord*>(fontData + candidate->facesOffset);
+    for (uint32_t i = 0; i < candidate->faceCount; i++) {
+        const BakedFaceRecord& face = candidateFaces[i];
+        if (face.page >= candidate->pageCount ||
+            !tableFits(face.glyphsOffset, face.glyphCount, sizeof(BakedGlyphRecord), alignof(BakedGlyphRecord), fontSize) ||
+            !tableFits(face.kerningOffset, face.kerningCount, sizeof(BakedKerningRecord), alignof(BakedKerningRecord), fontSize)) {
+            printf("Corrupt baked font face %u\n", i);
+            return false;
+        }
+        
+        // Lookups binary-search the pairs, so their order is part of the format
+        const BakedKerningRecord* pairs = reinterpret_cast<const BakedKerningRecord*>(fontData + face.kerningOffset);
+        for (uint32_t k = 1; k < face.kerningCount; k++) {
+            if (pairs[k - 1].left > pairs[k].left ||
+                (pairs[k - 1].left == pairs[k].left && pairs[k - 1].right >= pairs[k].right)) {
+                printf("Unsorted baked kerning pairs in face %u\n", i);
+                return false;
+            }
+        }
+        
+        const BakedGlyphRecord* glyphs = reinterpret_cast<const BakedGlyphRecord*>(fontData + face.glyphsOffset);
+        for (uint32_t g = 0; g < face.glyphCount; g++) {
+            if ((uint32_t)glyphs[g].x + glyphs[g].width > candidate->pageWidth ||
+                (uint32_t)glyphs[g].y + glyphs[g].height > candidate->pageHeight) {
+                printf("Corrupt baked glyph %u in face %u\n", glyphs[g].codepoint, i);
+                return false;
+            }
+        }
+    }
+    
+    data = fontData;
+    size = fontSize;
+    header = candidate;
+    faces = candidateFaces;
+    return true;
+}
+
+const BakedFaceRecord* BakedFont::findFace(int pointSize) const {
+    const BakedFaceRecord* best = nullptr;
+    for (uint32_t i = 0; header && i < header->faceCount; i++) {
+        if (!best || abs((int)faces[i].pointSize - pointSize) < abs((int)best->pointSize - pointSize)) {
+            best = &faces[i];
+        }
+    }
+    return best;
+}
+
+const BakedGlyphRecord* BakedFont::getGlyphs(const BakedFaceRecord& face) const {
+    return reinterpret_cast<const BakedGlyphRecord*>(data + face.glyphsOffset);
+}
+
+const BakedKerningRecord* BakedFont::getKerning(const BakedFaceRecord& face) const {
+    return reinterpret_cast<const BakedKerningRecord*>(data + face.kerningOffset);
+}
+
+const uint8_t* BakedFont::getPage(uint32_t page) const {
+    return data + header->pagesOffset + (uint64_t)header->pageWidth * header->pageHeight * page;
+}
\ No newline at end of file
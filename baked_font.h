@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// On-disk layout of a baked font atlas, written by tools/font_baker:
+//   BakedFontHeader
+//   BakedFaceRecord[faceCount]          (one per point size)
+//   BakedGlyphRecord[] per face         (sorted by codepoint)
+//   BakedKerningRecord[] per face       (non-zero pairs, sorted by left then right)
+//   pages                               (pageWidth x pageHeight alpha bytes each)
+// A face never straddles pages, so loading one size is a single texture upload.
+const char BAKED_FONT_MAGIC[4] = {'E', 'J', 'F', 'A'};
+const uint32_t BAKED_FONT_VERSION = 1;
+
+struct BakedFontHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t faceCount;
+    uint32_t pageCount;
+    uint32_t pageWidth;
+    uint32_t pageHeight;
+    uint64_t facesOffset;
+    uint64_t pagesOffset;
+};
+
+struct BakedFaceRecord {
+    uint32_t pointSize;
+    uint32_t page;
+    float lineHeight;
+    uint32_t glyphCount;
+    uint32_t kerningCount;
+    uint32_t reserved;
+    uint64_t glyphsOffset;
+    uint64_t kerningOffset;
+};
+
+// Bitmaps are trimmed to their ink; the offset places them relative to the pen
+struct BakedGlyphRecord {
+    uint32_t codepoint;
+    uint16_t x, y;
+    uint16_t width, height;
+    int16_t xOffset, yOffset;
+    float advance;
+};
+
+struct BakedKerningRecord {
+    uint32_t left;
+    uint32_t right;
+    float amount;
+};
+
+// Read-only view of a baked atlas in memory; the data must outlive it
+class BakedFont {
+public:
+    BakedFont();
+    
+    // Validate the header and every table against the buffer size
+    bool load(const uint8_t* data, size_t size);
+    
+    // Cheap magic check, used to tell baked atlases from TTF files
+    static bool isBakedFont(const uint8_t* data, size_t size);
+    
+    // Face with the requested size, or the closest one
+    const BakedFaceRecord* findFace(int pointSize) const;
+    
+    const BakedGlyphRecord* getGlyphs(const BakedFaceRecord& face) const;
+    const BakedKerningRecord* getKerning(const BakedFaceRecord& face) const;
+    const uint8_t* getPage(uint32_t page) const;
+    
+    uint32_t getPageWidth() const { return header ? header->pageWidth : 0; }
+    uint32_t getPageHeight() const { return header ? header->pageHeight : 0; }
+
+private:
+    const uint8_t* data;
+    size_t size;
+    const BakedFontHeader* header;
+    const BakedFaceRecord* faces;
+};
\ No newline at end of file
@@ -3,6 +3,7 @@
 # Parse command line arguments
 BUILD_WEB=true
 BUILD_DESKTOP=true
+BUILD_TOOLS=false
 
 while [[ $# -gt 0 ]]; do
     case $1 in
@@ -16,11 +17,16 @@ while [[ $# -gt 0 ]]; do
             BUILD_DESKTOP=true
             shift
             ;;
+        --tools)
+            BUILD_TOOLS=true
+            shift
+            ;;
         *)
             echo "Unknown option: $1"
-            echo "Usage: $0 [--web-only|--desktop-only]"
+            echo "Usage: $0 [--web-only|--desktop-only] [--tools]"
             echo "  --web-only      Build only web version"
             echo "  --desktop-only  Build only desktop version"
+            echo "  --tools         Also build command-line tools (asset packer, font baker, benchmarks, label renderer, replay)"
             echo "  (no flags)      Build both versions"
             exit 1
             ;;
@@ -30,18 +36,59 @@ done
 echo "Build commenced at:" $(date)
 start_time=$(date +%s)
 
+# Command-line tools
+if [ "$BUILD_TOOLS" = true ]; then
+    echo "Building tools..."
+    
+    TOOL_INCLUDES="-I/opt/homebrew/include"
+    TOOL_LIBS="-L/opt/homebrew/lib -lSDL2 -lSDL2_ttf"
+    
+    g++ -std=c++17 -O2 -pthread tools/asset_packer.cpp assets/asset_pack.cpp core/job_system.cpp -o asset_packer && \
+    g++ -std=c++17 -O2 -pthread tools/font_baker.cpp font_library.cpp glyph_rasterizer.cpp core/job_system.cpp \
+      $TOOL_INCLUDES $TOOL_LIBS -o font_baker && \
+    g++ -std=c++17 -O2 -pthread tools/bench.cpp assets/asset_pack.cpp core/job_system.cpp core/entity_registry.cpp core/spatial_grid.cpp \
+      font_library.cpp glyph_rasterizer.cpp utf8.cpp core/log_buffer.cpp transform.cpp core/image_writer.cpp \
+      graphics/graphics_software.cpp graphics/quad_index_buffer.cpp graphics/gpu_resources.cpp $TOOL_INCLUDES $TOOL_LIBS -o bench && \
+    g++ -std=c++17 -O2 -pthread tools/label_renderer.cpp font_library.cpp glyph_rasterizer.cpp utf8.cpp \
+      core/job_system.cpp core/image_writer.cpp $TOOL_INCLUDES $TOOL_LIBS -o label_renderer && \
+    g++ -std=c++17 -O2 -pthread tools/replay.cpp graphics/graphics_replay.cpp graphics/graphics_capture.cpp \
+      graphics/graphics_software.cpp graphics/graphics_core.cpp graphics/graphics_factory.cpp platform/platform_desktop.cpp \
+      platform/platform_factory.cpp platform/platform.cpp platform/event_queue.cpp platform/input_latency.cpp core/job_system.cpp core/image_writer.cpp $TOOL_INCLUDES $TOOL_LIBS -lGLEW -framework OpenGL -o replay
+    
+    if [ $? -eq 0 ]; then
+        echo "Tools build completed successfully"
+    else
+        echo "Tools build failed"
+        exit 1
+    fi
+    
+    # Bake the UI font sizes, then pack the runtime assets
+    ./font_baker DejaVuSansMono-Bold.ttf DejaVuSansMono-Bold.ejfa --sizes 16,24,32 --charset latin1 && \
+    ./asset_packer assets.pak DejaVuSansMono-Bold.ttf DejaVuSansMono-Bold.ejfa shaders/*.glsl
+fi
+
 # Web build
 if [ "$BUILD_WEB" = true ]; then
     echo "Building web version..."
-    em++ -std=c++17 main.cpp shader.cpp text_renderer.cpp \
-      platform/platform_web.cpp platform/platform_factory.cpp \
-      graphics/graphics_es.cpp graphics/graphics_factory.cpp \
+    
+    # Ship the asset pack when one has been built
+    PRELOAD_PACK=""
+    if [ -f assets.pak ]; then
+        PRELOAD_PACK="--preload-file assets.pak"
+    fi
+    
+    em++ -std=c++17 main.cpp shader.cpp text_renderer.cpp text_layout.cpp text_markup.cpp glyph_atlas.cpp transform.cpp utf8.cpp terminal_grid.cpp log_view.cpp quad_renderer.cpp cached_layer.cpp dynamic_resolution.cpp \
+      font_library.cpp font_asset.cpp shader_asset.cpp glyph_rasterizer.cpp baked_font.cpp \
+      assets/asset_pack.cpp assets/asset_loader.cpp core/job_system.cpp core/entity_registry.cpp core/spatial_grid.cpp core/log_buffer.cpp core/image_writer.cpp \
+      platform/platform_web.cpp platform/platform_factory.cpp platform/platform.cpp platform/event_queue.cpp platform/input_latency.cpp \
+      graphics/graphics_es.cpp graphics/graphics_factory.cpp graphics/quad_index_buffer.cpp graphics/render_target.cpp graphics/frame_graph.cpp graphics/gpu_resources.cpp graphics/texture_residency.cpp graphics/graphics_software.cpp graphics/graphics_capture.cpp graphics/frame_recorder.cpp \
       -s WASM=1 -s USE_SDL=2 -s USE_WEBGL2=1\
       -s USE_SDL_TTF=2\
       -lSDL\
       -s EXPORTED_FUNCTIONS="[_main, _malloc, _free]"\
       --preload-file DejaVuSansMono-Bold.ttf\
       --preload-file shaders\
+      $PRELOAD_PACK\
       -o index.js\
       -O0
     
@@ -62,12 +109,14 @@ if [ "$BUILD_DESKTOP" = true ]; then
     
     # Compilation flags
     CXX="g++"
-    CXXFLAGS="-std=c++17 -O2"
+    CXXFLAGS="-std=c++17 -O2 -pthread"
     INCLUDES="-I/opt/homebrew/include"
     LIBS="-L/opt/homebrew/lib -lSDL2 -lSDL2_ttf -lGLEW -framework OpenGL"
     
     # Source files
-    SRC="main.cpp shader.cpp text_renderer.cpp platform/platform_desktop.cpp platform/platform_factory.cpp graphics/graphics_core.cpp graphics/graphics_factory.cpp"
+    SRC="main.cpp shader.cpp text_renderer.cpp text_layout.cpp text_markup.cpp glyph_atlas.cpp transform.cpp platform/platform_desktop.cpp platform/platform_factory.cpp platform/platform.cpp platform/event_queue.cpp platform/input_latency.cpp graphics/graphics_core.cpp graphics/graphics_factory.cpp graphics/quad_index_buffer.cpp graphics/render_target.cpp graphics/frame_graph.cpp graphics/gpu_resources.cpp graphics/texture_residency.cpp graphics/graphics_software.cpp graphics/graphics_capture.cpp graphics/frame_recorder.cpp"
+    SRC="$SRC font_library.cpp font_asset.cpp shader_asset.cpp glyph_rasterizer.cpp baked_font.cpp utf8.cpp terminal_grid.cpp log_view.cpp quad_renderer.cpp cached_layer.cpp dynamic_resolution.cpp"
+    SRC="$SRC assets/asset_pack.cpp assets/asset_loader.cpp core/job_system.cpp core/entity_registry.cpp core/spatial_grid.cpp core/log_buffer.cpp core/image_writer.cpp"
     
     $CXX $CXXFLAGS $SRC $INCLUDES $LIBS -o $OUT
     
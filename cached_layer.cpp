@@ -0,0 +1,84 @@
+#include "cached_layer.h"
+#include <iostream>
+
+CachedLayer::CachedLayer(GraphicsAPI* graphics, GpuResources* resources, TextRenderer* textRenderer, QuadRenderer* quadRenderer,
+                         TextureResidency* residency)
+    : graphics(graphics), textRenderer(textRenderer), quadRenderer(quadRenderer), residency(residency), target(graphics, resources),
+      windowWidth(0), windowHeight(0), valid(false), redraws(0) {
+}
+
+bool CachedLayer::initialize(int width, int height, int windowWidth, int windowHeight) {
+    this->windowWidth = windowWidth;
+    this->windowHeight = windowHeight;
+    valid = false;
+    if (!residency) {
+        return target.initialize(width, height);
+    }
+    
+    // The texture is created on the first draw and again after every eviction;
+    // either way it gets a new framebuffer and the contents are redrawn
+    residency->destroy(residentTexture);
+    target.cleanup();
+    residentTexture = residency->createFromCallback(width, height, [this, width, height](GLuint texture) {
+        // A failed framebuffer leaves the target without a texture, so draw() skips the layer
+        valid = false;
+        if (!target.initialize(width, height, texture)) {
+            printf("Cached layer %dx%d could not be recreated\n", width, height);
+        }
+    });
+    return !residentTexture.isNull();
+}
+
+void CachedLayer::draw(float x, float y, const std::function<void()>& drawContents) {
+    if (residency) {
+        residency->use(residentTexture);
+    }
+    if (!target.getTexture()) {
+        return;
+    }
+    if (!valid) {
+        redraw(drawContents);
+    }
+    
+    // Texture rows run bottom-up, so the top edge samples v = 1
+    quadRenderer->drawTexture(target.getTexture(), x, y, (float)target.getWidth(), (float)target.getHeight(),
+                              0.0f, 1.0f, 1.0f, 0.0f);
+}
+
+void CachedLayer::setViewportSize(int width, int height) {
+    windowWidth = width;
+    windowHeight = height;
+}
+
+void CachedLayer::cleanup() {
+    if (residency) {
+        residency->destroy(residentTexture);
+    }
+    target.cleanup();
+    valid = false;
+}
+
+void CachedLayer::redraw(const std::function<void()>& drawContents) {
+    // Whatever was queued for the window goes out before the target is bound
+    textRenderer->flush();
+    quadRenderer->flush();
+    
+    target.begin();
+    graphics->clearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    graphics->clear(GL_COLOR_BUFFER_BIT);
+    textRenderer->setViewportSize(target.getWidth(), target.getHeight());
+    quadRenderer->setViewportSize(target.getWidth(), target.getHeight());
+    
+    drawContents();
+    quadRenderer->flush();
+    textRenderer->flush();
+    
+    target.end(windowWidth, windowHeight);
+    textRenderer->setViewportSize(windowWidth, windowHeight);
+    quadRenderer->setViewportSize(windowWidth, windowHeight);
+    
+    // Renderers drop what they are given until their shaders load; keep
+    // redrawing until both could actually draw the contents
+    valid = textRenderer->isReady() && quadRenderer->isReady();
+    redraws++;
+}
\ No newline at end of file
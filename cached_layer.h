@@ -0,0 +1,52 @@
+#pragma once
+
+#include <functional>
+#include "quad_renderer.h"
+#include "text_renderer.h"
+#include "graphics/graphics_api.h"
+#include "graphics/render_target.h"
+#include "graphics/texture_residency.h"
+
+// A group of text and quads rendered once into a texture and composited with
+// a single quad every frame after that, until invalidated. Static panels and
+// backgrounds then cost one draw regardless of their content. With a residency
+// manager the texture counts against its budget and may be evicted while the
+// layer isn't drawn; the next draw re-creates it and redraws the contents.
+class CachedLayer {
+public:
+    CachedLayer(GraphicsAPI* graphics, GpuResources* resources, TextRenderer* textRenderer, QuadRenderer* quadRenderer,
+                TextureResidency* residency = nullptr);
+    
+    // Size of the layer in pixels, and of the window it is drawn into
+    bool initialize(int width, int height, int windowWidth, int windowHeight);
+    
+    // Contents are redrawn on the next draw()
+    void invalidate() { valid = false; }
+    bool isValid() const { return valid; }
+    
+    // Composite the layer with its top-left corner at (x, y). When invalid,
+    // drawContents is called first with both renderers drawing into the
+    // layer; its coordinates are relative to the layer's top-left corner and
+    // its quads end up beneath its text.
+    void draw(float x, float y, const std::function<void()>& drawContents);
+    
+    void setViewportSize(int width, int height);
+    
+    // Times the contents were rendered, for checking that static layers stay cached
+    int getRedrawCount() const { return redraws; }
+    
+    void cleanup();
+
+private:
+    GraphicsAPI* graphics;
+    TextRenderer* textRenderer;
+    QuadRenderer* quadRenderer;
+    TextureResidency* residency;
+    ResidentTexture residentTexture;
+    RenderTarget target;
+    int windowWidth, windowHeight;
+    bool valid;
+    int redraws;
+    
+    void redraw(const std::function<void()>& drawContents);
+};
\ No newline at end of file
@@ -0,0 +1,44 @@
+#include "entity_registry.h"
+#include <atomic>
+
+EntityRegistry::EntityRegistry() : aliveCount(0) {
+}
+
+Entity EntityRegistry::create() {
+    Entity entity;
+    if (!freeSlots.empty()) {
+        entity.index = freeSlots.back();
+        freeSlots.pop_back();
+    } else {
+        entity.index = (uint32_t)generations.size();
+        generations.push_back(0);
+    }
+    entity.generation = generations[entity.index];
+    aliveCount++;
+    return entity;
+}
+
+void EntityRegistry::destroy(Entity entity) {
+    if (!isAlive(entity)) {
+        return;
+    }
+    for (std::unique_ptr<ComponentArrayBase>& array : arrays) {
+        if (array) {
+            array->remove(entity.index);
+        }
+    }
+    
+    // Handles to this slot go stale; the next entity in it gets the new generation
+    generations[entity.index]++;
+    freeSlots.push_back(entity.index);
+    aliveCount--;
+}
+
+void EntityRegistry::reserve(size_t count) {
+    generations.reserve(count);
+}
+
+size_t EntityRegistry::nextTypeId() {
+    static std::atomic<size_t> counter(0);
+    return counter++;
+}
\ No newline at end of file
@@ -0,0 +1,243 @@
+#pragma once
+
+#include "job_system.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// Handle to an entity. Slots are reused, so the generation tells the current
+// entity in a slot from a destroyed one that held it before.
+struct Entity {
+    static constexpr uint32_t INVALID = 0xFFFFFFFF;
+    
+    uint32_t index = INVALID;
+    uint32_t generation = 0;
+    
+    bool isNull() const { return index == INVALID; }
+    bool operator==(const Entity& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const Entity& other) const { return !(*this == other); }
+};
+
+// What the registry needs from every component array without knowing its type
+class ComponentArrayBase {
+public:
+    virtual ~ComponentArrayBase() = default;
+    
+    // Drop the component of the entity in this slot, if it has one
+    virtual void remove(uint32_t index) = 0;
+};
+
+// Components of one type as a sparse set: the components and their entities in
+// two packed arrays with no holes, and a table from entity slot to array position.
+// Each component type has its own array, so a system reads only the fields it
+// uses, front to back. Removing swaps the last component into the hole.
+template<typename T>
+class ComponentArray : public ComponentArrayBase {
+public:
+    bool contains(uint32_t index) const { return index < sparse.size() && sparse[index] != NONE; }
+    
+    // Add the entity's component, or replace the one it has
+    T& insert(Entity entity, const T& component) {
+        if (contains(entity.index)) {
+            T& existing = components[sparse[entity.index]];
+            existing = component;
+            return existing;
+        }
+        if (entity.index >= sparse.size()) {
+            sparse.resize(entity.index + 1, NONE);
+        }
+        sparse[entity.index] = (uint32_t)components.size();
+        entities.push_back(entity);
+        components.push_back(component);
+        return components.back();
+    }
+    
+    void remove(uint32_t index) override {
+        if (!contains(index)) {
+            return;
+        }
+        uint32_t slot = sparse[index];
+        uint32_t last = (uint32_t)components.size() - 1;
+        if (slot != last) {
+            swapSlots(slot, last);
+        }
+        sparse[index] = NONE;
+        entities.pop_back();
+        components.pop_back();
+    }
+    
+    T* find(uint32_t index) { return contains(index) ? &components[sparse[index]] : nullptr; }
+    const T* find(uint32_t index) const { return contains(index) ? &components[sparse[index]] : nullptr; }
+    
+    // Packed arrays; position i of each belongs to the same entity
+    size_t size() const { return components.size(); }
+    T* data() { return components.data(); }
+    const T* data() const { return components.data(); }
+    const Entity* getEntities() const { return entities.data(); }
+    
+    void reserve(size_t count) {
+        entities.reserve(count);
+        components.reserve(count);
+    }
+    
+    // Reorder so the entities that also have a U come first, in the order of the U
+    // array. A join driven by the U array then reads this one front to back too.
+    template<typename U>
+    void arrangeLike(const ComponentArray<U>& other) {
+        uint32_t position = 0;
+        const Entity* order = other.getEntities();
+        for (size_t i = 0; i < other.size(); i++) {
+            uint32_t index = order[i].index;
+            if (!contains(index)) {
+                continue;
+            }
+            if (sparse[index] != position) {
+                swapSlots(sparse[index], position);
+            }
+            position++;
+        }
+    }
+
+private:
+    static constexpr uint32_t NONE = 0xFFFFFFFF;
+    
+    std::vector<uint32_t> sparse; // Entity slot to position, NONE when absent
+    std::vector<Entity> entities;
+    std::vector<T> components;
+    
+    void swapSlots(uint32_t a, uint32_t b) {
+        std::swap(entities[a], entities[b]);
+        std::swap(components[a], components[b]);
+        sparse[entities[a].index] = a;
+        sparse[entities[b].index] = b;
+    }
+};
+
+// Entities and their components. Entities are indices with generations; each
+// component type lives in its own ComponentArray, created on first use. Systems
+// walk one array, optionally looking up a second component per entity, and can
+// split the walk across the job system. Entities and components must not be
+// added or removed while a walk is running.
+class EntityRegistry {
+public:
+    EntityRegistry();
+    
+    EntityRegistry(const EntityRegistry&) = delete;
+    EntityRegistry& operator=(const EntityRegistry&) = delete;
+    
+    Entity create();
+    
+    // Remove the entity and all its components; stale handles are ignored
+    void destroy(Entity entity);
+    
+    bool isAlive(Entity entity) const {
+        return entity.index < generations.size() && generations[entity.index] == entity.generation;
+    }
+    
+    size_t getAliveCount() const { return aliveCount; }
+    
+    // Preallocate entity slots
+    void reserve(size_t count);
+    
+    // Add or replace a component; the entity must be alive
+    template<typename T>
+    T& add(Entity entity, const T& component = T()) {
+        return getArray<T>().insert(entity, component);
+    }
+    
+    template<typename T>
+    void remove(Entity entity) {
+        if (isAlive(entity)) {
+            getArray<T>().remove(entity.index);
+        }
+    }
+    
+    // The entity's component, or nullptr when it has none or the handle is stale
+    template<typename T>
+    T* get(Entity entity) {
+        return isAlive(entity) ? getArray<T>().find(entity.index) : nullptr;
+    }
+    
+    template<typename T>
+    ComponentArray<T>& getArray() {
+        size_t id = getTypeId<T>();
+        if (id >= arrays.size()) {
+            arrays.resize(id + 1);
+        }
+        if (!arrays[id]) {
+            arrays[id] = std::make_unique<ComponentArray<T>>();
+        }
+        return static_cast<ComponentArray<T>&>(*arrays[id]);
+    }
+    
+    // function(Entity, T&) for every entity with a T
+    template<typename T, typename Function>
+    void each(Function function) {
+        ComponentArray<T>& array = getArray<T>();
+        eachRange<T>(array, 0, array.size(), function);
+    }
+    
+    // function(Entity, T&, U&) for every entity with both, in T's order
+    template<typename T, typename U, typename Function>
+    void eachPair(Function function) {
+        ComponentArray<T>& array = getArray<T>();
+        eachPairRange<T, U>(array, getArray<U>(), 0, array.size(), function);
+    }
+    
+    // each/eachPair split into chunks of grain components across the job system;
+    // function runs concurrently, so it may only touch its own entity's components
+    template<typename T, typename Function>
+    void parallelEach(JobSystem& jobs, size_t grain, Function function) {
+        ComponentArray<T>& array = getArray<T>();
+        jobs.parallelFor(array.size(), grain, [&](size_t begin, size_t end) {
+            eachRange<T>(array, begin, end, function);
+        });
+    }
+    
+    template<typename T, typename U, typename Function>
+    void parallelEachPair(JobSystem& jobs, size_t grain, Function function) {
+        ComponentArray<T>& array = getArray<T>();
+        ComponentArray<U>& other = getArray<U>();
+        jobs.parallelFor(array.size(), grain, [&](size_t begin, size_t end) {
+            eachPairRange<T, U>(array, other, begin, end, function);
+        });
+    }
+
+private:
+    std::vector<uint32_t> generations; // Per slot, bumped when its entity is destroyed
+    std::vector<uint32_t> freeSlots;
+    size_t aliveCount;
+    std::vector<std::unique_ptr<ComponentArrayBase>> arrays; // By component type id
+    
+    // Sequential ids for component types, assigned on first use
+    static size_t nextTypeId();
+    
+    template<typename T>
+    static size_t getTypeId() {
+        static const size_t id = nextTypeId();
+        return id;
+    }
+    
+    template<typename T, typename Function>
+    static void eachRange(ComponentArray<T>& array, size_t begin, size_t end, Function& function) {
+        const Entity* entities = array.getEntities();
+        T* components = array.data();
+        for (size_t i = begin; i < end; i++) {
+            function(entities[i], components[i]);
+        }
+    }
+    
+    template<typename T, typename U, typename Function>
+    static void eachPairRange(ComponentArray<T>& array, ComponentArray<U>& other, size_t begin, size_t end, Function& function) {
+        const Entity* entities = array.getEntities();
+        T* components = array.data();
+        for (size_t i = begin; i < end; i++) {
+            U* second = other.find(entities[i].index);
+            if (second) {
+                function(entities[i], components[i], *second);
+            }
+        }
+    }
+};
\ No newline at end of file
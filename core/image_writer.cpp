@@ -0,0 +1,149 @@
+#include "image_writer.h"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+// Built on first use; function statics are initialized once even with concurrent encoders
+static const std::array<uint32_t, 256>& crcTable() {
+    static const std::array<uint32_t, 256> table = []() {
+        std::array<uint32_t, 256> entries;
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t c = i;
+            for (int bit = 0; bit < 8; bit++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            entries[i] = c;
+        }
+        return entries;
+    }();
+    return table;
+}
+
+static uint32_t crc32(const uint8_t* data, size_t size) {
+    const std::array<uint32_t, 256>& table = crcTable();
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+static void putBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+    out.push_back((uint8_t)(value >> 24));
+    out.push_back((uint8_t)(value >> 16));
+    out.push_back((uint8_t)(value >> 8));
+    out.push_back((uint8_t)value);
+}
+
+static void putChunk(std::vector<uint8_t>& out, const char* type, const uint8_t* data, size_t size) {
+    putBigEndian(out, (uint32_t)size);
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data, data + size);
+    putBigEndian(out, crc32(&out[start], size + 4));
+}
+
+void encodePng(int width, int height, const uint8_t* rgba, bool bottomUp, std::vector<uint8_t>& out) {
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    out.assign(signature, signature + 8);
+    
+    std::vector<uint8_t> header;
+    putBigEndian(header, (uint32_t)width);
+    putBigEndian(header, (uint32_t)height);
+    header.push_back(8); // Bits per channel
+    header.push_back(6); // RGBA
+    header.push_back(0);
+    header.push_back(0);
+    header.push_back(0);
+    putChunk(out, "IHDR", header.data(), header.size());
+    
+    // Scanlines with filter type 0, wrapped in stored deflate blocks of up to 64 KB
+    size_t rowBytes = (size_t)width * 4;
+    std::vector<uint8_t> raw;
+    raw.reserve((rowBytes + 1) * height);
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = rgba + rowBytes * (bottomUp ? height - 1 - y : y);
+        raw.push_back(0);
+        raw.insert(raw.end(), row, row + rowBytes);
+    }
+    
+    std::vector<uint8_t> zlib;
+    zlib.reserve(raw.size() + raw.size() / 65535 * 5 + 16);
+    zlib.push_back(0x78);
+    zlib.push_back(0x01);
+    size_t offset = 0;
+    do {
+        size_t blockSize = std::min<size_t>(raw.size() - offset, 65535);
+        bool last = offset + blockSize == raw.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back((uint8_t)blockSize);
+        zlib.push_back((uint8_t)(blockSize >> 8));
+        zlib.push_back((uint8_t)~blockSize);
+        zlib.push_back((uint8_t)(~blockSize >> 8));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + blockSize);
+        offset += blockSize;
+    } while (offset < raw.size());
+    
+    // Adler-32 of the uncompressed data, reduced every 5552 bytes as in zlib
+    uint32_t a = 1, b = 0;
+    for (size_t i = 0; i < raw.size();) {
+        size_t end = std::min(raw.size(), i + 5552);
+        for (; i < end; i++) {
+            a += raw[i];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    putBigEndian(zlib, (b << 16) | a);
+    
+    putChunk(out, "IDAT", zlib.data(), zlib.size());
+    putChunk(out, "IEND", nullptr, 0);
+}
+
+void encodeTga(int width, int height, const uint8_t* rgba, bool bottomUp, std::vector<uint8_t>& out) {
+    uint8_t header[18] = {};
+    header[2] = 2; // Uncompressed true color
+    header[12] = (uint8_t)width;
+    header[13] = (uint8_t)(width >> 8);
+    header[14] = (uint8_t)height;
+    header[15] = (uint8_t)(height >> 8);
+    header[16] = 32;
+    header[17] = bottomUp ? 8 : 8 | 0x20; // 8 alpha bits; bit 5 marks top-down rows
+    out.assign(header, header + 18);
+    
+    // TGA stores BGRA
+    size_t pixelCount = (size_t)width * height;
+    out.resize(18 + pixelCount * 4);
+    uint8_t* pixels = &out[18];
+    for (size_t i = 0; i < pixelCount; i++) {
+        pixels[i * 4 + 0] = rgba[i * 4 + 2];
+        pixels[i * 4 + 1] = rgba[i * 4 + 1];
+        pixels[i * 4 + 2] = rgba[i * 4 + 0];
+        pixels[i * 4 + 3] = rgba[i * 4 + 3];
+    }
+}
+
+bool writeImage(const std::string& path, int width, int height, const uint8_t* rgba, bool bottomUp) {
+    std::vector<uint8_t> encoded;
+    bool tga = path.size() >= 4 && (path.compare(path.size() - 4, 4, ".tga") == 0 || path.compare(path.size() - 4, 4, ".TGA") == 0);
+    if (tga) {
+        encodeTga(width, height, rgba, bottomUp, encoded);
+    } else {
+        encodePng(width, height, rgba, bottomUp, encoded);
+    }
+    
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        printf("Failed to open image for writing: %s\n", path.c_str());
+        return false;
+    }
+    file.write((const char*)encoded.data(), encoded.size());
+    if (!file) {
+        printf("Failed to write image: %s\n", path.c_str());
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
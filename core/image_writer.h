@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Encode 8-bit RGBA pixels as a PNG in memory. The deflate stream uses stored
+// blocks, so encoding is a copy plus checksums; files are about as large as
+// the raw pixels. With bottomUp set, row 0 is the bottom of the image (GL order).
+void encodePng(int width, int height, const uint8_t* rgba, bool bottomUp, std::vector<uint8_t>& out);
+
+// Same for an uncompressed 32-bit TGA
+void encodeTga(int width, int height, const uint8_t* rgba, bool bottomUp, std::vector<uint8_t>& out);
+
+// Write a .png or .tga, chosen by the path's extension (PNG otherwise)
+bool writeImage(const std::string& path, int width, int height, const uint8_t* rgba, bool bottomUp = false);
\ No newline at end of file
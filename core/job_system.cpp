@@ -0,0 +1,202 @@
+#include "job_system.h"
+#include <algorithm>
+#include <iostream>
+
+// Which queue the current thread owns (0 for threads outside the pool)
+static thread_local const JobSystem* currentSystem = nullptr;
+static thread_local int currentQueue = 0;
+
+JobSystem::JobSystem(int workerCount) : running(true), queuedJobs(0) {
+#ifdef ENDJINN_JOBS_INLINE
+    workerCount = 0;
+#else
+    if (workerCount < 0) {
+        workerCount = std::max(0, (int)std::thread::hardware_concurrency() - 1);
+    }
+#endif
+
+    for (int i = 0; i <= workerCount; i++) {
+        queues.push_back(std::make_unique<WorkQueue>());
+    }
+    for (int i = 1; i <= workerCount; i++) {
+        workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running = false;
+    }
+    wake.notify_all();
+    
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void JobSystem::run(std::function<void()> job, JobCounter* counter) {
+    if (counter) {
+        counter->count.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    Job queued = {std::move(job), counter};
+    if (workers.empty()) {
+        execute(queued);
+        return;
+    }
+    push(std::move(queued));
+}
+
+void JobSystem::runAfter(JobCounter& dependency, std::function<void()> job, JobCounter* counter) {
+    if (counter) {
+        counter->count.fetch_add(1, std::memory_order_relaxed);
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(dependency.mutex);
+        if (!dependency.isDone()) {
+            dependency.continuations.emplace_back(std::move(job), counter);
+            return;
+        }
+    }
+    
+    // Dependency already satisfied; counter was incremented above
+    Job queued = {std::move(job), counter};
+    if (workers.empty()) {
+        execute(queued);
+        return;
+    }
+    push(std::move(queued));
+}
+
+void JobSystem::wait(JobCounter& counter) {
+    int queueIndex = currentSystem == this ? currentQueue : 0;
+    while (!counter.isDone()) {
+        if (!tryRunOne(queueIndex)) {
+            std::this_thread::yield();
+        }
+    }
+    
+    // The last job drops the count to zero while holding the mutex; taking it
+    // here waits for that job to let go, so the caller may destroy the counter
+    std::lock_guard<std::mutex> lock(counter.mutex);
+}
+
+void JobSystem::parallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& body) {
+    if (count == 0) {
+        return;
+    }
+    grainSize = std::max<size_t>(1, grainSize);
+    
+    if (workers.empty() || count <= grainSize) {
+        body(0, count);
+        return;
+    }
+    
+    JobCounter counter;
+    for (size_t begin = 0; begin < count; begin += grainSize) {
+        size_t end = std::min(count, begin + grainSize);
+        run([&body, begin, end]() { body(begin, end); }, &counter);
+    }
+    wait(counter);
+}
+
+void JobSystem::push(Job job) {
+    int queueIndex = currentSystem == this ? currentQueue : 0;
+    {
+        std::lock_guard<std::mutex> lock(queues[queueIndex]->mutex);
+        queues[queueIndex]->jobs.push_back(std::move(job));
+    }
+    queuedJobs.fetch_add(1, std::memory_order_release);
+    
+    // Taking the sleep mutex orders this with a worker about to sleep
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+    }
+    wake.notify_one();
+}
+
+bool JobSystem::tryRunOne(int queueIndex) {
+    Job job;
+    bool found = false;
+    
+    // Own queue first, newest job
+    {
+        WorkQueue& own = *queues[queueIndex];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            job = std::move(own.jobs.back());
+            own.jobs.pop_back();
+            found = true;
+        }
+    }
+    
+    // Then steal the oldest job from the other queues
+    for (size_t offset = 1; !found && offset < queues.size(); offset++) {
+        WorkQueue& victim = *queues[(queueIndex + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+            found = true;
+        }
+    }
+    
+    if (!found) {
+        return false;
+    }
+    
+    queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    execute(job);
+    return true;
+}
+
+void JobSystem::execute(Job& job) {
+    job.function();
+    finish(job.counter);
+}
+
+void JobSystem::finish(JobCounter* counter) {
+    if (!counter) {
+        return;
+    }
+    
+    // Decrement and take the continuations under the mutex: once the count is
+    // zero a waiter may return and destroy the counter, so it isn't touched after
+    std::vector<std::pair<std::function<void()>, JobCounter*>> ready;
+    {
+        std::lock_guard<std::mutex> lock(counter->mutex);
+        if (counter->count.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+        ready.swap(counter->continuations);
+    }
+    for (auto& continuation : ready) {
+        Job job = {std::move(continuation.first), continuation.second};
+        if (workers.empty()) {
+            execute(job);
+        } else {
+            push(std::move(job));
+        }
+    }
+}
+
+void JobSystem::workerLoop(int queueIndex) {
+    currentSystem = this;
+    currentQueue = queueIndex;
+    
+    while (true) {
+        if (tryRunOne(queueIndex)) {
+            continue;
+        }
+        
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wake.wait(lock, [this]() {
+            return !running || queuedJobs.load(std::memory_order_acquire) > 0;
+        });
+        if (!running) {
+            return;
+        }
+    }
+}
\ No newline at end of file
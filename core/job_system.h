@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Threads are only available on the web when built with -pthread
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define ENDJINN_JOBS_INLINE 1
+#endif
+
+class JobSystem;
+
+// Tracks outstanding jobs; a job may be scheduled to start once a counter reaches zero
+class JobCounter {
+public:
+    JobCounter() : count(0) {}
+    
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator=(const JobCounter&) = delete;
+    
+    // Polling only; a counter may be destroyed after JobSystem::wait returns, not after isDone
+    bool isDone() const { return count.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    
+    std::atomic<int> count;
+    std::mutex mutex;
+    std::vector<std::pair<std::function<void()>, JobCounter*>> continuations;
+};
+
+// Fixed pool of worker threads with one work-stealing deque each. Owners pop
+// their newest job (cache-warm), idle workers steal the oldest from others.
+// With no workers (single-threaded web builds) every job runs inline.
+class JobSystem {
+public:
+    // workerCount < 0 picks hardware threads minus one (the caller also runs jobs while waiting)
+    explicit JobSystem(int workerCount = -1);
+    ~JobSystem();
+    
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+    
+    // Queue a job; counter is incremented now and decremented when the job finishes
+    void run(std::function<void()> job, JobCounter* counter = nullptr);
+    
+    // Queue a job that starts once dependency reaches zero
+    void runAfter(JobCounter& dependency, std::function<void()> job, JobCounter* counter = nullptr);
+    
+    // Run queued jobs on the calling thread until counter reaches zero
+    void wait(JobCounter& counter);
+    
+    // Run body(begin, end) over [0, count) in chunks of grainSize and wait for all of them
+    void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& body);
+    
+    int getWorkerCount() const { return (int)workers.size(); }
+    
+    // Threads that execute jobs during a wait: workers plus the waiting thread
+    int getThreadCount() const { return (int)workers.size() + 1; }
+
+private:
+    struct Job {
+        std::function<void()> function;
+        JobCounter* counter;
+    };
+    
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+    
+    std::vector<std::thread> workers;
+    std::vector<std::unique_ptr<WorkQueue>> queues; // Index 0 is shared by non-worker threads
+    std::atomic<bool> running;
+    std::atomic<int> queuedJobs;
+    std::mutex sleepMutex;
+    std::condition_variable wake;
+    
+    void push(Job job);
+    bool tryRunOne(int queueIndex);
+    void execute(Job& job);
+    void finish(JobCounter* counter);
+    void workerLoop(int queueIndex);
+};
\ No newline at end of file
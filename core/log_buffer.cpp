@@ -0,0 +1,56 @@
+#include "log_buffer.h"
+#include <algorithm>
+#include <cstring>
+
+LogBuffer::LogBuffer(size_t maxLines, size_t arenaBytes)
+    : records(std::max<size_t>(1, maxLines)), arena(std::max<size_t>(4, arenaBytes)), firstRecord(0), lineCount(0),
+      arenaHead(0), totalLines(0) {
+}
+
+void LogBuffer::append(std::string_view line) {
+    size_t length = std::min(line.size(), arena.size() / 4);
+    if (lineCount == records.size()) {
+        dropOldest();
+    }
+    
+    // Lines are never split; when the end of the arena is too short, every
+    // line stored there is older than the ones at the start, so drop them and wrap
+    if (arenaHead + length > arena.size()) {
+        while (lineCount > 0 && records[firstRecord].offset >= arenaHead) {
+            dropOldest();
+        }
+        arenaHead = 0;
+    }
+    
+    // Drop the oldest lines the new bytes would overwrite
+    while (lineCount > 0 && records[firstRecord].offset >= arenaHead && records[firstRecord].offset < arenaHead + length) {
+        dropOldest();
+    }
+    
+    memcpy(arena.data() + arenaHead, line.data(), length);
+    LineRecord& record = records[(firstRecord + lineCount) % records.size()];
+    record.offset = (uint32_t)arenaHead;
+    record.length = (uint32_t)length;
+    arenaHead += length;
+    lineCount++;
+    totalLines++;
+}
+
+std::string_view LogBuffer::getLine(size_t index) const {
+    if (index >= lineCount) {
+        return std::string_view();
+    }
+    const LineRecord& record = records[(firstRecord + index) % records.size()];
+    return std::string_view(arena.data() + record.offset, record.length);
+}
+
+void LogBuffer::clear() {
+    firstRecord = 0;
+    lineCount = 0;
+    arenaHead = 0;
+}
+
+void LogBuffer::dropOldest() {
+    firstRecord = (firstRecord + 1) % records.size();
+    lineCount--;
+}
\ No newline at end of file
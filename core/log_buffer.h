@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Fixed-capacity history of text lines. Line records live in a ring and their
+// bytes in one circular arena, both allocated up front, so appending never
+// allocates: the oldest lines are dropped when either runs out of room.
+class LogBuffer {
+public:
+    // Lines longer than a quarter of the arena are truncated
+    LogBuffer(size_t maxLines, size_t arenaBytes);
+    
+    // Append one line (the caller splits on newlines)
+    void append(std::string_view line);
+    
+    // Retained lines; index 0 is the oldest
+    size_t getLineCount() const { return lineCount; }
+    std::string_view getLine(size_t index) const;
+    
+    // Lines appended since construction; line i has absolute number getFirstLineNumber() + i
+    uint64_t getTotalLines() const { return totalLines; }
+    uint64_t getFirstLineNumber() const { return totalLines - lineCount; }
+    
+    size_t getCapacity() const { return records.size(); }
+    
+    void clear();
+
+private:
+    struct LineRecord {
+        uint32_t offset;
+        uint32_t length;
+    };
+    
+    std::vector<LineRecord> records; // Ring of maxLines entries
+    std::vector<char> arena;
+    size_t firstRecord;
+    size_t lineCount;
+    size_t arenaHead; // Where the next line's bytes go
+    uint64_t totalLines;
+    
+    void dropOldest();
+};
\ No newline at end of file
@@ -0,0 +1,108 @@
+#include "spatial_grid.h"
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize) : cellSize(cellSize), inverseCellSize(1.0f / cellSize), count(0) {
+}
+
+void SpatialGrid::update(uint32_t id, const Rect2D& bounds) {
+    CellRange range = getRange(bounds);
+    if (id >= items.size()) {
+        items.resize(id + 1, Item{Rect2D(), CellRange{0, 0, 0, 0}, false});
+    }
+    Item& item = items[id];
+    if (item.present) {
+        if (!(item.range == range)) {
+            removeFromCells(id, item.range);
+            addToCells(id, range);
+        }
+    } else {
+        addToCells(id, range);
+        item.present = true;
+        count++;
+    }
+    item.bounds = bounds;
+    item.range = range;
+}
+
+void SpatialGrid::remove(uint32_t id) {
+    if (!contains(id)) {
+        return;
+    }
+    removeFromCells(id, items[id].range);
+    items[id].present = false;
+    count--;
+}
+
+void SpatialGrid::query(const Rect2D& area, std::vector<uint32_t>& results) const {
+    CellRange range = getRange(area);
+    auto visit = [&](int32_t x, int32_t y, const std::vector<uint32_t>& ids) {
+        for (uint32_t id : ids) {
+            const Item& item = items[id];
+            if (isReportingCell(item.range, range, x, y) && item.bounds.overlaps(area)) {
+                results.push_back(id);
+            }
+        }
+    };
+    
+    // An area wider than everything stored walks the cells that exist instead
+    uint64_t areaCells = (uint64_t)(range.x1 - range.x0 + 1) * (uint64_t)(range.y1 - range.y0 + 1);
+    if (areaCells > cells.size()) {
+        for (const auto& cell : cells) {
+            int32_t x = (int32_t)(uint32_t)(cell.first >> 32);
+            int32_t y = (int32_t)(uint32_t)cell.first;
+            if (x >= range.x0 && x <= range.x1 && y >= range.y0 && y <= range.y1) {
+                visit(x, y, cell.second);
+            }
+        }
+        return;
+    }
+    for (int32_t y = range.y0; y <= range.y1; y++) {
+        for (int32_t x = range.x0; x <= range.x1; x++) {
+            auto cell = cells.find(getKey(x, y));
+            if (cell != cells.end()) {
+                visit(x, y, cell->second);
+            }
+        }
+    }
+}
+
+void SpatialGrid::clear() {
+    items.clear();
+    cells.clear();
+    count = 0;
+}
+
+SpatialGrid::CellRange SpatialGrid::getRange(const Rect2D& bounds) const {
+    // Clamped so far-off or degenerate bounds still give a sane range
+    auto toCell = [this](float coordinate) {
+        float cell = std::floor(coordinate * inverseCellSize);
+        return (int32_t)std::max(-1e9f, std::min(1e9f, cell));
+    };
+    return CellRange{toCell(bounds.x), toCell(bounds.y), toCell(bounds.x + bounds.width), toCell(bounds.y + bounds.height)};
+}
+
+void SpatialGrid::addToCells(uint32_t id, const CellRange& range) {
+    for (int32_t y = range.y0; y <= range.y1; y++) {
+        for (int32_t x = range.x0; x <= range.x1; x++) {
+            cells[getKey(x, y)].push_back(id);
+        }
+    }
+}
+
+void SpatialGrid::removeFromCells(uint32_t id, const CellRange& range) {
+    for (int32_t y = range.y0; y <= range.y1; y++) {
+        for (int32_t x = range.x0; x <= range.x1; x++) {
+            std::vector<uint32_t>& ids = cells[getKey(x, y)];
+            auto found = std::find(ids.begin(), ids.end(), id);
+            if (found != ids.end()) {
+                *found = ids.back();
+                ids.pop_back();
+            }
+        }
+    }
+}
+
+bool SpatialGrid::isReportingCell(const CellRange& item, const CellRange& query, int32_t x, int32_t y) {
+    return x == std::max(item.x0, query.x0) && y == std::max(item.y0, query.y0);
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+// Axis-aligned rectangle in pixels, y down
+struct Rect2D {
+    float x = 0.0f, y = 0.0f;
+    float width = 0.0f, height = 0.0f;
+    
+    bool overlaps(const Rect2D& other) const {
+        return x < other.x + other.width && other.x < x + width && y < other.y + other.height && other.y < y + height;
+    }
+};
+
+// Uniform grid over an unbounded plane for culling 2D drawables. Items are ids
+// (entity indices, or any small dense integers) with bounds; each is listed in
+// every cell its bounds touch, and cells exist only where something has been.
+// Moving an item within the cells it already covers only stores the new bounds,
+// so per-frame updates of mostly slow movers are cheap. A query visits the cells
+// under the area and returns each overlapping item once. Items much larger than
+// a cell are listed many times over; pick the cell size to fit the typical item.
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize = 128.0f);
+    
+    // Add an item, or move it if it is already in the grid
+    void update(uint32_t id, const Rect2D& bounds);
+    
+    // Items not in the grid are ignored
+    void remove(uint32_t id);
+    
+    bool contains(uint32_t id) const { return id < items.size() && items[id].present; }
+    
+    // Append the ids of items overlapping the area (a viewport, or a scrolled
+    // panel's clip rect in the same space) in no particular order
+    void query(const Rect2D& area, std::vector<uint32_t>& results) const;
+    
+    size_t size() const { return count; }
+    size_t getCellCount() const { return cells.size(); }
+    float getCellSize() const { return cellSize; }
+    
+    void clear();
+
+private:
+    // Inclusive range of cells covered by some bounds
+    struct CellRange {
+        int32_t x0, y0, x1, y1;
+        
+        bool operator==(const CellRange& other) const {
+            return x0 == other.x0 && y0 == other.y0 && x1 == other.x1 && y1 == other.y1;
+        }
+    };
+    
+    struct Item {
+        Rect2D bounds;
+        CellRange range;
+        bool present;
+    };
+    
+    float cellSize;
+    float inverseCellSize;
+    std::vector<Item> items; // By id
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells; // Kept once empty; items tend to come back
+    size_t count;
+    
+    CellRange getRange(const Rect2D& bounds) const;
+    static uint64_t getKey(int32_t x, int32_t y) { return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y; }
+    void addToCells(uint32_t id, const CellRange& range);
+    void removeFromCells(uint32_t id, const CellRange& range);
+    
+    // Report an item from one cell only: the first of its cells inside the query
+    static bool isReportingCell(const CellRange& item, const CellRange& query, int32_t x, int32_t y);
+};
\ No newline at end of file
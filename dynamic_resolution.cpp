@@ -0,0 +1,114 @@
+#include "dynamic_resolution.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+DynamicResolution::DynamicResolution(GraphicsAPI* graphics, GpuResources* resources, QuadRenderer* quadRenderer)
+    : graphics(graphics), quadRenderer(quadRenderer), target(graphics, resources), windowWidth(0), windowHeight(0), enabled(true),
+      scale(1.0f), accumulatedMs(0.0f), sampledFrames(0), averageFrameMs(0.0f), frameFence(nullptr), gpuBehind(false) {
+}
+
+bool DynamicResolution::initialize(int width, int height, const DynamicResolutionSettings& newSettings) {
+    settings = newSettings;
+    scale = settings.maxScale;
+    windowWidth = width;
+    windowHeight = height;
+    
+    // Scale changes never reallocate: the target covers the largest scale
+    int targetWidth = std::max(1, (int)std::ceil(width * settings.maxScale));
+    int targetHeight = std::max(1, (int)std::ceil(height * settings.maxScale));
+    return target.initialize(targetWidth, targetHeight);
+}
+
+void DynamicResolution::beginScene() {
+    target.begin(getRenderWidth(), getRenderHeight());
+}
+
+void DynamicResolution::endScene() {
+    quadRenderer->flush();
+    target.end(windowWidth, windowHeight);
+    present();
+}
+
+void DynamicResolution::present() {
+    // Stretch the used corner over the window; rows run bottom-up
+    float u1 = (float)getRenderWidth() / target.getWidth();
+    float v1 = (float)getRenderHeight() / target.getHeight();
+    quadRenderer->drawTexture(target.getTexture(), 0.0f, 0.0f, (float)windowWidth, (float)windowHeight, 0.0f, v1, u1, 0.0f);
+    quadRenderer->flush();
+}
+
+void DynamicResolution::submitFrame() {
+    // With the previous frame done the GPU keeps up, and a blocking swap is only waiting for vsync
+    gpuBehind = false;
+    if (frameFence) {
+        gpuBehind = !graphics->isFenceSignaled(frameFence);
+        graphics->deleteFence(frameFence);
+    }
+    frameFence = graphics->createFence();
+}
+
+void DynamicResolution::reportFrameTime(float cpuMs, float swapMs) {
+    accumulatedMs += gpuBehind ? cpuMs + swapMs : cpuMs;
+    sampledFrames++;
+    if (sampledFrames < settings.sampleFrames) {
+        return;
+    }
+    averageFrameMs = accumulatedMs / sampledFrames;
+    accumulatedMs = 0.0f;
+    sampledFrames = 0;
+    
+    // Inside the band between the thresholds the scale is left alone, so it doesn't oscillate
+    float budget = settings.targetFrameMs;
+    bool over = averageFrameMs > budget * settings.downscaleThreshold;
+    bool under = averageFrameMs < budget * settings.upscaleThreshold;
+    if (!enabled || averageFrameMs <= 0.0f || (!over && !under)) {
+        return;
+    }
+    
+    float ideal = scale * std::sqrt(budget / averageFrameMs);
+    float change = std::min(std::max(ideal - scale, -settings.maxStep), settings.maxStep);
+    float previous = scale;
+    setScale(scale + change);
+    if (scale != previous) {
+        printf("Resolution scale %.2f -> %.2f (%.1f ms average, %.1f ms target)\n", previous, scale, averageFrameMs, budget);
+    }
+}
+
+void DynamicResolution::setViewportSize(int width, int height) {
+    float current = scale;
+    initialize(width, height, settings);
+    setScale(current);
+}
+
+void DynamicResolution::setScale(float newScale) {
+    scale = std::min(std::max(newScale, settings.minScale), settings.maxScale);
+}
+
+int DynamicResolution::getRenderWidth() const {
+    return std::min(target.getWidth(), std::max(1, (int)(windowWidth * scale + 0.5f)));
+}
+
+int DynamicResolution::getRenderHeight() const {
+    return std::min(target.getHeight(), std::max(1, (int)(windowHeight * scale + 0.5f)));
+}
+
+void DynamicResolution::setSettings(const DynamicResolutionSettings& newSettings) {
+    // A higher maximum needs a larger target
+    bool resize = newSettings.maxScale != settings.maxScale;
+    settings = newSettings;
+    if (resize) {
+        setViewportSize(windowWidth, windowHeight);
+    } else {
+        setScale(scale);
+    }
+}
+
+void DynamicResolution::cleanup() {
+    if (frameFence) {
+        graphics->deleteFence(frameFence);
+        frameFence = nullptr;
+    }
+    gpuBehind = false;
+    target.cleanup();
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "quad_renderer.h"
+#include "graphics/graphics_api.h"
+#include "graphics/render_target.h"
+
+struct DynamicResolutionSettings {
+    float targetFrameMs = 1000.0f / 60.0f;
+    float minScale = 0.5f;
+    float maxScale = 1.0f;
+    float maxStep = 0.1f;            // Largest scale change per adjustment
+    float downscaleThreshold = 1.1f; // Shrink when the average exceeds target x this
+    float upscaleThreshold = 0.8f;   // Grow when the average is under target x this
+    int sampleFrames = 20;           // Frames averaged per adjustment
+};
+
+// Renders the scene into an offscreen target whose resolution follows the
+// measured frame time, then stretches it over the window. Fill cost scales
+// with pixel count, so each adjustment moves the scale by the square root of
+// the budget ratio. Text and UI drawn after endScene() stay at native resolution.
+class DynamicResolution {
+public:
+    DynamicResolution(GraphicsAPI* graphics, GpuResources* resources, QuadRenderer* quadRenderer);
+    
+    bool initialize(int windowWidth, int windowHeight, const DynamicResolutionSettings& settings = DynamicResolutionSettings());
+    
+    // Draws until endScene() go to the scaled target; renderers keep using
+    // window coordinates since only the viewport shrinks
+    void beginScene();
+    
+    // Upscale the scene onto the window. Flush renderers other than the quad renderer first.
+    void endScene();
+    
+    // Just the upscale, for callers that bind the target themselves (frame graph passes)
+    void present();
+    
+    // The scene target; only its bottom-left getRenderWidth() x getRenderHeight() is drawn
+    RenderTarget* getTarget() { return &target; }
+    
+    // Once per frame, right before the buffer swap: fences the frame and notes
+    // whether the GPU had finished the previous one
+    void submitFrame();
+    
+    // Feed the controller once per frame, after the swap. Time blocked in the
+    // swap counts only while the GPU is behind; otherwise it is vsync waiting
+    // and would hold the scale down for good. GPU timer queries aren't
+    // available on ES2/WebGL, and backends without fences count CPU time only.
+    void reportFrameTime(float cpuMs, float swapMs);
+    
+    // Recreate the target for a new window size
+    void setViewportSize(int width, int height);
+    
+    // Disabled, the scale stays where it is (or where setScale puts it)
+    void setEnabled(bool enabled) { this->enabled = enabled; }
+    bool isEnabled() const { return enabled; }
+    void setScale(float scale);
+    
+    float getScale() const { return scale; }
+    float getAverageFrameMs() const { return averageFrameMs; }
+    int getRenderWidth() const;
+    int getRenderHeight() const;
+    
+    const DynamicResolutionSettings& getSettings() const { return settings; }
+    void setSettings(const DynamicResolutionSettings& settings);
+    
+    void cleanup();
+
+private:
+    GraphicsAPI* graphics;
+    QuadRenderer* quadRenderer;
+    RenderTarget target; // Allocated at maxScale; lower scales use a corner of it
+    DynamicResolutionSettings settings;
+    int windowWidth, windowHeight;
+    bool enabled;
+    float scale;
+    float accumulatedMs;
+    int sampledFrames;
+    float averageFrameMs;
+    GLsync frameFence; // Of the last submitted frame
+    bool gpuBehind;    // The frame before it was still running at the last submit
+};
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include "font_asset.h"
+#include "font_library.h"
+#include "baked_font.h"
+#include "assets/asset_loader.h"
+#include <iostream>
+
+FontAsset::FontAsset(const std::string& name, int pointSize)
+    : Asset(name), pointSize(pointSize), font(nullptr) {
+}
+
+FontAsset::~FontAsset() {
+    // The layout and atlas reference the font, so they go first
+    layout.reset();
+    atlas.reset();
+    closeFont(font);
+}
+
+bool FontAsset::decode(AssetLoader& loader) {
+    AssetSpan data = loader.read(name, storage);
+    if (data.empty()) {
+        printf("Failed to read font: %s\n", name.c_str());
+        return false;
+    }
+    
+    // Baked atlases carry metrics and pixels, so FreeType is never touched
+    if (BakedFont::isBakedFont(data.data, data.size)) {
+        return decodeBaked(data, loader);
+    }
+    
+    font = openFontFromMemory(data.data, data.size, pointSize);
+    if (!font) {
+        printf("Failed to load font: %s\n", TTF_GetError());
+        return false;
+    }
+    
+    // Metrics and glyph bitmaps only need the font, not GL
+    layout = std::make_unique<TextLayout>(font);
+    atlas = std::make_unique<GlyphAtlas>(loader.getGraphics(), loader.getResources());
+    
+    // With workers available each one rasterizes part of the set from its own
+    // font instance over the same bytes
+    JobSystem* jobs = loader.getJobs();
+    bool rasterized = jobs && jobs->getWorkerCount() > 0
+        ? atlas->rasterize(data.data, data.size, pointSize, jobs)
+        : atlas->rasterize(font, jobs);
+    if (!rasterized) {
+        return false;
+    }
+    
+    // Anything past Latin-1 is rasterized into the atlas the first time it is drawn
+    return atlas->enableLazyGlyphs(data.data, data.size, pointSize);
+}
+
+bool FontAsset::decodeBaked(const AssetSpan& data, AssetLoader& loader) {
+    BakedFont baked;
+    if (!baked.load(data.data, data.size)) {
+        return false;
+    }
+    
+    const BakedFaceRecord* face = baked.findFace(pointSize);
+    if (!face) {
+        printf("Baked font has no faces: %s\n", name.c_str());
+        return false;
+    }
+    if ((int)face->pointSize != pointSize) {
+        printf("Baked font %s has no %dpt face, using %upt\n", name.c_str(), pointSize, face->pointSize);
+        pointSize = (int)face->pointSize;
+    }
+    
+    layout = std::make_unique<TextLayout>(baked, *face);
+    atlas = std::make_unique<GlyphAtlas>(loader.getGraphics(), loader.getResources());
+    return atlas->load(baked, *face);
+}
+
+bool FontAsset::finalize(GraphicsAPI* graphics) {
+    if (!atlas->upload()) {
+        return false;
+    }
+    printf("Font loaded: %s (%dpt)\n", name.c_str(), pointSize);
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SDL2/SDL_ttf.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "assets/asset.h"
+#include "assets/asset_pack.h"
+#include "glyph_atlas.h"
+#include "text_layout.h"
+
+// A font at one point size together with everything text rendering needs from
+// it. Opening the face, measuring metrics and rasterizing the Latin-1 glyph
+// set run on a worker; only the atlas texture upload is left for the render
+// thread, which also rasterizes other glyphs on first use.
+// The name may also refer to a baked atlas (tools/font_baker), which skips
+// FreeType entirely.
+class FontAsset : public Asset {
+public:
+    FontAsset(const std::string& name, int pointSize);
+    ~FontAsset();
+    
+    int getPointSize() const { return pointSize; }
+    
+    // Valid once the asset is ready; the font is null for baked atlases
+    TTF_Font* getFont() const { return font; }
+    TextLayout* getLayout() const { return layout.get(); }
+    GlyphAtlas* getAtlas() const { return atlas.get(); }
+
+protected:
+    bool decode(AssetLoader& loader) override;
+    bool finalize(GraphicsAPI* graphics) override;
+
+private:
+    int pointSize;
+    std::vector<uint8_t> storage; // Loose file bytes; packed fonts are read in place
+    TTF_Font* font;
+    std::unique_ptr<TextLayout> layout;
+    std::unique_ptr<GlyphAtlas> atlas;
+    
+    // Metrics and atlas page straight from a baked file
+    bool decodeBaked(const AssetSpan& data, AssetLoader& loader);
+};
\ No newline at end of file
@@ -0,0 +1,25 @@
+#include "font_library.h"
+#include <mutex>
+
+static std::mutex& fontLibraryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+TTF_Font* openFont(const std::string& path, int pointSize) {
+    std::lock_guard<std::mutex> lock(fontLibraryMutex());
+    return TTF_OpenFont(path.c_str(), pointSize);
+}
+
+TTF_Font* openFontFromMemory(const void* data, size_t size, int pointSize) {
+    std::lock_guard<std::mutex> lock(fontLibraryMutex());
+    return TTF_OpenFontRW(SDL_RWFromConstMem(data, (int)size), 1, pointSize);
+}
+
+void closeFont(TTF_Font* font) {
+    if (!font) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(fontLibraryMutex());
+    TTF_CloseFont(font);
+}
\ No newline at end of file
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <SDL2/SDL_ttf.h>
+#include <cstddef>
+#include <string>
+
+// Every TTF_Font shares SDL_ttf's single FreeType library, which is not
+// thread-safe for opening and closing faces. These wrappers serialize those
+// calls so fonts can be loaded from worker threads; rendering from different
+// TTF_Font objects may still run concurrently.
+TTF_Font* openFont(const std::string& path, int pointSize);
+
+// Font read in place from memory; data must outlive the font
+TTF_Font* openFontFromMemory(const void* data, size_t size, int pointSize);
+
+void closeFont(TTF_Font* font);
\ No newline at end of file
@@ -0,0 +1,339 @@
+#include "glyph_atlas.h"
+#include "baked_font.h"
+#include "font_library.h"
+#include "core/job_system.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+GlyphAtlas::GlyphAtlas(GraphicsAPI* graphics, GpuResources* resources)
+    : graphics(graphics), resources(resources), cellWidth(0), cellHeight(0), columns(0), rows(0), textureWidth(0), textureHeight(0),
+      lazyFont(nullptr), batch(1), pinRecord(nullptr), evictions(0) {
+    memset(glyphs, 0, sizeof(glyphs));
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    cleanup();
+}
+
+bool GlyphAtlas::build(TTF_Font* font, JobSystem* jobs) {
+    return rasterize(font, jobs) && upload();
+}
+
+bool GlyphAtlas::rasterize(TTF_Font* font, JobSystem* jobs) {
+    // One font instance means FreeType work stays on this thread
+    std::vector<GlyphBitmap> bitmaps(GLYPH_COUNT - FIRST_CODEPOINT);
+    for (int codepoint = FIRST_CODEPOINT; codepoint < GLYPH_COUNT; codepoint++) {
+        GlyphRasterizer::renderGlyph(font, codepoint, bitmaps[codepoint - FIRST_CODEPOINT]);
+    }
+    return pack(bitmaps, TTF_FontHeight(font), jobs);
+}
+
+bool GlyphAtlas::rasterize(const void* fontData, size_t fontDataSize, int pointSize, JobSystem* jobs) {
+    std::vector<uint32_t> codepoints;
+    for (int codepoint = FIRST_CODEPOINT; codepoint < GLYPH_COUNT; codepoint++) {
+        codepoints.push_back(codepoint);
+    }
+    
+    // Every worker renders its share of the glyph set with its own font instance
+    GlyphRasterizer rasterizer(fontData, fontDataSize, pointSize);
+    std::vector<GlyphBitmap> bitmaps;
+    if (!rasterizer.rasterize(codepoints, bitmaps, jobs)) {
+        return false;
+    }
+    return pack(bitmaps, rasterizer.getFontHeight(), jobs);
+}
+
+bool GlyphAtlas::pack(const std::vector<GlyphBitmap>& bitmaps, int minCellSize, JobSystem* jobs) {
+    cleanup();
+    
+    // Size the cells to fit the largest glyph, and at least a square em so
+    // wide glyphs (CJK) fit when they are cached later
+    int maxWidth = 1;
+    int maxHeight = std::max(1, minCellSize);
+    for (const GlyphBitmap& bitmap : bitmaps) {
+        maxWidth = std::max(maxWidth, bitmap.width);
+        maxHeight = std::max(maxHeight, bitmap.height);
+    }
+    maxWidth = std::max(maxWidth, maxHeight);
+    
+    // Prebuilt glyphs take the first cells; the rest of the grid is cache space
+    cellWidth = maxWidth + PADDING * 2;
+    cellHeight = maxHeight + PADDING * 2;
+    columns = std::max(COLUMNS, CACHE_TEXTURE_SIZE / cellWidth);
+    int prebuiltRows = (GLYPH_COUNT - FIRST_CODEPOINT + columns - 1) / columns;
+    rows = std::max(prebuiltRows + 1, CACHE_TEXTURE_SIZE / cellHeight);
+    textureWidth = columns * cellWidth;
+    textureHeight = rows * cellHeight;
+    
+    // Copy glyphs into their cells of one staging image; cells are disjoint
+    // so chunks of glyphs can be packed in parallel
+    staging.assign((size_t)textureWidth * textureHeight * 4, 0);
+    auto packGlyphs = [&](size_t begin, size_t end) {
+        for (size_t index = begin; index < end; index++) {
+            packGlyph(bitmaps[index]);
+        }
+    };
+    
+    if (jobs) {
+        jobs->parallelFor(bitmaps.size(), 16, packGlyphs);
+    } else {
+        packGlyphs(0, bitmaps.size());
+    }
+    return true;
+}
+
+bool GlyphAtlas::load(const BakedFont& baked, const BakedFaceRecord& face) {
+    cleanup();
+    
+    textureWidth = (int)baked.getPageWidth();
+    textureHeight = (int)baked.getPageHeight();
+    cellWidth = 0;
+    cellHeight = 0;
+    columns = 0;
+    rows = 0;
+    
+    // Pages store coverage only; expand to the white RGBA the text shader expects
+    const uint8_t* page = baked.getPage(face.page);
+    staging.resize((size_t)textureWidth * textureHeight * 4);
+    for (size_t i = 0; i < (size_t)textureWidth * textureHeight; i++) {
+        staging[i * 4 + 0] = 255;
+        staging[i * 4 + 1] = 255;
+        staging[i * 4 + 2] = 255;
+        staging[i * 4 + 3] = page[i];
+    }
+    
+    const BakedGlyphRecord* records = baked.getGlyphs(face);
+    for (uint32_t i = 0; i < face.glyphCount; i++) {
+        const BakedGlyphRecord& record = records[i];
+        GlyphInfo info;
+        info.u0 = (float)record.x / textureWidth;
+        info.v0 = (float)record.y / textureHeight;
+        info.u1 = (float)(record.x + record.width) / textureWidth;
+        info.v1 = (float)(record.y + record.height) / textureHeight;
+        info.width = record.width;
+        info.height = record.height;
+        info.xOffset = record.xOffset;
+        info.yOffset = record.yOffset;
+        info.valid = record.width > 0 && record.height > 0;
+        
+        if (record.codepoint < GLYPH_COUNT) {
+            glyphs[record.codepoint] = info;
+        } else {
+            extendedGlyphs[record.codepoint] = info;
+        }
+    }
+    return true;
+}
+
+bool GlyphAtlas::upload() {
+    if (staging.empty()) {
+        printf("Glyph atlas has nothing to upload\n");
+        return false;
+    }
+    
+    // Single upload for the whole glyph set
+    resources->destroy(texture);
+    texture = resources->createTexture();
+    graphics->bindTexture(GL_TEXTURE_2D, resources->get(texture));
+    graphics->texImage2D(GL_TEXTURE_2D, 0, GL_RGBA, textureWidth, textureHeight, GL_RGBA, GL_UNSIGNED_BYTE, staging.data());
+    resources->setSize(texture, GpuResources::getTextureBytes(textureWidth, textureHeight));
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    
+    // The texture now holds the only copy
+    staging.clear();
+    staging.shrink_to_fit();
+    
+    printf("Glyph atlas uploaded: %dx%d (%dx%d cells)\n", textureWidth, textureHeight, cellWidth, cellHeight);
+    return true;
+}
+
+void GlyphAtlas::packGlyph(const GlyphBitmap& bitmap) {
+    if (bitmap.empty() || bitmap.codepoint < FIRST_CODEPOINT || bitmap.codepoint >= GLYPH_COUNT) {
+        return;
+    }
+    
+    GlyphInfo& info = glyphs[bitmap.codepoint];
+    placeInCell(bitmap.codepoint - FIRST_CODEPOINT, bitmap.width, bitmap.height, info);
+    int x = (int)(info.u0 * textureWidth + 0.5f);
+    int y = (int)(info.v0 * textureHeight + 0.5f);
+    for (int row = 0; row < info.height; row++) {
+        memcpy(&staging[((size_t)(y + row) * textureWidth + x) * 4], &bitmap.pixels[(size_t)row * bitmap.width * 4], info.width * 4);
+    }
+}
+
+void GlyphAtlas::placeInCell(int cell, int width, int height, GlyphInfo& info) const {
+    // Oversized glyphs are cropped to the cell
+    width = std::min(width, cellWidth - PADDING * 2);
+    height = std::min(height, cellHeight - PADDING * 2);
+    int x = (cell % columns) * cellWidth + PADDING;
+    int y = (cell / columns) * cellHeight + PADDING;
+    
+    info.u0 = (float)x / textureWidth;
+    info.v0 = (float)y / textureHeight;
+    info.u1 = (float)(x + width) / textureWidth;
+    info.v1 = (float)(y + height) / textureHeight;
+    info.width = width;
+    info.height = height;
+    info.xOffset = 0;
+    info.yOffset = 0;
+    info.valid = true;
+}
+
+bool GlyphAtlas::enableLazyGlyphs(const void* fontData, size_t fontDataSize, int pointSize) {
+    if (columns == 0) {
+        printf("Lazy glyphs need a rasterized grid atlas\n");
+        return false;
+    }
+    
+    closeFont(lazyFont);
+    lazyFont = openFontFromMemory(fontData, fontDataSize, pointSize);
+    if (!lazyFont) {
+        printf("Failed to open font for lazy glyphs: %s\n", TTF_GetError());
+        return false;
+    }
+    
+    // Every cell after the prebuilt set is cache space
+    int firstFree = GLYPH_COUNT - FIRST_CODEPOINT;
+    slots.assign(columns * rows - firstFree, CacheSlot());
+    return true;
+}
+
+const GlyphInfo* GlyphAtlas::getGlyph(uint32_t codepoint) {
+    // Latin-1 fast path: prebuilt and never evicted
+    if (codepoint < GLYPH_COUNT) {
+        return glyphs[codepoint].valid ? &glyphs[codepoint] : nullptr;
+    }
+    
+    if (!extendedGlyphs.empty()) {
+        auto baked = extendedGlyphs.find(codepoint);
+        if (baked != extendedGlyphs.end()) {
+            return baked->second.valid ? &baked->second : nullptr;
+        }
+    }
+    
+    auto cached = cachedSlots.find(codepoint);
+    if (cached != cachedSlots.end()) {
+        CacheSlot& slot = slots[cached->second];
+        slot.lastUsed = batch;
+        if (pinRecord) {
+            slot.pins++;
+            pinRecord->push_back(codepoint);
+        }
+        return &slot.info;
+    }
+    
+    if (!lazyFont || texture.isNull() || missingGlyphs.count(codepoint)) {
+        return nullptr;
+    }
+    return insertGlyph(codepoint);
+}
+
+bool GlyphAtlas::pin(uint32_t codepoint) {
+    auto cached = cachedSlots.find(codepoint);
+    if (cached == cachedSlots.end()) {
+        return false;
+    }
+    slots[cached->second].pins++;
+    return true;
+}
+
+void GlyphAtlas::unpin(uint32_t codepoint) {
+    // Pinned glyphs stay cached, so a miss means the atlas was rebuilt since the
+    // pin was taken and there is nothing left to release
+    auto cached = cachedSlots.find(codepoint);
+    if (cached != cachedSlots.end() && slots[cached->second].pins > 0) {
+        slots[cached->second].pins--;
+    }
+}
+
+int GlyphAtlas::getCellIndex(uint32_t codepoint) {
+    if (columns == 0 || !getGlyph(codepoint)) {
+        return -1;
+    }
+    if (codepoint < GLYPH_COUNT) {
+        return codepoint - FIRST_CODEPOINT;
+    }
+    
+    auto cached = cachedSlots.find(codepoint);
+    return cached != cachedSlots.end() ? GLYPH_COUNT - FIRST_CODEPOINT + cached->second : -1;
+}
+
+const GlyphInfo* GlyphAtlas::insertGlyph(uint32_t codepoint) {
+    GlyphBitmap bitmap;
+    if (!GlyphRasterizer::renderGlyph(lazyFont, codepoint, bitmap)) {
+        missingGlyphs.insert(codepoint);
+        return nullptr;
+    }
+    
+    int index = findFreeSlot();
+    if (index < 0) {
+        return nullptr; // Every cell is needed by the batch being built
+    }
+    
+    CacheSlot& slot = slots[index];
+    if (slot.occupied) {
+        cachedSlots.erase(slot.codepoint);
+        evictions++;
+    }
+    slot.codepoint = codepoint;
+    slot.lastUsed = batch;
+    slot.occupied = true;
+    slot.pins = 0;
+    if (pinRecord) {
+        slot.pins = 1;
+        pinRecord->push_back(codepoint);
+    }
+    
+    int cell = GLYPH_COUNT - FIRST_CODEPOINT + index;
+    placeInCell(cell, bitmap.width, bitmap.height, slot.info);
+    cachedSlots[codepoint] = index;
+    
+    // Upload the whole cell so no pixels of an evicted glyph remain
+    cellPixels.assign((size_t)cellWidth * cellHeight * 4, 0);
+    for (int row = 0; row < slot.info.height; row++) {
+        memcpy(&cellPixels[((size_t)(row + PADDING) * cellWidth + PADDING) * 4], &bitmap.pixels[(size_t)row * bitmap.width * 4],
+               slot.info.width * 4);
+    }
+    graphics->bindTexture(GL_TEXTURE_2D, resources->get(texture));
+    graphics->texSubImage2D(GL_TEXTURE_2D, 0, (cell % columns) * cellWidth, (cell / columns) * cellHeight,
+                            cellWidth, cellHeight, GL_RGBA, GL_UNSIGNED_BYTE, cellPixels.data());
+    return &slot.info;
+}
+
+int GlyphAtlas::findFreeSlot() {
+    // Least recently used glyph that isn't pinned or part of the current batch
+    int best = -1;
+    for (size_t i = 0; i < slots.size(); i++) {
+        const CacheSlot& slot = slots[i];
+        if (!slot.occupied) {
+            return (int)i;
+        }
+        if (slot.pins || slot.lastUsed >= batch) {
+            continue;
+        }
+        if (best < 0 || slot.lastUsed < slots[best].lastUsed) {
+            best = (int)i;
+        }
+    }
+    return best;
+}
+
+void GlyphAtlas::cleanup() {
+    // Frames still in flight may sample the atlas; the delete waits for them
+    if (resources) {
+        resources->destroy(texture);
+    }
+    memset(glyphs, 0, sizeof(glyphs));
+    extendedGlyphs.clear();
+    staging.clear();
+    
+    closeFont(lazyFont);
+    lazyFont = nullptr;
+    slots.clear();
+    cachedSlots.clear();
+    missingGlyphs.clear();
+}
\ No newline at end of file
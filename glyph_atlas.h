@@ -0,0 +1,138 @@
+#pragma once
+
+#include <SDL2/SDL_ttf.h>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "glyph_rasterizer.h"
+#include "graphics/graphics_api.h"
+#include "graphics/gpu_resources.h"
+
+class BakedFont;
+struct BakedFaceRecord;
+class JobSystem;
+
+struct GlyphInfo {
+    float u0, v0, u1, v1;   // Texture coordinates of the glyph bitmap
+    int width, height;      // Bitmap size in pixels
+    int xOffset, yOffset;   // Bitmap position relative to the pen (trimmed baked glyphs)
+    bool valid;
+};
+
+// Glyphs of one font in a grid of equal cells in a single texture, so any
+// string can be drawn from one texture binding. Latin-1 is rasterized up
+// front and always resident; with lazy glyphs enabled every other codepoint
+// is rasterized into a free cell the first time it is drawn, and the least
+// recently used of those are evicted when the grid is full.
+class GlyphAtlas {
+public:
+    GlyphAtlas(GraphicsAPI* graphics, GpuResources* resources);
+    ~GlyphAtlas();
+    
+    // Rasterize the glyph set and upload it; with a job system the pixel
+    // conversion and packing are spread over the workers
+    bool build(TTF_Font* font, JobSystem* jobs = nullptr);
+    
+    // The two halves of build(): rasterize touches no GL and may run on a
+    // worker thread, upload must run on the render thread
+    bool rasterize(TTF_Font* font, JobSystem* jobs = nullptr);
+    bool upload();
+    
+    // Parallel rasterize: each worker opens its own instance of the font data,
+    // which must stay valid until this returns
+    bool rasterize(const void* fontData, size_t fontDataSize, int pointSize, JobSystem* jobs);
+    
+    // Take glyphs and pixels of one face from a baked atlas instead of
+    // rasterizing; upload() then sends its page in one call
+    bool load(const BakedFont& baked, const BakedFaceRecord& face);
+    
+    // Rasterize codepoints outside the prebuilt set on demand, using a private
+    // font instance on fontData (which must outlive the atlas). Grid atlases only.
+    bool enableLazyGlyphs(const void* fontData, size_t fontDataSize, int pointSize);
+    
+    // Glyph lookup, rasterizing on a cache miss when lazy glyphs are enabled.
+    // Null when the font lacks the codepoint or every cell is in use by the current batch.
+    const GlyphInfo* getGlyph(uint32_t codepoint);
+    
+    // Pinned glyphs are never evicted (retained text meshes, terminal cells).
+    // Pins are counted and each pin needs its own unpin; glyphs that are never
+    // evicted anyway (prebuilt, baked) take no pin and pin returns false.
+    bool pin(uint32_t codepoint);
+    void unpin(uint32_t codepoint);
+    
+    // While a record is set, every lazily cached glyph looked up is pinned and
+    // its codepoint appended to it; unpin each entry to release. Null stops.
+    void setPinRecord(std::vector<uint32_t>* record) { pinRecord = record; }
+    
+    // Glyphs used before this call may be evicted; call after each draw
+    void endBatch() { batch++; }
+    
+    GLuint getTexture() const { return resources->get(texture); }
+    int getTextureWidth() const { return textureWidth; }
+    int getTextureHeight() const { return textureHeight; }
+    
+    // Grid layout for shaders that address cells directly (terminal grids).
+    // Columns is 0 for baked atlases, which are packed rather than gridded.
+    int getGridColumns() const { return columns; }
+    int getCellWidth() const { return cellWidth; }
+    int getCellHeight() const { return cellHeight; }
+    int getCellPadding() const { return PADDING; }
+    
+    // Grid cell holding a codepoint, rasterizing it on a miss; -1 when unavailable
+    int getCellIndex(uint32_t codepoint);
+    
+    // Cache statistics
+    size_t getCachedGlyphCount() const { return cachedSlots.size(); }
+    size_t getCacheCapacity() const { return slots.size(); }
+    size_t getEvictionCount() const { return evictions; }
+    
+    void cleanup();
+
+private:
+    static constexpr int FIRST_CODEPOINT = 32;
+    static constexpr int GLYPH_COUNT = 256;
+    static constexpr int COLUMNS = 16;
+    static constexpr int CACHE_TEXTURE_SIZE = 1024; // Grid size target once lazy glyphs are on
+    static constexpr int PADDING = 1; // Keeps linear filtering from bleeding between cells
+    
+    // One grid cell available to lazily rasterized glyphs
+    struct CacheSlot {
+        uint32_t codepoint;
+        uint64_t lastUsed;
+        bool occupied;
+        uint32_t pins;
+        GlyphInfo info;
+    };
+    
+    GraphicsAPI* graphics;
+    GpuResources* resources;
+    TextureHandle texture;
+    int cellWidth, cellHeight;
+    int columns, rows;
+    int textureWidth, textureHeight;
+    GlyphInfo glyphs[GLYPH_COUNT];
+    std::unordered_map<uint32_t, GlyphInfo> extendedGlyphs; // Baked glyphs past Latin-1
+    std::vector<uint8_t> staging; // Rasterized image waiting for upload
+    
+    // Lazy glyph cache
+    TTF_Font* lazyFont;
+    std::vector<CacheSlot> slots;            // Cells after the prebuilt set
+    std::unordered_map<uint32_t, int> cachedSlots;
+    std::unordered_set<uint32_t> missingGlyphs; // Not in the font; don't retry
+    std::vector<uint8_t> cellPixels;
+    uint64_t batch;
+    std::vector<uint32_t>* pinRecord;
+    size_t evictions;
+    
+    // Lay rasterized glyphs out in cells of the staging image
+    bool pack(const std::vector<GlyphBitmap>& bitmaps, int minCellSize, JobSystem* jobs);
+    void packGlyph(const GlyphBitmap& bitmap);
+    
+    // Cell geometry shared by the prebuilt set and the cache
+    void placeInCell(int cell, int width, int height, GlyphInfo& info) const;
+    
+    // Rasterize a codepoint into a free or evicted cell and upload just that cell
+    const GlyphInfo* insertGlyph(uint32_t codepoint);
+    int findFreeSlot();
+};
@@ -0,0 +1,77 @@
+#include "glyph_rasterizer.h"
+#include "font_library.h"
+#include "core/job_system.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+
+GlyphRasterizer::GlyphRasterizer(const void* fontData, size_t fontDataSize, int pointSize)
+    : fontData(fontData), fontDataSize(fontDataSize), pointSize(pointSize), fontHeight(0) {
+}
+
+bool GlyphRasterizer::rasterize(const std::vector<uint32_t>& codepoints, std::vector<GlyphBitmap>& bitmaps, JobSystem* jobs) {
+    bitmaps.assign(codepoints.size(), GlyphBitmap());
+    
+    // One subset per thread; interleaving keeps dense and sparse ranges balanced
+    size_t subsets = jobs ? (size_t)jobs->getThreadCount() : 1;
+    subsets = std::max<size_t>(1, std::min(subsets, codepoints.size()));
+    std::atomic<bool> opened(true);
+    std::atomic<int> height(0);
+    
+    auto rasterizeSubset = [&](size_t begin, size_t end) {
+        for (size_t subset = begin; subset < end; subset++) {
+            TTF_Font* font = openFontFromMemory(fontData, fontDataSize, pointSize);
+            if (!font) {
+                printf("Failed to open font for rasterizing: %s\n", TTF_GetError());
+                opened = false;
+                continue;
+            }
+            height = TTF_FontHeight(font); // The same for every instance
+            
+            for (size_t i = subset; i < codepoints.size(); i += subsets) {
+                renderGlyph(font, codepoints[i], bitmaps[i]);
+            }
+            closeFont(font);
+        }
+    };
+    
+    if (jobs) {
+        jobs->parallelFor(subsets, 1, rasterizeSubset);
+    } else {
+        rasterizeSubset(0, subsets);
+    }
+    fontHeight = height;
+    return opened;
+}
+
+bool GlyphRasterizer::renderGlyph(TTF_Font* font, uint32_t codepoint, GlyphBitmap& bitmap) {
+    bitmap.codepoint = codepoint;
+    if (!TTF_GlyphIsProvided32(font, codepoint)) {
+        return false;
+    }
+    
+    SDL_Color white = {255, 255, 255, 255};
+    SDL_Surface* surface = TTF_RenderGlyph32_Blended(font, codepoint, white);
+    if (!surface) {
+        return false;
+    }
+    
+    SDL_Surface* rgba = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(surface);
+    if (!rgba) {
+        printf("Failed to convert glyph surface: %s\n", SDL_GetError());
+        return false;
+    }
+    
+    // Drop the surface pitch so bitmaps can be blitted row by row
+    bitmap.width = rgba->w;
+    bitmap.height = rgba->h;
+    bitmap.pixels.resize((size_t)rgba->w * rgba->h * 4);
+    const uint8_t* source = static_cast<const uint8_t*>(rgba->pixels);
+    for (int row = 0; row < rgba->h; row++) {
+        memcpy(&bitmap.pixels[(size_t)row * rgba->w * 4], source + row * rgba->pitch, rgba->w * 4);
+    }
+    SDL_FreeSurface(rgba);
+    return true;
+}
\ No newline at end of file
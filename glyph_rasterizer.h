@@ -0,0 +1,43 @@
+#pragma once
+
+#include <SDL2/SDL_ttf.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class JobSystem;
+
+// One rasterized glyph, converted to tightly packed RGBA32
+struct GlyphBitmap {
+    uint32_t codepoint = 0;
+    int width = 0;
+    int height = 0;
+    std::vector<uint8_t> pixels;
+    
+    bool empty() const { return pixels.empty(); }
+};
+
+// Rasterizes glyph sets on several threads. A TTF_Font is not safe to share,
+// so every job opens its own instance on the same in-memory font data and
+// renders a disjoint, interleaved subset of the codepoints.
+class GlyphRasterizer {
+public:
+    // fontData must stay valid while rasterizing
+    GlyphRasterizer(const void* fontData, size_t fontDataSize, int pointSize);
+    
+    // bitmaps[i] receives codepoints[i]; glyphs missing from the font stay empty.
+    // Without a job system (or with no workers) everything runs on the caller.
+    bool rasterize(const std::vector<uint32_t>& codepoints, std::vector<GlyphBitmap>& bitmaps, JobSystem* jobs = nullptr);
+    
+    // Render one glyph from an already open font
+    static bool renderGlyph(TTF_Font* font, uint32_t codepoint, GlyphBitmap& bitmap);
+    
+    // TTF_FontHeight of the font, known once rasterize has opened it (0 before)
+    int getFontHeight() const { return fontHeight; }
+
+private:
+    const void* fontData;
+    size_t fontDataSize;
+    int pointSize;
+    int fontHeight;
+};
\ No newline at end of file
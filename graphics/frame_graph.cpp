@@ -0,0 +1,439 @@
+#include "frame_graph.h"
+#include <algorithm>
+#include <iostream>
+
+FrameGraphResource FrameGraphBuilder::create(const std::string& name, int width, int height) {
+    FrameGraph::Resource resource;
+    resource.name = name;
+    resource.kind = FrameGraph::ResourceKind::Transient;
+    resource.width = width;
+    resource.height = height;
+    resource.target = nullptr;
+    resource.firstUse = -1;
+    resource.lastUse = -1;
+    resource.slot = -1;
+    graph->resources.push_back(resource);
+    return (FrameGraphResource)graph->resources.size() - 1;
+}
+
+FrameGraphResource FrameGraphBuilder::read(FrameGraphResource resource) {
+    if (resource < 0 || resource >= (int)graph->resources.size()) {
+        printf("Frame graph pass %s reads an unknown resource\n", graph->passes[pass].name.c_str());
+        return -1;
+    }
+    graph->passes[pass].reads.push_back(resource);
+    graph->resources[resource].readers.push_back(pass);
+    return resource;
+}
+
+FrameGraphResource FrameGraphBuilder::write(FrameGraphResource resource) {
+    if (resource < 0 || resource >= (int)graph->resources.size()) {
+        printf("Frame graph pass %s writes an unknown resource\n", graph->passes[pass].name.c_str());
+        return -1;
+    }
+    if (graph->passes[pass].output >= 0) {
+        printf("Frame graph pass %s writes more than one resource\n", graph->passes[pass].name.c_str());
+        return -1;
+    }
+    graph->passes[pass].output = resource;
+    graph->resources[resource].writers.push_back(pass);
+    return resource;
+}
+
+GLuint FrameGraphContext::getTexture(FrameGraphResource resource) const {
+    if (resource < 0 || resource >= (int)graph->resources.size() || !graph->resources[resource].target) {
+        return 0;
+    }
+    return graph->resources[resource].target->getTexture();
+}
+
+FrameGraph::FrameGraph(GraphicsAPI* graphics, GpuResources* gpuResources)
+    : graphics(graphics), gpuResources(gpuResources), compiled(false), windowWidth(0), windowHeight(0) {
+}
+
+FrameGraph::~FrameGraph() {
+    cleanup();
+}
+
+FrameGraphResource FrameGraph::importBackbuffer(int width, int height) {
+    windowWidth = width;
+    windowHeight = height;
+    
+    Resource resource;
+    resource.name = "backbuffer";
+    resource.kind = ResourceKind::Backbuffer;
+    resource.width = width;
+    resource.height = height;
+    resource.target = nullptr;
+    resource.firstUse = -1;
+    resource.lastUse = -1;
+    resource.slot = -1;
+    resources.push_back(resource);
+    return (FrameGraphResource)resources.size() - 1;
+}
+
+FrameGraphResource FrameGraph::importTarget(const std::string& name, RenderTarget* target, int viewportWidth, int viewportHeight) {
+    Resource resource;
+    resource.name = name;
+    resource.kind = ResourceKind::Imported;
+    resource.width = viewportWidth;
+    resource.height = viewportHeight;
+    resource.target = target;
+    resource.firstUse = -1;
+    resource.lastUse = -1;
+    resource.slot = -1;
+    resources.push_back(resource);
+    return (FrameGraphResource)resources.size() - 1;
+}
+
+void FrameGraph::addPass(const std::string& name, const std::function<void(FrameGraphBuilder&)>& setup,
+                         const std::function<void(FrameGraphContext&)>& execute) {
+    Pass pass;
+    pass.name = name;
+    pass.execute = execute;
+    pass.output = -1;
+    pass.sideEffect = false;
+    pass.culled = false;
+    passes.push_back(pass);
+    
+    FrameGraphBuilder builder(this, (int)passes.size() - 1);
+    setup(builder);
+    passes.back().sideEffect = builder.sideEffect;
+    compiled = false;
+}
+
+bool FrameGraph::compile() {
+    // Cull: walk back from passes with visible results (the window, imported
+    // targets, side effects) through the writers of everything they read
+    std::vector<int> stack;
+    for (size_t i = 0; i < passes.size(); i++) {
+        Pass& pass = passes[i];
+        pass.culled = true;
+        bool visible = pass.output >= 0 && resources[pass.output].kind != ResourceKind::Transient;
+        if (pass.sideEffect || visible) {
+            pass.culled = false;
+            stack.push_back((int)i);
+        }
+    }
+    while (!stack.empty()) {
+        int index = stack.back();
+        stack.pop_back();
+        for (FrameGraphResource read : passes[index].reads) {
+            for (int writer : resources[read].writers) {
+                if (passes[writer].culled) {
+                    passes[writer].culled = false;
+                    stack.push_back(writer);
+                }
+            }
+        }
+    }
+    
+    // A transient has no contents until a pass draws into it; sampling one that
+    // only the reading pass (or no pass) writes reads last frame's or another transient's pixels
+    for (const Pass& pass : passes) {
+        if (pass.culled) {
+            continue;
+        }
+        for (FrameGraphResource read : pass.reads) {
+            const Resource& resource = resources[read];
+            bool written = std::any_of(resource.writers.begin(), resource.writers.end(), [&](int writer) {
+                return &passes[writer] != &pass;
+            });
+            if (resource.kind == ResourceKind::Transient && !written) {
+                printf("Frame graph pass %s reads transient %s, which no earlier pass writes\n", pass.name.c_str(),
+                       resource.name.c_str());
+                return false;
+            }
+        }
+    }
+    
+    if (!sortPasses()) {
+        return false;
+    }
+    
+    // Lifetimes in compiled positions
+    for (Resource& resource : resources) {
+        resource.firstUse = -1;
+        resource.lastUse = -1;
+    }
+    for (int position = 0; position < (int)order.size(); position++) {
+        const Pass& pass = passes[order[position]];
+        std::vector<FrameGraphResource> used = pass.reads;
+        if (pass.output >= 0) {
+            used.push_back(pass.output);
+        }
+        for (FrameGraphResource index : used) {
+            Resource& resource = resources[index];
+            if (resource.firstUse < 0) {
+                resource.firstUse = position;
+            }
+            resource.lastUse = position;
+        }
+    }
+    
+    assignSlots();
+    compiled = true;
+    return true;
+}
+
+bool FrameGraph::sortPasses() {
+    order.clear();
+    
+    // A pass depends on the writers of what it reads, and on earlier writers
+    // of what it writes so draws into one target keep their declared order
+    std::vector<std::vector<int>> dependents(passes.size());
+    std::vector<int> pending(passes.size(), 0);
+    for (size_t i = 0; i < passes.size(); i++) {
+        const Pass& pass = passes[i];
+        if (pass.culled) {
+            continue;
+        }
+        std::vector<int> dependencies;
+        for (FrameGraphResource read : pass.reads) {
+            for (int writer : resources[read].writers) {
+                if (writer != (int)i) {
+                    dependencies.push_back(writer);
+                }
+            }
+        }
+        if (pass.output >= 0) {
+            for (int writer : resources[pass.output].writers) {
+                if (writer < (int)i) {
+                    dependencies.push_back(writer);
+                }
+            }
+        }
+        std::sort(dependencies.begin(), dependencies.end());
+        dependencies.erase(std::unique(dependencies.begin(), dependencies.end()), dependencies.end());
+        for (int dependency : dependencies) {
+            if (!passes[dependency].culled) {
+                dependents[dependency].push_back((int)i);
+                pending[i]++;
+            }
+        }
+    }
+    
+    // Lowest ready index first keeps declaration order wherever dependencies allow
+    std::vector<int> ready;
+    size_t liveCount = 0;
+    for (size_t i = 0; i < passes.size(); i++) {
+        if (!passes[i].culled) {
+            liveCount++;
+            if (pending[i] == 0) {
+                ready.push_back((int)i);
+            }
+        }
+    }
+    while (!ready.empty()) {
+        auto lowest = std::min_element(ready.begin(), ready.end());
+        int index = *lowest;
+        ready.erase(lowest);
+        order.push_back(index);
+        for (int dependent : dependents[index]) {
+            if (--pending[dependent] == 0) {
+                ready.push_back(dependent);
+            }
+        }
+    }
+    
+    if (order.size() != liveCount) {
+        printf("Frame graph has a dependency cycle between its passes\n");
+        order.clear();
+        return false;
+    }
+    return true;
+}
+
+void FrameGraph::assignSlots() {
+    slots.clear();
+    
+    // Transients in order of first use; a slot is reusable once its last user has run
+    std::vector<int> transients;
+    for (size_t i = 0; i < resources.size(); i++) {
+        resources[i].slot = -1;
+        if (resources[i].kind == ResourceKind::Transient && resources[i].firstUse >= 0) {
+            transients.push_back((int)i);
+        }
+    }
+    std::sort(transients.begin(), transients.end(), [this](int a, int b) {
+        return resources[a].firstUse < resources[b].firstUse;
+    });
+    
+    for (int index : transients) {
+        Resource& resource = resources[index];
+        for (size_t s = 0; s < slots.size(); s++) {
+            Slot& slot = slots[s];
+            if (slot.width == resource.width && slot.height == resource.height && slot.freeAfter < resource.firstUse) {
+                resource.slot = (int)s;
+                slot.freeAfter = resource.lastUse;
+                break;
+            }
+        }
+        if (resource.slot < 0) {
+            resource.slot = (int)slots.size();
+            slots.push_back({resource.width, resource.height, resource.lastUse});
+        }
+    }
+}
+
+RenderTarget* FrameGraph::acquireTarget(int width, int height) {
+    for (PooledTarget& pooled : pool) {
+        if (!pooled.inUse && pooled.target->getWidth() == width && pooled.target->getHeight() == height) {
+            pooled.inUse = true;
+            return pooled.target.get();
+        }
+    }
+    
+    PooledTarget pooled;
+    pooled.target = std::make_unique<RenderTarget>(graphics, gpuResources);
+    if (!pooled.target->initialize(width, height)) {
+        return nullptr;
+    }
+    pooled.inUse = true;
+    pooled.idleFrames = 0;
+    pool.push_back(std::move(pooled));
+    return pool.back().target.get();
+}
+
+void FrameGraph::execute() {
+    if (!compiled && !compile()) {
+        return;
+    }
+    
+    // Realize slots from the pool, then point each transient at its slot's target
+    for (PooledTarget& pooled : pool) {
+        pooled.inUse = false;
+    }
+    std::vector<RenderTarget*> slotTargets;
+    for (const Slot& slot : slots) {
+        slotTargets.push_back(acquireTarget(slot.width, slot.height));
+    }
+    for (Resource& resource : resources) {
+        if (resource.kind == ResourceKind::Transient) {
+            resource.target = resource.slot >= 0 ? slotTargets[resource.slot] : nullptr;
+        }
+    }
+    
+    for (int index : order) {
+        const Pass& pass = passes[index];
+        RenderTarget* target = nullptr;
+        int width = windowWidth;
+        int height = windowHeight;
+        if (pass.output >= 0) {
+            const Resource& output = resources[pass.output];
+            if (output.kind != ResourceKind::Backbuffer) {
+                target = output.target;
+                if (!target) {
+                    printf("Frame graph pass %s has no target for %s; skipped\n", pass.name.c_str(), output.name.c_str());
+                    continue;
+                }
+            }
+            width = output.width;
+            height = output.height;
+        }
+        
+        if (target) {
+            target->begin(width, height);
+        } else {
+            graphics->bindFramebuffer(0);
+            graphics->viewport(0, 0, windowWidth, windowHeight);
+        }
+        FrameGraphContext context(this, width, height);
+        pass.execute(context);
+        if (target) {
+            target->end(windowWidth, windowHeight);
+        }
+    }
+    
+    // Free targets no frame has needed for a while
+    for (PooledTarget& pooled : pool) {
+        pooled.idleFrames = pooled.inUse ? 0 : pooled.idleFrames + 1;
+    }
+    pool.erase(std::remove_if(pool.begin(), pool.end(), [](const PooledTarget& pooled) {
+        return pooled.idleFrames > POOL_IDLE_FRAMES;
+    }), pool.end());
+}
+
+void FrameGraph::reset() {
+    resources.clear();
+    passes.clear();
+    order.clear();
+    slots.clear();
+    compiled = false;
+}
+
+void FrameGraph::dump() const {
+    printf("Frame graph: %d passes, %d culled\n", (int)passes.size(), getCulledPassCount());
+    for (size_t position = 0; position < order.size(); position++) {
+        const Pass& pass = passes[order[position]];
+        printf("  %zu. %s", position, pass.name.c_str());
+        for (size_t i = 0; i < pass.reads.size(); i++) {
+            printf("%s%s", i == 0 ? "  reads " : ", ", resources[pass.reads[i]].name.c_str());
+        }
+        if (pass.output >= 0) {
+            printf("  writes %s", resources[pass.output].name.c_str());
+        }
+        printf("%s\n", pass.sideEffect ? "  (side effect)" : "");
+    }
+    for (const Pass& pass : passes) {
+        if (pass.culled) {
+            printf("  culled: %s\n", pass.name.c_str());
+        }
+    }
+    
+    for (const Resource& resource : resources) {
+        const char* kind = resource.kind == ResourceKind::Transient ? "transient"
+                         : resource.kind == ResourceKind::Imported ? "imported" : "backbuffer";
+        if (resource.firstUse < 0) {
+            printf("  %-20s %-10s %dx%d unused\n", resource.name.c_str(), kind, resource.width, resource.height);
+        } else if (resource.slot >= 0) {
+            printf("  %-20s %-10s %dx%d passes %d-%d slot %d\n", resource.name.c_str(), kind, resource.width,
+                   resource.height, resource.firstUse, resource.lastUse, resource.slot);
+        } else {
+            printf("  %-20s %-10s %dx%d passes %d-%d\n", resource.name.c_str(), kind, resource.width, resource.height,
+                   resource.firstUse, resource.lastUse);
+        }
+    }
+    printf("  transient memory %.2f MB (%.2f MB without aliasing), pool %.2f MB in %zu targets\n",
+           getTransientBytes() / (1024.0 * 1024.0), getUnaliasedBytes() / (1024.0 * 1024.0),
+           getPooledBytes() / (1024.0 * 1024.0), pool.size());
+}
+
+size_t FrameGraph::getTransientBytes() const {
+    size_t bytes = 0;
+    for (const Slot& slot : slots) {
+        bytes += (size_t)slot.width * slot.height * 4;
+    }
+    return bytes;
+}
+
+size_t FrameGraph::getUnaliasedBytes() const {
+    size_t bytes = 0;
+    for (const Resource& resource : resources) {
+        if (resource.kind == ResourceKind::Transient && resource.firstUse >= 0) {
+            bytes += (size_t)resource.width * resource.height * 4;
+        }
+    }
+    return bytes;
+}
+
+size_t FrameGraph::getPooledBytes() const {
+    size_t bytes = 0;
+    for (const PooledTarget& pooled : pool) {
+        bytes += (size_t)pooled.target->getWidth() * pooled.target->getHeight() * 4;
+    }
+    return bytes;
+}
+
+int FrameGraph::getCulledPassCount() const {
+    int culled = 0;
+    for (const Pass& pass : passes) {
+        culled += pass.culled ? 1 : 0;
+    }
+    return culled;
+}
+
+void FrameGraph::cleanup() {
+    reset();
+    pool.clear();
+}
\ No newline at end of file
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "graphics_api.h"
+#include "render_target.h"
+
+// Handle to a texture declared in a frame graph; -1 is none
+typedef int FrameGraphResource;
+
+class FrameGraph;
+
+// Passed to a pass's setup callback to declare what it touches
+class FrameGraphBuilder {
+public:
+    // A texture that only lives for this frame; its memory may be shared with
+    // other transients whose lifetimes don't overlap
+    FrameGraphResource create(const std::string& name, int width, int height);
+    
+    // The pass samples the resource, so it runs after every pass writing it
+    FrameGraphResource read(FrameGraphResource resource);
+    
+    // The pass draws into the resource; it becomes the pass's render target.
+    // One written resource per pass, since ES2 has a single color attachment.
+    FrameGraphResource write(FrameGraphResource resource);
+    
+    // Keep the pass even though nothing reads what it writes
+    void setSideEffect() { sideEffect = true; }
+
+private:
+    friend class FrameGraph;
+    
+    FrameGraph* graph;
+    int pass;
+    bool sideEffect;
+    
+    FrameGraphBuilder(FrameGraph* graph, int pass) : graph(graph), pass(pass), sideEffect(false) {}
+};
+
+// Passed to a pass's execute callback; the pass's target is already bound
+class FrameGraphContext {
+public:
+    // Texture of a resource the pass declared a read of
+    GLuint getTexture(FrameGraphResource resource) const;
+    
+    // Size of the bound target's viewport
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+
+private:
+    friend class FrameGraph;
+    
+    const FrameGraph* graph;
+    int width, height;
+    
+    FrameGraphContext(const FrameGraph* graph, int width, int height) : graph(graph), width(width), height(height) {}
+};
+
+// Declarative description of a frame's render passes. Each frame the passes
+// are added with the resources they read and write, then compile() drops
+// passes whose output nobody uses, orders the rest so writers run before
+// readers, and assigns transient textures to pooled render targets so that
+// transients with disjoint lifetimes share one allocation. The pool persists
+// across frames, so a steady frame allocates nothing.
+class FrameGraph {
+public:
+    FrameGraph(GraphicsAPI* graphics, GpuResources* gpuResources);
+    ~FrameGraph();
+    
+    // The window; passes writing it are never culled
+    FrameGraphResource importBackbuffer(int width, int height);
+    
+    // A target owned elsewhere (a cached layer, the dynamic resolution scene),
+    // drawn into through the given bottom-left viewport
+    FrameGraphResource importTarget(const std::string& name, RenderTarget* target, int viewportWidth, int viewportHeight);
+    
+    void addPass(const std::string& name, const std::function<void(FrameGraphBuilder&)>& setup,
+                 const std::function<void(FrameGraphContext&)>& execute);
+    
+    // Cull, order and assign memory. False (with a message) on a dependency cycle
+    // or a read of a transient that no other pass writes.
+    bool compile();
+    
+    // Run the compiled passes, each with its target bound, and finish on the window
+    void execute();
+    
+    // Drop this frame's passes and resources; pooled targets are kept
+    void reset();
+    
+    // Print the compiled frame: pass order, culled passes, resource lifetimes
+    // and the memory transients would take with and without aliasing
+    void dump() const;
+    
+    // Transient texture bytes this frame after aliasing, and without it
+    size_t getTransientBytes() const;
+    size_t getUnaliasedBytes() const;
+    
+    // Bytes held by the pool of transient targets
+    size_t getPooledBytes() const;
+    
+    int getPassCount() const { return (int)passes.size(); }
+    int getCulledPassCount() const;
+    
+    // Free pooled targets
+    void cleanup();
+
+private:
+    friend class FrameGraphBuilder;
+    friend class FrameGraphContext;
+    
+    enum class ResourceKind { Transient, Imported, Backbuffer };
+    
+    struct Resource {
+        std::string name;
+        ResourceKind kind;
+        int width, height;
+        RenderTarget* target;             // Imported targets, and transients once assigned
+        std::vector<int> writers;         // Passes in declaration order
+        std::vector<int> readers;
+        int firstUse, lastUse;            // Positions in the compiled order
+        int slot;                         // Aliasing slot for transients
+    };
+    
+    struct Pass {
+        std::string name;
+        std::function<void(FrameGraphContext&)> execute;
+        std::vector<FrameGraphResource> reads;
+        FrameGraphResource output;
+        bool sideEffect;
+        bool culled;
+    };
+    
+    // Physical texture shared by transients of the same size
+    struct Slot {
+        int width, height;
+        int freeAfter; // Last compiled position using it
+    };
+    
+    struct PooledTarget {
+        std::unique_ptr<RenderTarget> target;
+        bool inUse;
+        int idleFrames;
+    };
+    
+    static constexpr int POOL_IDLE_FRAMES = 60; // Unused pooled targets are freed after this many frames
+    
+    GraphicsAPI* graphics;
+    GpuResources* gpuResources;
+    std::vector<Resource> resources;
+    std::vector<Pass> passes;
+    std::vector<int> order;   // Compiled pass order, culled passes excluded
+    std::vector<Slot> slots;
+    std::vector<PooledTarget> pool;
+    bool compiled;
+    int windowWidth, windowHeight;
+    
+    // Ordering: Kahn's algorithm, ties broken by declaration order
+    bool sortPasses();
+    
+    // Give each transient a slot free at its first use
+    void assignSlots();
+    
+    // Take a pooled target of the slot's size, creating one if none is free
+    RenderTarget* acquireTarget(int width, int height);
+};
\ No newline at end of file
@@ -0,0 +1,229 @@
+#include "frame_recorder.h"
+#include "../core/image_writer.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+FrameRecorder::FrameRecorder(GraphicsAPI* graphics, GpuResources* resources)
+    : graphics(graphics), resources(resources), width(0), height(0), recording(false), async(false), nextSlot(0), frameIndex(0),
+      capturedFrames(0), droppedFrames(0), totalOverheadMs(0.0), maxOverheadMs(0.0), overheadSamples(0),
+      stopping(false), writeFailed(false) {
+}
+
+FrameRecorder::~FrameRecorder() {
+    stop();
+}
+
+bool FrameRecorder::start(const std::string& outputPrefix, int frameWidth, int frameHeight, const FrameRecorderSettings& recorderSettings) {
+    stop();
+    
+    prefix = outputPrefix;
+    width = frameWidth;
+    height = frameHeight;
+    settings = recorderSettings;
+    settings.latency = std::max(1, settings.latency);
+    settings.fallbackInterval = std::max(1, settings.fallbackInterval);
+    settings.maxQueuedFrames = std::max(1, settings.maxQueuedFrames);
+    
+    if (!settings.png) {
+        std::string path = prefix + ".rgba";
+        rawStream.open(path, std::ios::binary | std::ios::trunc);
+        std::string indexPath = prefix + ".frames";
+        rawIndex.open(indexPath, std::ios::trunc);
+        if (!rawStream.is_open() || !rawIndex.is_open()) {
+            printf("Failed to create recording: %s\n", rawStream.is_open() ? indexPath.c_str() : path.c_str());
+            rawStream.close();
+            rawIndex.close();
+            return false;
+        }
+    }
+    
+    // One pixel buffer per frame in flight
+    async = graphics->supportsAsyncReadback();
+    size_t frameBytes = (size_t)width * height * 4;
+    if (async) {
+        slots.assign(settings.latency, Slot());
+        for (Slot& slot : slots) {
+            slot.buffer = resources->createPixelBuffer(frameBytes);
+        }
+    }
+    
+    // Touch the buffers for one frame being encoded while the next is fetched
+    // now, so the first recorded frames don't pay for fresh pages
+    freeBuffers.assign(2, std::vector<uint8_t>(frameBytes));
+    
+    nextSlot = 0;
+    frameIndex = 0;
+    capturedFrames = 0;
+    droppedFrames = 0;
+    totalOverheadMs = 0.0;
+    maxOverheadMs = 0.0;
+    overheadSamples = 0;
+    stopping = false;
+    writeFailed = false;
+    recording = true;
+#ifndef ENDJINN_JOBS_INLINE
+    encoder = std::thread(&FrameRecorder::encoderLoop, this);
+#endif
+
+    if (async) {
+        printf("Recording %dx%d frames to %s (%s), read back %d frames late\n", width, height, prefix.c_str(),
+               settings.png ? "png" : "raw", settings.latency);
+    } else {
+        printf("Recording %dx%d frames to %s (%s), every %d frames without async readback\n", width, height, prefix.c_str(),
+               settings.png ? "png" : "raw", settings.fallbackInterval);
+    }
+    return true;
+}
+
+void FrameRecorder::stop() {
+    if (!recording) {
+        return;
+    }
+    
+    // Oldest first; mapping waits for copies the GPU hasn't finished
+    for (size_t i = 0; i < slots.size(); i++) {
+        Slot& slot = slots[(nextSlot + i) % slots.size()];
+        if (slot.pending) {
+            fetchSlot(slot);
+        }
+        resources->destroy(slot.buffer);
+    }
+    slots.clear();
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+#ifndef ENDJINN_JOBS_INLINE
+    encoder.join();
+#endif
+    queue.clear();
+    freeBuffers.clear();
+    if (rawStream.is_open()) {
+        rawStream.close();
+        rawIndex.close();
+    }
+    recording = false;
+    
+    printf("Recorded %llu frames (%llu dropped) to %s, capture overhead %.3f ms/frame average, %.3f ms max%s\n",
+           (unsigned long long)capturedFrames, (unsigned long long)droppedFrames, prefix.c_str(), getAverageOverheadMs(),
+           maxOverheadMs, writeFailed ? ", some frames failed to write" : "");
+}
+
+void FrameRecorder::captureFrame() {
+    if (!recording) {
+        return;
+    }
+    auto start = std::chrono::steady_clock::now();
+    
+    if (async) {
+        // The oldest slot was filled latency frames ago; if even that copy isn't done the
+        // GPU is too far behind, so this frame is skipped instead of waited for
+        Slot& slot = slots[nextSlot];
+        if (slot.pending && graphics->isFenceSignaled(slot.fence)) {
+            fetchSlot(slot);
+        }
+        if (slot.pending) {
+            droppedFrames++;
+        } else {
+            graphics->readPixelsToBuffer(resources->get(slot.buffer), 0, 0, width, height);
+            slot.fence = graphics->createFence();
+            slot.pending = true;
+            slot.frame = frameIndex;
+            nextSlot = (nextSlot + 1) % slots.size();
+        }
+    } else if (frameIndex % settings.fallbackInterval == 0) {
+        std::vector<uint8_t> pixels = acquireBuffer();
+        graphics->readPixels(0, 0, width, height, pixels.data());
+        enqueue(frameIndex, std::move(pixels));
+    }
+    frameIndex++;
+    
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    totalOverheadMs += ms;
+    maxOverheadMs = std::max(maxOverheadMs, ms);
+    overheadSamples++;
+}
+
+std::vector<uint8_t> FrameRecorder::acquireBuffer() {
+    std::vector<uint8_t> buffer;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!freeBuffers.empty()) {
+            buffer = std::move(freeBuffers.back());
+            freeBuffers.pop_back();
+        }
+    }
+    buffer.resize((size_t)width * height * 4);
+    return buffer;
+}
+
+void FrameRecorder::fetchSlot(Slot& slot) {
+    std::vector<uint8_t> pixels = acquireBuffer();
+    bool fetched = graphics->getPixelBufferData(resources->get(slot.buffer), pixels.size(), pixels.data());
+    graphics->deleteFence(slot.fence);
+    slot.fence = nullptr;
+    slot.pending = false;
+    if (fetched) {
+        enqueue(slot.frame, std::move(pixels));
+    } else {
+        droppedFrames++;
+    }
+}
+
+void FrameRecorder::enqueue(uint64_t frame, std::vector<uint8_t> pixels) {
+#ifdef ENDJINN_JOBS_INLINE
+    // No threads: encode on the caller
+    EncodeJob job = {frame, std::move(pixels)};
+    encode(job);
+    capturedFrames++;
+    freeBuffers.push_back(std::move(job.pixels));
+#else
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if ((int)queue.size() >= settings.maxQueuedFrames) {
+            droppedFrames++;
+            freeBuffers.push_back(std::move(pixels));
+            return;
+        }
+        queue.push_back(EncodeJob{frame, std::move(pixels)});
+    }
+    capturedFrames++;
+    wake.notify_one();
+#endif
+}
+
+void FrameRecorder::encoderLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        wake.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (queue.empty()) {
+            return; // Stopping with everything written
+        }
+        
+        EncodeJob job = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+        encode(job);
+        lock.lock();
+        freeBuffers.push_back(std::move(job.pixels));
+    }
+}
+
+void FrameRecorder::encode(EncodeJob& job) {
+    bool written;
+    if (settings.png) {
+        char suffix[32];
+        snprintf(suffix, sizeof(suffix), "_%06llu.png", (unsigned long long)job.frame);
+        written = writeImage(prefix + suffix, width, height, job.pixels.data(), true);
+    } else {
+        rawStream.write(reinterpret_cast<const char*>(job.pixels.data()), job.pixels.size());
+        rawIndex << job.frame << '\n';
+        written = rawStream && rawIndex;
+    }
+    if (!written) {
+        writeFailed = true;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "graphics_api.h"
+#include "gpu_resources.h"
+#include "../core/job_system.h"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct FrameRecorderSettings {
+    int latency = 3;          // Frames between a readback and fetching its pixels (pixel buffers in the ring)
+    int fallbackInterval = 4; // Without async readback only every Nth frame is read, synchronously
+    bool png = true;          // PNG sequence, or one raw RGBA stream (rows bottom-up, as read)
+    int maxQueuedFrames = 8;  // Frames waiting for the encoder before new ones are dropped
+};
+
+// Records the window's frames without stalling the GPU. Each frame is copied into
+// one of a ring of pixel buffers and fenced; its pixels are fetched a few frames
+// later, once the fence has signaled, and handed to an encoder thread that
+// writes them to disk. Backends without async readback (ES 2.0) fall back to a
+// throttled synchronous read. Frames are dropped rather than waited for when the
+// GPU or the encoder falls behind.
+class FrameRecorder {
+public:
+    FrameRecorder(GraphicsAPI* graphics, GpuResources* resources);
+    ~FrameRecorder();
+    
+    FrameRecorder(const FrameRecorder&) = delete;
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+    
+    // Record width x height frames to <prefix>_<frame>.png, or <prefix>.rgba when raw;
+    // a raw recording lists the frame number of each stored frame in <prefix>.frames
+    bool start(const std::string& prefix, int width, int height, const FrameRecorderSettings& settings = FrameRecorderSettings());
+    
+    // Fetch the frames still in flight, wait for the encoder and print a summary
+    void stop();
+    
+    bool isRecording() const { return recording; }
+    
+    // Queue a readback of the window framebuffer; call once the frame is drawn, before the swap
+    void captureFrame();
+    
+    // CPU time captureFrame adds to a frame
+    double getAverageOverheadMs() const { return overheadSamples ? totalOverheadMs / overheadSamples : 0.0; }
+    double getMaxOverheadMs() const { return maxOverheadMs; }
+    
+    uint64_t getCapturedFrames() const { return capturedFrames; }
+    uint64_t getDroppedFrames() const { return droppedFrames; }
+
+private:
+    struct Slot {
+        BufferHandle buffer;
+        GLsync fence = nullptr;
+        bool pending = false;
+        uint64_t frame = 0;
+    };
+    
+    struct EncodeJob {
+        uint64_t frame;
+        std::vector<uint8_t> pixels;
+    };
+    
+    GraphicsAPI* graphics;
+    GpuResources* resources;
+    FrameRecorderSettings settings;
+    std::string prefix;
+    int width, height;
+    bool recording;
+    bool async;
+    std::vector<Slot> slots;
+    size_t nextSlot;
+    uint64_t frameIndex;
+    uint64_t capturedFrames;
+    uint64_t droppedFrames;
+    double totalOverheadMs;
+    double maxOverheadMs;
+    uint64_t overheadSamples;
+    
+    // Encoder state, shared with the encoder thread under mutex
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<EncodeJob> queue;
+    std::vector<std::vector<uint8_t>> freeBuffers; // Recycled frame buffers
+    bool stopping;
+    bool writeFailed;
+    std::ofstream rawStream;
+    std::ofstream rawIndex; // One frame number per line, so drops show as gaps
+#ifndef ENDJINN_JOBS_INLINE
+    std::thread encoder;
+#endif
+
+    // A frame-sized buffer, recycled when possible
+    std::vector<uint8_t> acquireBuffer();
+    
+    // Copy a slot's pixels out and queue them; the slot becomes free
+    void fetchSlot(Slot& slot);
+    
+    // Hand pixels to the encoder, or drop them when it is too far behind
+    void enqueue(uint64_t frame, std::vector<uint8_t> pixels);
+    
+    void encoderLoop();
+    void encode(EncodeJob& job);
+};
\ No newline at end of file
@@ -0,0 +1,216 @@
+#include "gpu_resources.h"
+#include <iostream>
+
+static const char* getResourceTypeName(GpuResourceType type) {
+    switch (type) {
+        case GpuResourceType::Texture: return "textures";
+        case GpuResourceType::Buffer: return "buffers";
+        case GpuResourceType::Framebuffer: return "framebuffers";
+        default: return "unknown";
+    }
+}
+
+GpuResources::GpuResources(GraphicsAPI* graphics) : graphics(graphics), liveBytes(), frameIndex(0) {
+}
+
+GpuResources::~GpuResources() {
+    cleanup();
+}
+
+TextureHandle GpuResources::createTexture() {
+    return textures.insert(Resource{graphics->createTexture(), 0});
+}
+
+BufferHandle GpuResources::createBuffer() {
+    return buffers.insert(Resource{graphics->createBuffer(), 0});
+}
+
+FramebufferHandle GpuResources::createFramebuffer() {
+    return framebuffers.insert(Resource{graphics->createFramebuffer(), 0});
+}
+
+BufferHandle GpuResources::createPixelBuffer(size_t bytes) {
+    liveBytes[(size_t)GpuResourceType::Buffer] += bytes;
+    return buffers.insert(Resource{graphics->createPixelBuffer(bytes), bytes});
+}
+
+GLuint GpuResources::get(TextureHandle handle) const {
+    const Resource* resource = textures.get(handle);
+    return resource ? resource->id : 0;
+}
+
+GLuint GpuResources::get(BufferHandle handle) const {
+    const Resource* resource = buffers.get(handle);
+    return resource ? resource->id : 0;
+}
+
+GLuint GpuResources::get(FramebufferHandle handle) const {
+    const Resource* resource = framebuffers.get(handle);
+    return resource ? resource->id : 0;
+}
+
+void GpuResources::setSize(TextureHandle handle, size_t bytes) {
+    Resource* resource = textures.get(handle);
+    if (resource) {
+        liveBytes[(size_t)GpuResourceType::Texture] += bytes - resource->bytes;
+        resource->bytes = bytes;
+    }
+}
+
+void GpuResources::setSize(BufferHandle handle, size_t bytes) {
+    Resource* resource = buffers.get(handle);
+    if (resource) {
+        liveBytes[(size_t)GpuResourceType::Buffer] += bytes - resource->bytes;
+        resource->bytes = bytes;
+    }
+}
+
+size_t GpuResources::getTextureBytes(int width, int height) {
+    return (size_t)width * height * 4;
+}
+
+void GpuResources::destroy(TextureHandle& handle) {
+    const Resource* resource = textures.get(handle);
+    if (resource) {
+        release(GpuResourceType::Texture, *resource);
+        textures.remove(handle);
+    }
+    handle = TextureHandle();
+}
+
+void GpuResources::destroy(BufferHandle& handle) {
+    const Resource* resource = buffers.get(handle);
+    if (resource) {
+        release(GpuResourceType::Buffer, *resource);
+        buffers.remove(handle);
+    }
+    handle = BufferHandle();
+}
+
+void GpuResources::destroy(FramebufferHandle& handle) {
+    const Resource* resource = framebuffers.get(handle);
+    if (resource) {
+        release(GpuResourceType::Framebuffer, *resource);
+        framebuffers.remove(handle);
+    }
+    handle = FramebufferHandle();
+}
+
+void GpuResources::endFrame() {
+    if (!frameReleases.empty()) {
+        PendingFrame frame;
+        frame.frame = frameIndex;
+        frame.fence = graphics->createFence();
+        frame.releases.swap(frameReleases);
+        pending.push_back(std::move(frame));
+    }
+    frameIndex++;
+    
+    // Frames finish in order, so stop at the first one the GPU may still be on
+    while (!pending.empty()) {
+        PendingFrame& frame = pending.front();
+        bool finished = frame.fence ? graphics->isFenceSignaled(frame.fence) : frameIndex - frame.frame > FRAMES_IN_FLIGHT;
+        if (!finished) {
+            break;
+        }
+        deletePending(frame);
+        pending.pop_front();
+    }
+}
+
+GpuMemoryStats GpuResources::getStats() const {
+    GpuMemoryStats stats;
+    const Resource* values[] = {textures.data(), buffers.data(), framebuffers.data()};
+    size_t counts[] = {textures.size(), buffers.size(), framebuffers.size()};
+    for (size_t type = 0; type < (size_t)GpuResourceType::Count; type++) {
+        GpuMemoryUsage& usage = stats.live[type];
+        usage.count = counts[type];
+        for (size_t i = 0; i < counts[type]; i++) {
+            usage.bytes += values[type][i].bytes;
+        }
+        stats.totalBytes += usage.bytes;
+    }
+    
+    for (const Release& release : frameReleases) {
+        stats.pending.count++;
+        stats.pending.bytes += release.bytes;
+    }
+    for (const PendingFrame& frame : pending) {
+        for (const Release& release : frame.releases) {
+            stats.pending.count++;
+            stats.pending.bytes += release.bytes;
+        }
+    }
+    stats.totalBytes += stats.pending.bytes;
+    return stats;
+}
+
+void GpuResources::printReport() const {
+    GpuMemoryStats stats = getStats();
+    printf("GPU memory (estimated): %.2f MB\n", stats.totalBytes / (1024.0 * 1024.0));
+    for (size_t type = 0; type < (size_t)GpuResourceType::Count; type++) {
+        printf("  %-14s %6zu  %10.2f KB\n", getResourceTypeName((GpuResourceType)type), stats.live[type].count,
+               stats.live[type].bytes / 1024.0);
+    }
+    printf("  %-14s %6zu  %10.2f KB\n", "pending delete", stats.pending.count, stats.pending.bytes / 1024.0);
+}
+
+void GpuResources::cleanup() {
+    if (!graphics) {
+        return;
+    }
+    for (PendingFrame& frame : pending) {
+        deletePending(frame);
+    }
+    pending.clear();
+    for (const Release& release : frameReleases) {
+        deleteObject(release);
+    }
+    frameReleases.clear();
+    
+    // Live objects belong to owners that didn't clean up; drop them with everything else
+    const Resource* values[] = {textures.data(), buffers.data(), framebuffers.data()};
+    size_t counts[] = {textures.size(), buffers.size(), framebuffers.size()};
+    for (size_t type = 0; type < (size_t)GpuResourceType::Count; type++) {
+        for (size_t i = 0; i < counts[type]; i++) {
+            deleteObject(Release{(GpuResourceType)type, values[type][i].id, values[type][i].bytes});
+        }
+    }
+    textures = SlotMap<Resource, TextureHandle>();
+    buffers = SlotMap<Resource, BufferHandle>();
+    framebuffers = SlotMap<Resource, FramebufferHandle>();
+    for (size_t& bytes : liveBytes) {
+        bytes = 0;
+    }
+    graphics = nullptr;
+}
+
+void GpuResources::release(GpuResourceType type, const Resource& resource) {
+    liveBytes[(size_t)type] -= resource.bytes;
+    frameReleases.push_back(Release{type, resource.id, resource.bytes});
+}
+
+void GpuResources::deleteObject(const Release& release) {
+    switch (release.type) {
+        case GpuResourceType::Texture:
+            graphics->deleteTexture(release.id);
+            break;
+        case GpuResourceType::Buffer:
+            graphics->deleteBuffer(release.id);
+            break;
+        case GpuResourceType::Framebuffer:
+            graphics->deleteFramebuffer(release.id);
+            break;
+        default:
+            break;
+    }
+}
+
+void GpuResources::deletePending(PendingFrame& frame) {
+    for (const Release& release : frame.releases) {
+        deleteObject(release);
+    }
+    if (frame.fence) {
+        graphics->deleteFence(frame.fence);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "graphics_api.h"
+#include "slot_map.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+struct TextureTag;
+struct BufferTag;
+struct FramebufferTag;
+typedef ResourceHandle<TextureTag> TextureHandle;
+typedef ResourceHandle<BufferTag> BufferHandle;
+typedef ResourceHandle<FramebufferTag> FramebufferHandle;
+
+enum class GpuResourceType {
+    Texture,
+    Buffer,
+    Framebuffer,
+    Count
+};
+
+// Live objects of one type and their estimated size
+struct GpuMemoryUsage {
+    size_t count = 0;
+    size_t bytes = 0;
+};
+
+struct GpuMemoryStats {
+    GpuMemoryUsage live[(size_t)GpuResourceType::Count];
+    GpuMemoryUsage pending; // Released, waiting for the GPU to finish with them
+    size_t totalBytes = 0;  // Live and pending
+};
+
+// Owns GL textures, buffers and framebuffers behind generation-checked handles.
+// A handle goes stale the moment it is destroyed, but the GL object is only
+// deleted once the GPU has finished the frames that may still use it: the
+// releases of each frame are fenced at endFrame, or held for FRAMES_IN_FLIGHT
+// frames on backends without fences. Sizes are estimates the owners report
+// after uploading, which is enough for a live memory report.
+class GpuResources {
+public:
+    static constexpr uint64_t FRAMES_IN_FLIGHT = 3;
+    
+    explicit GpuResources(GraphicsAPI* graphics);
+    ~GpuResources();
+    
+    GpuResources(const GpuResources&) = delete;
+    GpuResources& operator=(const GpuResources&) = delete;
+    
+    TextureHandle createTexture();
+    BufferHandle createBuffer();
+    FramebufferHandle createFramebuffer();
+    
+    // Pixel pack buffer with bytes of storage, for async readback
+    BufferHandle createPixelBuffer(size_t bytes);
+    
+    // The GL object, or 0 for a null or stale handle
+    GLuint get(TextureHandle handle) const;
+    GLuint get(BufferHandle handle) const;
+    GLuint get(FramebufferHandle handle) const;
+    
+    // Record an object's size after allocating its storage
+    void setSize(TextureHandle handle, size_t bytes);
+    void setSize(BufferHandle handle, size_t bytes);
+    
+    // Bytes of a width x height RGBA8 texture, the only format the renderers use
+    static size_t getTextureBytes(int width, int height);
+    
+    // Release the object and reset the handle; stale and null handles are ignored
+    void destroy(TextureHandle& handle);
+    void destroy(BufferHandle& handle);
+    void destroy(FramebufferHandle& handle);
+    
+    // Once per frame, after the swap: fence this frame's releases and delete the
+    // objects of frames the GPU has finished. Never waits.
+    void endFrame();
+    
+    // Estimated bytes of live objects of one type, kept current without a walk
+    size_t getLiveBytes(GpuResourceType type) const { return liveBytes[(size_t)type]; }
+    
+    GpuMemoryStats getStats() const;
+    void printReport() const;
+    
+    // Delete everything now; the caller makes sure the GPU is idle (shutdown)
+    void cleanup();
+
+private:
+    struct Resource {
+        GLuint id;
+        size_t bytes;
+    };
+    
+    struct Release {
+        GpuResourceType type;
+        GLuint id;
+        size_t bytes;
+    };
+    
+    struct PendingFrame {
+        uint64_t frame;
+        GLsync fence; // nullptr without fence support
+        std::vector<Release> releases;
+    };
+    
+    GraphicsAPI* graphics;
+    SlotMap<Resource, TextureHandle> textures;
+    SlotMap<Resource, BufferHandle> buffers;
+    SlotMap<Resource, FramebufferHandle> framebuffers;
+    std::vector<Release> frameReleases; // Released since the last endFrame
+    std::deque<PendingFrame> pending;
+    size_t liveBytes[(size_t)GpuResourceType::Count];
+    uint64_t frameIndex;
+    
+    void release(GpuResourceType type, const Resource& resource);
+    void deleteObject(const Release& release);
+    void deletePending(PendingFrame& frame);
+};
\ No newline at end of file
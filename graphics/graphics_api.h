@@ -1,50 +1,65 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 // OpenGL types - platform independent
 typedef unsigned int GLenum;
 typedef unsigned int GLuint;
 typedef int GLint;
 typedef float GLfloat;
+typedef struct __GLsync* GLsync;
 
 // OpenGL constants - platform independent
 #define GL_VERTEX_SHADER                  0x8B31
 #define GL_FRAGMENT_SHADER                0x8B30
 #define GL_COLOR_BUFFER_BIT               0x00004000
 #define GL_BLEND                          0x0BE2
+#define GL_SCISSOR_TEST                   0x0C11
+#define GL_ZERO                           0
+#define GL_ONE                            1
 #define GL_SRC_ALPHA                      0x0302
 #define GL_ONE_MINUS_SRC_ALPHA            0x0303
 #define GL_TEXTURE_2D                     0x0DE1
 #define GL_RGBA                           0x1908
 #define GL_UNSIGNED_BYTE                  0x1401
+#define GL_UNSIGNED_SHORT                 0x1403
+#define GL_UNSIGNED_INT                   0x1405
 #define GL_TEXTURE_MIN_FILTER             0x2801
 #define GL_TEXTURE_MAG_FILTER             0x2800
 #define GL_TEXTURE_WRAP_S                 0x2802
 #define GL_TEXTURE_WRAP_T                 0x2803
+#define GL_NEAREST                        0x2600
 #define GL_LINEAR                         0x2601
 #define GL_CLAMP_TO_EDGE                  0x812F
 #define GL_ARRAY_BUFFER                   0x8892
+#define GL_ELEMENT_ARRAY_BUFFER           0x8893
 #define GL_DYNAMIC_DRAW                   0x88E8
+#define GL_STATIC_DRAW                    0x88E4
 #define GL_TRIANGLES                      0x0004
 #define GL_FLOAT                          0x1406
 #define GL_FALSE                          0
 #define GL_TEXTURE0                       0x84C0
+#define GL_FRAMEBUFFER                    0x8D40
+#define GL_COLOR_ATTACHMENT0              0x8CE0
+#define GL_FRAMEBUFFER_COMPLETE           0x8CD5
 
 class GraphicsAPI {
 public:
     virtual ~GraphicsAPI() = default;
     
     // Shader operations
-    virtual GLuint compileShader(GLenum type, const std::string& source) = 0;
+    virtual GLuint compileShader(GLenum type, std::string_view source) = 0;
     virtual GLuint createProgram(GLuint vertexShader, GLuint fragmentShader) = 0;
     virtual void useProgram(GLuint program) = 0;
     virtual void deleteProgram(GLuint program) = 0;
     
     // Uniform operations
     virtual void setUniform1f(GLuint program, const std::string& name, float value) = 0;
+    virtual void setUniform2f(GLuint program, const std::string& name, float x, float y) = 0;
     virtual void setUniform3f(GLuint program, const std::string& name, float x, float y, float z) = 0;
     virtual void setUniform1i(GLuint program, const std::string& name, int value) = 0;
+    virtual void setUniformMatrix4fv(GLuint program, const std::string& name, const float* value) = 0; // Column-major
     
     // Buffer operations
     virtual GLuint createBuffer() = 0;
@@ -57,10 +72,20 @@ public:
     virtual void bindTexture(GLenum target, GLuint texture) = 0;
     virtual void texImage2D(GLenum target, GLint level, GLint internalFormat, 
                            int width, int height, GLenum format, GLenum type, const void* data) = 0;
+    virtual void texSubImage2D(GLenum target, GLint level, int x, int y,
+                              int width, int height, GLenum format, GLenum type, const void* data) = 0;
     virtual void texParameteri(GLenum target, GLenum pname, GLint param) = 0;
     virtual void deleteTexture(GLuint texture) = 0;
     virtual void activeTexture(GLenum texture) = 0;
     
+    // Framebuffer operations; framebuffer 0 is the window
+    virtual GLuint createFramebuffer() = 0;
+    virtual void bindFramebuffer(GLuint framebuffer) = 0;
+    virtual void framebufferTexture2D(GLuint texture) = 0; // Color attachment of the bound framebuffer
+    virtual bool isFramebufferComplete() = 0;
+    virtual void deleteFramebuffer(GLuint framebuffer) = 0;
+    virtual void viewport(int x, int y, int width, int height) = 0;
+    
     // Vertex array operations (abstracted for ES compatibility)
     virtual void setupVertexArray(GLuint program, GLuint buffer) = 0;
     virtual void enableVertexAttribute(GLuint program, const std::string& name, 
@@ -69,16 +94,35 @@ public:
     
     // Drawing
     virtual void drawArrays(GLenum mode, GLint first, int count) = 0;
+    virtual void drawElements(GLenum mode, int count, GLenum type, size_t offset) = 0; // Offset into bound index buffer
     
     // State management
     virtual void enable(GLenum cap) = 0;
+    virtual void disable(GLenum cap) = 0;
+    virtual void scissor(int x, int y, int width, int height) = 0; // Framebuffer pixels, bottom-left origin
     virtual void blendFunc(GLenum sfactor, GLenum dfactor) = 0;
+    virtual void blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) = 0;
     virtual void clearColor(float r, float g, float b, float a) = 0;
     virtual void clear(GLuint mask) = 0;
     
+    // Readback of the bound framebuffer as RGBA8, bottom row first. readPixels
+    // waits for every queued command to finish, so it stalls the pipeline.
+    virtual void readPixels(int x, int y, int width, int height, void* pixels) = 0;
+    
+    // Asynchronous readback: copy into a pixel buffer, fence the copy and fetch the
+    // data once the fence has signaled. Without support these do nothing.
+    virtual bool supportsAsyncReadback() const = 0;
+    virtual GLuint createPixelBuffer(size_t size) = 0; // Freed with deleteBuffer
+    virtual void readPixelsToBuffer(GLuint buffer, int x, int y, int width, int height) = 0;
+    virtual bool getPixelBufferData(GLuint buffer, size_t size, void* data) = 0;
+    virtual GLsync createFence() = 0;
+    virtual bool isFenceSignaled(GLsync fence) = 0; // Never blocks
+    virtual void deleteFence(GLsync fence) = 0;
+    
     // Platform info
     virtual std::string getRendererName() const = 0;
     virtual bool supportsVertexArrays() const = 0;
+    virtual bool supportsUint32Indices() const = 0;
     
     // Shader path resolution
     virtual std::string getVertexShaderPath(const std::string& baseName) const = 0;
@@ -0,0 +1,604 @@
+#include "graphics_capture.h"
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+
+const char* getCaptureOpName(CaptureOp op) {
+    static const char* const names[] = {
+        "defineName", "compileShader", "createProgram", "useProgram", "deleteProgram",
+        "setUniform1f", "setUniform2f", "setUniform3f", "setUniform1i", "setUniformMatrix4fv",
+        "createBuffer", "bindBuffer", "bufferData", "deleteBuffer",
+        "createTexture", "bindTexture", "texImage2D", "texSubImage2D", "texParameteri", "deleteTexture", "activeTexture",
+        "createFramebuffer", "bindFramebuffer", "framebufferTexture2D", "isFramebufferComplete", "deleteFramebuffer", "viewport",
+        "setupVertexArray", "enableVertexAttribute", "disableVertexAttribute",
+        "drawArrays", "drawElements",
+        "enable", "disable", "scissor", "blendFunc", "blendFuncSeparate", "clearColor", "clear",
+        "windowSize", "endFrame", "endOfCapture"
+    };
+    static_assert(sizeof(names) / sizeof(names[0]) == (size_t)CaptureOp::Count, "one name per op");
+    return op < CaptureOp::Count ? names[(size_t)op] : "unknown";
+}
+
+size_t getTextureDataSize(int width, int height, GLenum format, GLenum type) {
+    (void)format;
+    (void)type;
+    return width > 0 && height > 0 ? (size_t)width * height * 4 : 0;
+}
+
+GraphicsCapture::GraphicsCapture(std::unique_ptr<GraphicsAPI> backend, int windowWidth, int windowHeight)
+    : backend(std::move(backend)), windowWidth(windowWidth), windowHeight(windowHeight),
+      capturing(false), frameLimit(0), frameCount(0), bytesWritten(0) {
+}
+
+GraphicsCapture::~GraphicsCapture() {
+    stop();
+}
+
+bool GraphicsCapture::start(const std::string& capturePath, int frames) {
+    stop();
+    
+    file.open(capturePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        printf("Failed to create capture: %s\n", capturePath.c_str());
+        return false;
+    }
+    
+    // Frame count is patched in by stop()
+    CaptureHeader header = {};
+    memcpy(header.magic, CAPTURE_MAGIC, sizeof(header.magic));
+    header.version = CAPTURE_VERSION;
+    header.windowWidth = (uint32_t)windowWidth;
+    header.windowHeight = (uint32_t)windowHeight;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    
+    path = capturePath;
+    names.clear();
+    pending.clear();
+    capturing = true;
+    frameLimit = frames;
+    frameCount = 0;
+    bytesWritten = sizeof(header);
+    printf("Capturing graphics calls to %s\n", path.c_str());
+    return true;
+}
+
+void GraphicsCapture::stop() {
+    if (!capturing) {
+        return;
+    }
+    writeOp(CaptureOp::EndOfCapture);
+    flush();
+    capturing = false;
+    
+    uint32_t frames = (uint32_t)frameCount;
+    file.seekp(offsetof(CaptureHeader, frameCount));
+    file.write(reinterpret_cast<const char*>(&frames), sizeof(frames));
+    file.close();
+    if (!file) {
+        printf("Failed to write capture: %s\n", path.c_str());
+        return;
+    }
+    printf("Captured %d frames to %s (%.1f MB)\n", frameCount, path.c_str(), bytesWritten / (1024.0 * 1024.0));
+}
+
+void GraphicsCapture::endFrame() {
+    if (!capturing) {
+        return;
+    }
+    writeOp(CaptureOp::EndFrame);
+    frameCount++;
+    flush();
+    if (frameLimit > 0 && frameCount >= frameLimit) {
+        stop();
+    }
+}
+
+void GraphicsCapture::setWindowSize(int width, int height) {
+    windowWidth = width;
+    windowHeight = height;
+    if (capturing) {
+        writeOp(CaptureOp::WindowSize);
+        writeU32((uint32_t)width);
+        writeU32((uint32_t)height);
+    }
+}
+
+void GraphicsCapture::writeOp(CaptureOp op) {
+    pending.push_back((uint8_t)op);
+}
+
+void GraphicsCapture::writeU32(uint32_t value) {
+    uint8_t bytes[4] = {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+    pending.insert(pending.end(), bytes, bytes + 4);
+}
+
+void GraphicsCapture::writeFloat(float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    writeU32(bits);
+}
+
+void GraphicsCapture::writePayload(const void* data, size_t size) {
+    writeU32((uint32_t)size);
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    pending.insert(pending.end(), bytes, bytes + size);
+}
+
+uint32_t GraphicsCapture::internName(const std::string& name) {
+    auto it = names.find(name);
+    if (it != names.end()) {
+        return it->second;
+    }
+    
+    uint32_t id = (uint32_t)names.size();
+    names[name] = id;
+    writeOp(CaptureOp::DefineName);
+    writeU32(id);
+    writePayload(name.data(), name.size());
+    return id;
+}
+
+void GraphicsCapture::flush() {
+    file.write(reinterpret_cast<const char*>(pending.data()), pending.size());
+    bytesWritten += pending.size();
+    pending.clear();
+}
+
+// Shaders
+
+GLuint GraphicsCapture::compileShader(GLenum type, std::string_view source) {
+    GLuint shader = backend->compileShader(type, source);
+    if (capturing) {
+        writeOp(CaptureOp::CompileShader);
+        writeU32(type);
+        writeU32(shader);
+        writePayload(source.data(), source.size());
+    }
+    return shader;
+}
+
+GLuint GraphicsCapture::createProgram(GLuint vertexShader, GLuint fragmentShader) {
+    GLuint program = backend->createProgram(vertexShader, fragmentShader);
+    if (capturing) {
+        writeOp(CaptureOp::CreateProgram);
+        writeU32(vertexShader);
+        writeU32(fragmentShader);
+        writeU32(program);
+    }
+    return program;
+}
+
+void GraphicsCapture::useProgram(GLuint program) {
+    backend->useProgram(program);
+    if (capturing) {
+        writeOp(CaptureOp::UseProgram);
+        writeU32(program);
+    }
+}
+
+void GraphicsCapture::deleteProgram(GLuint program) {
+    backend->deleteProgram(program);
+    if (capturing) {
+        writeOp(CaptureOp::DeleteProgram);
+        writeU32(program);
+    }
+}
+
+// Uniforms
+
+void GraphicsCapture::setUniform1f(GLuint program, const std::string& name, float value) {
+    backend->setUniform1f(program, name, value);
+    if (capturing) {
+        uint32_t id = internName(name);
+        writeOp(CaptureOp::SetUniform1f);
+        writeU32(program);
+        writeU32(id);
+        writeFloat(value);
+    }
+}
+
+void GraphicsCapture::setUniform2f(GLuint program, const std::string& name, float x, float y) {
+    backend->setUniform2f(program, name, x, y);
+    if (capturing) {
+        uint32_t id = internName(name);
+        writeOp(CaptureOp::SetUniform2f);
+        writeU32(program);
+        writeU32(id);
+        writeFloat(x);
+        writeFloat(y);
+    }
+}
+
+void GraphicsCapture::setUniform3f(GLuint program, const std::string& name, float x, float y, float z) {
+    backend->setUniform3f(program, name, x, y, z);
+    if (capturing) {
+        uint32_t id = internName(name);
+        writeOp(CaptureOp::SetUniform3f);
+        writeU32(program);
+        writeU32(id);
+        writeFloat(x);
+        writeFloat(y);
+        writeFloat(z);
+    }
+}
+
+void GraphicsCapture::setUniform1i(GLuint program, const std::string& name, int value) {
+    backend->setUniform1i(program, name, value);
+    if (capturing) {
+        uint32_t id = internName(name);
+        writeOp(CaptureOp::SetUniform1i);
+        writeU32(program);
+        writeU32(id);
+        writeU32((uint32_t)value);
+    }
+}
+
+void GraphicsCapture::setUniformMatrix4fv(GLuint program, const std::string& name, const float* value) {
+    backend->setUniformMatrix4fv(program, name, value);
+    if (capturing) {
+        uint32_t id = internName(name);
+        writeOp(CaptureOp::SetUniformMatrix4fv);
+        writeU32(program);
+        writeU32(id);
+        for (int i = 0; i < 16; i++) {
+            writeFloat(value[i]);
+        }
+    }
+}
+
+// Buffers
+
+GLuint GraphicsCapture::createBuffer() {
+    GLuint buffer = backend->createBuffer();
+    if (capturing) {
+        writeOp(CaptureOp::CreateBuffer);
+        writeU32(buffer);
+    }
+    return buffer;
+}
+
+void GraphicsCapture::bindBuffer(GLenum target, GLuint buffer) {
+    backend->bindBuffer(target, buffer);
+    if (capturing) {
+        writeOp(CaptureOp::BindBuffer);
+        writeU32(target);
+        writeU32(buffer);
+    }
+}
+
+void GraphicsCapture::bufferData(GLenum target, size_t size, const void* data, GLenum usage) {
+    backend->bufferData(target, size, data, usage);
+    if (capturing) {
+        // Allocation without data is a size and an empty payload
+        writeOp(CaptureOp::BufferData);
+        writeU32(target);
+        writeU32(usage);
+        writeU32((uint32_t)size);
+        writePayload(data, data ? size : 0);
+    }
+}
+
+void GraphicsCapture::deleteBuffer(GLuint buffer) {
+    backend->deleteBuffer(buffer);
+    if (capturing) {
+        writeOp(CaptureOp::DeleteBuffer);
+        writeU32(buffer);
+    }
+}
+
+// Textures
+
+GLuint GraphicsCapture::createTexture() {
+    GLuint texture = backend->createTexture();
+    if (capturing) {
+        writeOp(CaptureOp::CreateTexture);
+        writeU32(texture);
+    }
+    return texture;
+}
+
+void GraphicsCapture::bindTexture(GLenum target, GLuint texture) {
+    backend->bindTexture(target, texture);
+    if (capturing) {
+        writeOp(CaptureOp::BindTexture);
+        writeU32(target);
+        writeU32(texture);
+    }
+}
+
+void GraphicsCapture::texImage2D(GLenum target, GLint level, GLint internalFormat,
+                                 int width, int height, GLenum format, GLenum type, const void* data) {
+    backend->texImage2D(target, level, internalFormat, width, height, format, type, data);
+    if (capturing) {
+        writeOp(CaptureOp::TexImage2D);
+        writeU32(target);
+        writeU32((uint32_t)level);
+        writeU32((uint32_t)internalFormat);
+        writeU32((uint32_t)width);
+        writeU32((uint32_t)height);
+        writeU32(format);
+        writeU32(type);
+        writePayload(data, data ? getTextureDataSize(width, height, format, type) : 0);
+    }
+}
+
+void GraphicsCapture::texSubImage2D(GLenum target, GLint level, int x, int y,
+                                    int width, int height, GLenum format, GLenum type, const void* data) {
+    backend->texSubImage2D(target, level, x, y, width, height, format, type, data);
+    if (capturing) {
+        writeOp(CaptureOp::TexSubImage2D);
+        writeU32(target);
+        writeU32((uint32_t)level);
+        writeU32((uint32_t)x);
+        writeU32((uint32_t)y);
+        writeU32((uint32_t)width);
+        writeU32((uint32_t)height);
+        writeU32(format);
+        writeU32(type);
+        writePayload(data, data ? getTextureDataSize(width, height, format, type) : 0);
+    }
+}
+
+void GraphicsCapture::texParameteri(GLenum target, GLenum pname, GLint param) {
+    backend->texParameteri(target, pname, param);
+    if (capturing) {
+        writeOp(CaptureOp::TexParameteri);
+        writeU32(target);
+        writeU32(pname);
+        writeU32((uint32_t)param);
+    }
+}
+
+void GraphicsCapture::deleteTexture(GLuint texture) {
+    backend->deleteTexture(texture);
+    if (capturing) {
+        writeOp(CaptureOp::DeleteTexture);
+        writeU32(texture);
+    }
+}
+
+void GraphicsCapture::activeTexture(GLenum texture) {
+    backend->activeTexture(texture);
+    if (capturing) {
+        writeOp(CaptureOp::ActiveTexture);
+        writeU32(texture);
+    }
+}
+
+// Framebuffers
+
+GLuint GraphicsCapture::createFramebuffer() {
+    GLuint framebuffer = backend->createFramebuffer();
+    if (capturing) {
+        writeOp(CaptureOp::CreateFramebuffer);
+        writeU32(framebuffer);
+    }
+    return framebuffer;
+}
+
+void GraphicsCapture::bindFramebuffer(GLuint framebuffer) {
+    backend->bindFramebuffer(framebuffer);
+    if (capturing) {
+        writeOp(CaptureOp::BindFramebuffer);
+        writeU32(framebuffer);
+    }
+}
+
+void GraphicsCapture::framebufferTexture2D(GLuint texture) {
+    backend->framebufferTexture2D(texture);
+    if (capturing) {
+        writeOp(CaptureOp::FramebufferTexture2D);
+        writeU32(texture);
+    }
+}
+
+bool GraphicsCapture::isFramebufferComplete() {
+    // Recorded because the check can stall the driver; replay repeats it
+    bool complete = backend->isFramebufferComplete();
+    if (capturing) {
+        writeOp(CaptureOp::IsFramebufferComplete);
+    }
+    return complete;
+}
+
+void GraphicsCapture::deleteFramebuffer(GLuint framebuffer) {
+    backend->deleteFramebuffer(framebuffer);
+    if (capturing) {
+        writeOp(CaptureOp::DeleteFramebuffer);
+        writeU32(framebuffer);
+    }
+}
+
+void GraphicsCapture::viewport(int x, int y, int width, int height) {
+    backend->viewport(x, y, width, height);
+    if (capturing) {
+        writeOp(CaptureOp::Viewport);
+        writeU32((uint32_t)x);
+        writeU32((uint32_t)y);
+        writeU32((uint32_t)width);
+        writeU32((uint32_t)height);
+    }
+}
+
+// Vertex arrays
+
+void GraphicsCapture::setupVertexArray(GLuint program, GLuint buffer) {
+    backend->setupVertexArray(program, buffer);
+    if (capturing) {
+        writeOp(CaptureOp::SetupVertexArray);
+        writeU32(program);
+        writeU32(buffer);
+    }
+}
+
+void GraphicsCapture::enableVertexAttribute(GLuint program, const std::string& name,
+                                            int size, GLenum type, int stride, int offset) {
+    backend->enableVertexAttribute(program, name, size, type, stride, offset);
+    if (capturing) {
+        uint32_t id = internName(name);
+        writeOp(CaptureOp::EnableVertexAttribute);
+        writeU32(program);
+        writeU32(id);
+        writeU32((uint32_t)size);
+        writeU32(type);
+        writeU32((uint32_t)stride);
+        writeU32((uint32_t)offset);
+    }
+}
+
+void GraphicsCapture::disableVertexAttribute(GLuint program, const std::string& name) {
+    backend->disableVertexAttribute(program, name);
+    if (capturing) {
+        uint32_t id = internName(name);
+        writeOp(CaptureOp::DisableVertexAttribute);
+        writeU32(program);
+        writeU32(id);
+    }
+}
+
+// Drawing
+
+void GraphicsCapture::drawArrays(GLenum mode, GLint first, int count) {
+    backend->drawArrays(mode, first, count);
+    if (capturing) {
+        writeOp(CaptureOp::DrawArrays);
+        writeU32(mode);
+        writeU32((uint32_t)first);
+        writeU32((uint32_t)count);
+    }
+}
+
+void GraphicsCapture::drawElements(GLenum mode, int count, GLenum type, size_t offset) {
+    backend->drawElements(mode, count, type, offset);
+    if (capturing) {
+        writeOp(CaptureOp::DrawElements);
+        writeU32(mode);
+        writeU32((uint32_t)count);
+        writeU32(type);
+        writeU32((uint32_t)offset);
+    }
+}
+
+// State
+
+void GraphicsCapture::enable(GLenum cap) {
+    backend->enable(cap);
+    if (capturing) {
+        writeOp(CaptureOp::Enable);
+        writeU32(cap);
+    }
+}
+
+void GraphicsCapture::disable(GLenum cap) {
+    backend->disable(cap);
+    if (capturing) {
+        writeOp(CaptureOp::Disable);
+        writeU32(cap);
+    }
+}
+
+void GraphicsCapture::scissor(int x, int y, int width, int height) {
+    backend->scissor(x, y, width, height);
+    if (capturing) {
+        writeOp(CaptureOp::Scissor);
+        writeU32((uint32_t)x);
+        writeU32((uint32_t)y);
+        writeU32((uint32_t)width);
+        writeU32((uint32_t)height);
+    }
+}
+
+void GraphicsCapture::blendFunc(GLenum sfactor, GLenum dfactor) {
+    backend->blendFunc(sfactor, dfactor);
+    if (capturing) {
+        writeOp(CaptureOp::BlendFunc);
+        writeU32(sfactor);
+        writeU32(dfactor);
+    }
+}
+
+void GraphicsCapture::blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+    backend->blendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+    if (capturing) {
+        writeOp(CaptureOp::BlendFuncSeparate);
+        writeU32(srcRGB);
+        writeU32(dstRGB);
+        writeU32(srcAlpha);
+        writeU32(dstAlpha);
+    }
+}
+
+void GraphicsCapture::clearColor(float r, float g, float b, float a) {
+    backend->clearColor(r, g, b, a);
+    if (capturing) {
+        writeOp(CaptureOp::ClearColor);
+        writeFloat(r);
+        writeFloat(g);
+        writeFloat(b);
+        writeFloat(a);
+    }
+}
+
+void GraphicsCapture::clear(GLuint mask) {
+    backend->clear(mask);
+    if (capturing) {
+        writeOp(CaptureOp::Clear);
+        writeU32(mask);
+    }
+}
+
+// Readback produces data rather than drawing, so it passes through unrecorded
+
+void GraphicsCapture::readPixels(int x, int y, int width, int height, void* pixels) {
+    backend->readPixels(x, y, width, height, pixels);
+}
+
+bool GraphicsCapture::supportsAsyncReadback() const {
+    return backend->supportsAsyncReadback();
+}
+
+GLuint GraphicsCapture::createPixelBuffer(size_t size) {
+    return backend->createPixelBuffer(size);
+}
+
+void GraphicsCapture::readPixelsToBuffer(GLuint buffer, int x, int y, int width, int height) {
+    backend->readPixelsToBuffer(buffer, x, y, width, height);
+}
+
+bool GraphicsCapture::getPixelBufferData(GLuint buffer, size_t size, void* data) {
+    return backend->getPixelBufferData(buffer, size, data);
+}
+
+GLsync GraphicsCapture::createFence() {
+    return backend->createFence();
+}
+
+bool GraphicsCapture::isFenceSignaled(GLsync fence) {
+    return backend->isFenceSignaled(fence);
+}
+
+void GraphicsCapture::deleteFence(GLsync fence) {
+    backend->deleteFence(fence);
+}
+
+// Queries pass through unrecorded
+
+std::string GraphicsCapture::getRendererName() const {
+    return backend->getRendererName();
+}
+
+bool GraphicsCapture::supportsVertexArrays() const {
+    return backend->supportsVertexArrays();
+}
+
+bool GraphicsCapture::supportsUint32Indices() const {
+    return backend->supportsUint32Indices();
+}
+
+std::string GraphicsCapture::getVertexShaderPath(const std::string& baseName) const {
+    return backend->getVertexShaderPath(baseName);
+}
+
+std::string GraphicsCapture::getFragmentShaderPath(const std::string& baseName) const {
+    return backend->getFragmentShaderPath(baseName);
+}
\ No newline at end of file
@@ -0,0 +1,194 @@
+#pragma once
+
+#include "graphics_api.h"
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// On-disk layout of a graphics capture, written by GraphicsCapture and played by GraphicsReplay:
+//   CaptureHeader
+//   records: uint8 CaptureOp, then its operands, up to CaptureOp::EndOfCapture
+// Operands are 32-bit little-endian values (floats by bit pattern); payloads such as
+// shader sources, buffer and texture data are a 32-bit byte count and the bytes.
+// Uniform and attribute names are interned: DefineName gives a name the next id the
+// first time it is used, later calls carry only the id. Handles are the ones the
+// capturing backend returned; replay maps them to its own.
+const char CAPTURE_MAGIC[4] = {'E', 'J', 'C', 'P'};
+const uint32_t CAPTURE_VERSION = 1;
+
+struct CaptureHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t windowWidth;
+    uint32_t windowHeight;
+    uint32_t frameCount; // Filled in when the capture is finished
+    uint32_t reserved;
+};
+
+enum class CaptureOp : uint8_t {
+    DefineName,
+    CompileShader,
+    CreateProgram,
+    UseProgram,
+    DeleteProgram,
+    SetUniform1f,
+    SetUniform2f,
+    SetUniform3f,
+    SetUniform1i,
+    SetUniformMatrix4fv,
+    CreateBuffer,
+    BindBuffer,
+    BufferData,
+    DeleteBuffer,
+    CreateTexture,
+    BindTexture,
+    TexImage2D,
+    TexSubImage2D,
+    TexParameteri,
+    DeleteTexture,
+    ActiveTexture,
+    CreateFramebuffer,
+    BindFramebuffer,
+    FramebufferTexture2D,
+    IsFramebufferComplete,
+    DeleteFramebuffer,
+    Viewport,
+    SetupVertexArray,
+    EnableVertexAttribute,
+    DisableVertexAttribute,
+    DrawArrays,
+    DrawElements,
+    Enable,
+    Disable,
+    Scissor,
+    BlendFunc,
+    BlendFuncSeparate,
+    ClearColor,
+    Clear,
+    WindowSize,   // The window was resized; not a GraphicsAPI call
+    EndFrame,     // Frame boundary (after the swap)
+    EndOfCapture,
+    Count
+};
+
+// GraphicsAPI method name of an op, for reports
+const char* getCaptureOpName(CaptureOp op);
+
+// Bytes of pixel data a texture upload reads (every texture in the engine is RGBA8)
+size_t getTextureDataSize(int width, int height, GLenum format, GLenum type);
+
+// Forwards every call to another backend and records it, payloads included, for
+// tools/replay. Recording starts before any GL object exists so the stream is
+// self-contained; it stops after a number of frames and calls keep forwarding.
+class GraphicsCapture : public GraphicsAPI {
+public:
+    GraphicsCapture(std::unique_ptr<GraphicsAPI> backend, int windowWidth, int windowHeight);
+    ~GraphicsCapture() override;
+    
+    // Record to path until frameLimit frames have ended (0 records until stop)
+    bool start(const std::string& path, int frameLimit);
+    
+    // Finish the file; called automatically at the frame limit and on destruction
+    void stop();
+    
+    bool isCapturing() const { return capturing; }
+    
+    // Mark the end of a frame, after the swap; records are written out once per frame
+    void endFrame();
+    
+    // Window resizes change what replay renders into
+    void setWindowSize(int width, int height);
+    
+    GraphicsAPI* getBackend() { return backend.get(); }
+    
+    GLuint compileShader(GLenum type, std::string_view source) override;
+    GLuint createProgram(GLuint vertexShader, GLuint fragmentShader) override;
+    void useProgram(GLuint program) override;
+    void deleteProgram(GLuint program) override;
+    
+    void setUniform1f(GLuint program, const std::string& name, float value) override;
+    void setUniform2f(GLuint program, const std::string& name, float x, float y) override;
+    void setUniform3f(GLuint program, const std::string& name, float x, float y, float z) override;
+    void setUniform1i(GLuint program, const std::string& name, int value) override;
+    void setUniformMatrix4fv(GLuint program, const std::string& name, const float* value) override;
+    
+    GLuint createBuffer() override;
+    void bindBuffer(GLenum target, GLuint buffer) override;
+    void bufferData(GLenum target, size_t size, const void* data, GLenum usage) override;
+    void deleteBuffer(GLuint buffer) override;
+    
+    GLuint createTexture() override;
+    void bindTexture(GLenum target, GLuint texture) override;
+    void texImage2D(GLenum target, GLint level, GLint internalFormat,
+                   int width, int height, GLenum format, GLenum type, const void* data) override;
+    void texSubImage2D(GLenum target, GLint level, int x, int y,
+                      int width, int height, GLenum format, GLenum type, const void* data) override;
+    void texParameteri(GLenum target, GLenum pname, GLint param) override;
+    void deleteTexture(GLuint texture) override;
+    void activeTexture(GLenum texture) override;
+    
+    GLuint createFramebuffer() override;
+    void bindFramebuffer(GLuint framebuffer) override;
+    void framebufferTexture2D(GLuint texture) override;
+    bool isFramebufferComplete() override;
+    void deleteFramebuffer(GLuint framebuffer) override;
+    void viewport(int x, int y, int width, int height) override;
+    
+    void setupVertexArray(GLuint program, GLuint buffer) override;
+    void enableVertexAttribute(GLuint program, const std::string& name,
+                             int size, GLenum type, int stride, int offset) override;
+    void disableVertexAttribute(GLuint program, const std::string& name) override;
+    
+    void drawArrays(GLenum mode, GLint first, int count) override;
+    void drawElements(GLenum mode, int count, GLenum type, size_t offset) override;
+    
+    void enable(GLenum cap) override;
+    void disable(GLenum cap) override;
+    void scissor(int x, int y, int width, int height) override;
+    void blendFunc(GLenum sfactor, GLenum dfactor) override;
+    void blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) override;
+    void clearColor(float r, float g, float b, float a) override;
+    void clear(GLuint mask) override;
+    
+    void readPixels(int x, int y, int width, int height, void* pixels) override;
+    bool supportsAsyncReadback() const override;
+    GLuint createPixelBuffer(size_t size) override;
+    void readPixelsToBuffer(GLuint buffer, int x, int y, int width, int height) override;
+    bool getPixelBufferData(GLuint buffer, size_t size, void* data) override;
+    GLsync createFence() override;
+    bool isFenceSignaled(GLsync fence) override;
+    void deleteFence(GLsync fence) override;
+    
+    std::string getRendererName() const override;
+    bool supportsVertexArrays() const override;
+    bool supportsUint32Indices() const override;
+    
+    std::string getVertexShaderPath(const std::string& baseName) const override;
+    std::string getFragmentShaderPath(const std::string& baseName) const override;
+
+private:
+    std::unique_ptr<GraphicsAPI> backend;
+    int windowWidth, windowHeight;
+    std::ofstream file;
+    std::string path;
+    std::vector<uint8_t> pending; // Records of the current frame
+    std::unordered_map<std::string, uint32_t> names;
+    bool capturing;
+    int frameLimit;
+    int frameCount;
+    uint64_t bytesWritten;
+    
+    void writeOp(CaptureOp op);
+    void writeU32(uint32_t value);
+    void writeFloat(float value);
+    void writePayload(const void* data, size_t size);
+    
+    // Id of an interned name; the first use records its DefineName, so call before writeOp
+    uint32_t internName(const std::string& name);
+    
+    // Append pending records to the file
+    void flush();
+};
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "graphics_core.h"
+#include <cstring>
 #include <iostream>
 
 GraphicsCore::GraphicsCore() : currentVAO(0) {
@@ -10,10 +11,11 @@ GraphicsCore::~GraphicsCore() {
     }
 }
 
-GLuint GraphicsCore::compileShader(GLenum type, const std::string& source) {
+GLuint GraphicsCore::compileShader(GLenum type, std::string_view source) {
     GLuint shader = glCreateShader(type);
-    const char* src = source.c_str();
-    glShaderSource(shader, 1, &src, NULL);
+    const char* src = source.data();
+    GLint length = (GLint)source.size();
+    glShaderSource(shader, 1, &src, &length);
     glCompileShader(shader);
     
     GLint success;
@@ -62,6 +64,11 @@ void GraphicsCore::setUniform1f(GLuint program, const std::string& name, float v
     glUniform1f(location, value);
 }
 
+void GraphicsCore::setUniform2f(GLuint program, const std::string& name, float x, float y) {
+    GLint location = glGetUniformLocation(program, name.c_str());
+    glUniform2f(location, x, y);
+}
+
 void GraphicsCore::setUniform3f(GLuint program, const std::string& name, float x, float y, float z) {
     GLint location = glGetUniformLocation(program, name.c_str());
     glUniform3f(location, x, y, z);
@@ -72,6 +79,11 @@ void GraphicsCore::setUniform1i(GLuint program, const std::string& name, int val
     glUniform1i(location, value);
 }
 
+void GraphicsCore::setUniformMatrix4fv(GLuint program, const std::string& name, const float* value) {
+    GLint location = glGetUniformLocation(program, name.c_str());
+    glUniformMatrix4fv(location, 1, GL_FALSE, value);
+}
+
 GLuint GraphicsCore::createBuffer() {
     GLuint buffer;
     glGenBuffers(1, &buffer);
@@ -105,6 +117,11 @@ void GraphicsCore::texImage2D(GLenum target, GLint level, GLint internalFormat,
     glTexImage2D(target, level, internalFormat, width, height, 0, format, type, data);
 }
 
+void GraphicsCore::texSubImage2D(GLenum target, GLint level, int x, int y,
+                                 int width, int height, GLenum format, GLenum type, const void* data) {
+    glTexSubImage2D(target, level, x, y, width, height, format, type, data);
+}
+
 void GraphicsCore::texParameteri(GLenum target, GLenum pname, GLint param) {
     glTexParameteri(target, pname, param);
 }
@@ -117,6 +134,32 @@ void GraphicsCore::activeTexture(GLenum texture) {
     glActiveTexture(texture);
 }
 
+GLuint GraphicsCore::createFramebuffer() {
+    GLuint framebuffer;
+    glGenFramebuffers(1, &framebuffer);
+    return framebuffer;
+}
+
+void GraphicsCore::bindFramebuffer(GLuint framebuffer) {
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+}
+
+void GraphicsCore::framebufferTexture2D(GLuint texture) {
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+}
+
+bool GraphicsCore::isFramebufferComplete() {
+    return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+void GraphicsCore::deleteFramebuffer(GLuint framebuffer) {
+    glDeleteFramebuffers(1, &framebuffer);
+}
+
+void GraphicsCore::viewport(int x, int y, int width, int height) {
+    glViewport(x, y, width, height);
+}
+
 void GraphicsCore::setupVertexArray(GLuint program, GLuint buffer) {
     if (!currentVAO) {
         glGenVertexArrays(1, &currentVAO);
@@ -132,6 +175,7 @@ void GraphicsCore::enableVertexAttribute(GLuint program, const std::string& name
     GLuint location = 0;
     if (name == "aPosition") location = 0;
     else if (name == "aTexCoord") location = 1;
+    else if (name == "aColor") location = 2;
     // Add more as needed
     
     glVertexAttribPointer(location, size, type, GL_FALSE, stride, (void*)(intptr_t)offset);
@@ -142,6 +186,7 @@ void GraphicsCore::disableVertexAttribute(GLuint program, const std::string& nam
     GLuint location = 0;
     if (name == "aPosition") location = 0;
     else if (name == "aTexCoord") location = 1;
+    else if (name == "aColor") location = 2;
     
     glDisableVertexAttribArray(location);
 }
@@ -150,14 +195,30 @@ void GraphicsCore::drawArrays(GLenum mode, GLint first, int count) {
     glDrawArrays(mode, first, count);
 }
 
+void GraphicsCore::drawElements(GLenum mode, int count, GLenum type, size_t offset) {
+    glDrawElements(mode, count, type, (void*)(intptr_t)offset);
+}
+
 void GraphicsCore::enable(GLenum cap) {
     glEnable(cap);
 }
 
+void GraphicsCore::disable(GLenum cap) {
+    glDisable(cap);
+}
+
+void GraphicsCore::scissor(int x, int y, int width, int height) {
+    glScissor(x, y, width, height);
+}
+
 void GraphicsCore::blendFunc(GLenum sfactor, GLenum dfactor) {
     glBlendFunc(sfactor, dfactor);
 }
 
+void GraphicsCore::blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+    glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+}
+
 void GraphicsCore::clearColor(float r, float g, float b, float a) {
     glClearColor(r, g, b, a);
 }
@@ -166,6 +227,57 @@ void GraphicsCore::clear(GLuint mask) {
     glClear(mask);
 }
 
+void GraphicsCore::readPixels(int x, int y, int width, int height, void* pixels) {
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+}
+
+bool GraphicsCore::supportsAsyncReadback() const {
+    return true;
+}
+
+GLuint GraphicsCore::createPixelBuffer(size_t size) {
+    GLuint buffer;
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+    glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return buffer;
+}
+
+void GraphicsCore::readPixelsToBuffer(GLuint buffer, int x, int y, int width, int height) {
+    // With a pack buffer bound the copy is queued and the pointer is an offset
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+}
+
+bool GraphicsCore::getPixelBufferData(GLuint buffer, size_t size, void* data) {
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+    void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+    if (mapped) {
+        memcpy(data, mapped, size);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return mapped != nullptr;
+}
+
+GLsync GraphicsCore::createFence() {
+    return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+bool GraphicsCore::isFenceSignaled(GLsync fence) {
+    // Zero timeout polls; the flush makes sure the fence is submitted at all
+    GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
+void GraphicsCore::deleteFence(GLsync fence) {
+    glDeleteSync(fence);
+}
+
 std::string GraphicsCore::getRendererName() const {
     return "OpenGL 3.3 Core";
 }
@@ -174,6 +286,10 @@ bool GraphicsCore::supportsVertexArrays() const {
     return true;
 }
 
+bool GraphicsCore::supportsUint32Indices() const {
+    return true;
+}
+
 std::string GraphicsCore::getVertexShaderPath(const std::string& baseName) const {
     return "shaders/" + baseName + "_vertex_core.glsl";
 }
@@ -7,10 +7,11 @@ GraphicsES::GraphicsES() : currentProgram(0) {
 GraphicsES::~GraphicsES() {
 }
 
-GLuint GraphicsES::compileShader(GLenum type, const std::string& source) {
+GLuint GraphicsES::compileShader(GLenum type, std::string_view source) {
     GLuint shader = glCreateShader(type);
-    const char* src = source.c_str();
-    glShaderSource(shader, 1, &src, NULL);
+    const char* src = source.data();
+    GLint length = (GLint)source.size();
+    glShaderSource(shader, 1, &src, &length);
     glCompileShader(shader);
     
     GLint success;
@@ -60,6 +61,11 @@ void GraphicsES::setUniform1f(GLuint program, const std::string& name, float val
     glUniform1f(location, value);
 }
 
+void GraphicsES::setUniform2f(GLuint program, const std::string& name, float x, float y) {
+    GLint location = glGetUniformLocation(program, name.c_str());
+    glUniform2f(location, x, y);
+}
+
 void GraphicsES::setUniform3f(GLuint program, const std::string& name, float x, float y, float z) {
     GLint location = glGetUniformLocation(program, name.c_str());
     glUniform3f(location, x, y, z);
@@ -70,6 +76,11 @@ void GraphicsES::setUniform1i(GLuint program, const std::string& name, int value
     glUniform1i(location, value);
 }
 
+void GraphicsES::setUniformMatrix4fv(GLuint program, const std::string& name, const float* value) {
+    GLint location = glGetUniformLocation(program, name.c_str());
+    glUniformMatrix4fv(location, 1, GL_FALSE, value);
+}
+
 GLuint GraphicsES::createBuffer() {
     GLuint buffer;
     glGenBuffers(1, &buffer);
@@ -103,6 +114,11 @@ void GraphicsES::texImage2D(GLenum target, GLint level, GLint internalFormat,
     glTexImage2D(target, level, internalFormat, width, height, 0, format, type, data);
 }
 
+void GraphicsES::texSubImage2D(GLenum target, GLint level, int x, int y,
+                               int width, int height, GLenum format, GLenum type, const void* data) {
+    glTexSubImage2D(target, level, x, y, width, height, format, type, data);
+}
+
 void GraphicsES::texParameteri(GLenum target, GLenum pname, GLint param) {
     glTexParameteri(target, pname, param);
 }
@@ -115,6 +131,32 @@ void GraphicsES::activeTexture(GLenum texture) {
     glActiveTexture(texture);
 }
 
+GLuint GraphicsES::createFramebuffer() {
+    GLuint framebuffer;
+    glGenFramebuffers(1, &framebuffer);
+    return framebuffer;
+}
+
+void GraphicsES::bindFramebuffer(GLuint framebuffer) {
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+}
+
+void GraphicsES::framebufferTexture2D(GLuint texture) {
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture, 0);
+}
+
+bool GraphicsES::isFramebufferComplete() {
+    return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+void GraphicsES::deleteFramebuffer(GLuint framebuffer) {
+    glDeleteFramebuffers(1, &framebuffer);
+}
+
+void GraphicsES::viewport(int x, int y, int width, int height) {
+    glViewport(x, y, width, height);
+}
+
 void GraphicsES::setupVertexArray(GLuint program, GLuint buffer) {
     // ES doesn't have VAOs, just bind the buffer
     bindBuffer(GL_ARRAY_BUFFER, buffer);
@@ -140,14 +182,30 @@ void GraphicsES::drawArrays(GLenum mode, GLint first, int count) {
     glDrawArrays(mode, first, count);
 }
 
+void GraphicsES::drawElements(GLenum mode, int count, GLenum type, size_t offset) {
+    glDrawElements(mode, count, type, (void*)(intptr_t)offset);
+}
+
 void GraphicsES::enable(GLenum cap) {
     glEnable(cap);
 }
 
+void GraphicsES::disable(GLenum cap) {
+    glDisable(cap);
+}
+
+void GraphicsES::scissor(int x, int y, int width, int height) {
+    glScissor(x, y, width, height);
+}
+
 void GraphicsES::blendFunc(GLenum sfactor, GLenum dfactor) {
     glBlendFunc(sfactor, dfactor);
 }
 
+void GraphicsES::blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+    glBlendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+}
+
 void GraphicsES::clearColor(float r, float g, float b, float a) {
     glClearColor(r, g, b, a);
 }
@@ -156,6 +214,50 @@ void GraphicsES::clear(GLuint mask) {
     glClear(mask);
 }
 
+void GraphicsES::readPixels(int x, int y, int width, int height, void* pixels) {
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(x, y, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+}
+
+// ES 2.0 has neither pixel pack buffers nor fences; callers fall back to readPixels
+
+bool GraphicsES::supportsAsyncReadback() const {
+    return false;
+}
+
+GLuint GraphicsES::createPixelBuffer(size_t size) {
+    (void)size;
+    return 0;
+}
+
+void GraphicsES::readPixelsToBuffer(GLuint buffer, int x, int y, int width, int height) {
+    (void)buffer;
+    (void)x;
+    (void)y;
+    (void)width;
+    (void)height;
+}
+
+bool GraphicsES::getPixelBufferData(GLuint buffer, size_t size, void* data) {
+    (void)buffer;
+    (void)size;
+    (void)data;
+    return false;
+}
+
+GLsync GraphicsES::createFence() {
+    return nullptr;
+}
+
+bool GraphicsES::isFenceSignaled(GLsync fence) {
+    (void)fence;
+    return true;
+}
+
+void GraphicsES::deleteFence(GLsync fence) {
+    (void)fence;
+}
+
 std::string GraphicsES::getRendererName() const {
     return "OpenGL ES 2.0";
 }
@@ -164,6 +266,11 @@ bool GraphicsES::supportsVertexArrays() const {
     return false;
 }
 
+bool GraphicsES::supportsUint32Indices() const {
+    // 32-bit indices need OES_element_index_uint on ES 2.0
+    return false;
+}
+
 std::string GraphicsES::getVertexShaderPath(const std::string& baseName) const {
     return "shaders/" + baseName + "_vertex_es.glsl";
 }
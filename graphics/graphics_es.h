@@ -9,14 +9,16 @@ public:
     GraphicsES();
     ~GraphicsES() override;
     
-    GLuint compileShader(GLenum type, const std::string& source) override;
+    GLuint compileShader(GLenum type, std::string_view source) override;
     GLuint createProgram(GLuint vertexShader, GLuint fragmentShader) override;
     void useProgram(GLuint program) override;
     void deleteProgram(GLuint program) override;
     
     void setUniform1f(GLuint program, const std::string& name, float value) override;
+    void setUniform2f(GLuint program, const std::string& name, float x, float y) override;
     void setUniform3f(GLuint program, const std::string& name, float x, float y, float z) override;
     void setUniform1i(GLuint program, const std::string& name, int value) override;
+    void setUniformMatrix4fv(GLuint program, const std::string& name, const float* value) override;
     
     GLuint createBuffer() override;
     void bindBuffer(GLenum target, GLuint buffer) override;
@@ -27,24 +29,47 @@ public:
     void bindTexture(GLenum target, GLuint texture) override;
     void texImage2D(GLenum target, GLint level, GLint internalFormat, 
                    int width, int height, GLenum format, GLenum type, const void* data) override;
+    void texSubImage2D(GLenum target, GLint level, int x, int y,
+                      int width, int height, GLenum format, GLenum type, const void* data) override;
     void texParameteri(GLenum target, GLenum pname, GLint param) override;
     void deleteTexture(GLuint texture) override;
     void activeTexture(GLenum texture) override;
     
+    GLuint createFramebuffer() override;
+    void bindFramebuffer(GLuint framebuffer) override;
+    void framebufferTexture2D(GLuint texture) override;
+    bool isFramebufferComplete() override;
+    void deleteFramebuffer(GLuint framebuffer) override;
+    void viewport(int x, int y, int width, int height) override;
+    
     void setupVertexArray(GLuint program, GLuint buffer) override;
     void enableVertexAttribute(GLuint program, const std::string& name, 
                              int size, GLenum type, int stride, int offset) override;
     void disableVertexAttribute(GLuint program, const std::string& name) override;
     
     void drawArrays(GLenum mode, GLint first, int count) override;
+    void drawElements(GLenum mode, int count, GLenum type, size_t offset) override;
     
     void enable(GLenum cap) override;
+    void disable(GLenum cap) override;
+    void scissor(int x, int y, int width, int height) override;
     void blendFunc(GLenum sfactor, GLenum dfactor) override;
+    void blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) override;
     void clearColor(float r, float g, float b, float a) override;
     void clear(GLuint mask) override;
     
+    void readPixels(int x, int y, int width, int height, void* pixels) override;
+    bool supportsAsyncReadback() const override;
+    GLuint createPixelBuffer(size_t size) override;
+    void readPixelsToBuffer(GLuint buffer, int x, int y, int width, int height) override;
+    bool getPixelBufferData(GLuint buffer, size_t size, void* data) override;
+    GLsync createFence() override;
+    bool isFenceSignaled(GLsync fence) override;
+    void deleteFence(GLsync fence) override;
+    
     std::string getRendererName() const override;
     bool supportsVertexArrays() const override;
+    bool supportsUint32Indices() const override;
     
     std::string getVertexShaderPath(const std::string& baseName) const override;
     std::string getFragmentShaderPath(const std::string& baseName) const override;
@@ -14,6 +14,10 @@ std::unique_ptr<GraphicsAPI> GraphicsFactory::create() {
 #endif
 }
 
+std::unique_ptr<GraphicsSoftware> GraphicsFactory::createSoftware(int width, int height, JobSystem* jobs) {
+    return std::make_unique<GraphicsSoftware>(width, height, jobs);
+}
+
 std::string GraphicsFactory::getRendererName() {
 #ifdef __EMSCRIPTEN__
     return "OpenGL ES 2.0";
@@ -1,13 +1,20 @@
 #pragma once
 
 #include "graphics_api.h"
+#include "graphics_software.h"
 #include <memory>
 
+class JobSystem;
+
 class GraphicsFactory {
 public:
     // Create the appropriate graphics API implementation for current build target
     static std::unique_ptr<GraphicsAPI> create();
     
+    // CPU renderer into a width x height framebuffer; needs no window or GL
+    // context, so it also runs on headless servers. Tiles are spread over jobs when given.
+    static std::unique_ptr<GraphicsSoftware> createSoftware(int width, int height, JobSystem* jobs = nullptr);
+    
     // Get renderer name without creating instance
     static std::string getRendererName();
 };
\ No newline at end of file
@@ -0,0 +1,434 @@
+#include "graphics_replay.h"
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using ReplayClock = std::chrono::steady_clock;
+
+GraphicsReplay::GraphicsReplay()
+    : position(0), truncated(false), windowWidth(0), windowHeight(0), frameCount(0) {
+}
+
+bool GraphicsReplay::load(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        printf("Failed to open capture: %s\n", path.c_str());
+        return false;
+    }
+    
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string contents = buffer.str();
+    data.assign(contents.begin(), contents.end());
+    
+    CaptureHeader header;
+    if (data.size() < sizeof(header)) {
+        printf("Capture too small: %s\n", path.c_str());
+        return false;
+    }
+    memcpy(&header, data.data(), sizeof(header));
+    if (memcmp(header.magic, CAPTURE_MAGIC, sizeof(header.magic)) != 0) {
+        printf("Not a graphics capture: %s\n", path.c_str());
+        return false;
+    }
+    if (header.version != CAPTURE_VERSION) {
+        printf("Unsupported capture version %u (expected %u)\n", header.version, CAPTURE_VERSION);
+        return false;
+    }
+    
+    windowWidth = (int)header.windowWidth;
+    windowHeight = (int)header.windowHeight;
+    frameCount = (int)header.frameCount;
+    return true;
+}
+
+uint32_t GraphicsReplay::readU32() {
+    if (position + 4 > data.size()) {
+        truncated = true;
+        position = data.size();
+        return 0;
+    }
+    const uint8_t* bytes = &data[position];
+    position += 4;
+    return (uint32_t)bytes[0] | (uint32_t)bytes[1] << 8 | (uint32_t)bytes[2] << 16 | (uint32_t)bytes[3] << 24;
+}
+
+float GraphicsReplay::readFloat() {
+    uint32_t bits = readU32();
+    float value;
+    memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+const uint8_t* GraphicsReplay::readPayload(uint32_t& size) {
+    size = readU32();
+    if (size > data.size() - position) {
+        truncated = true;
+        position = data.size();
+        size = 0;
+        return nullptr;
+    }
+    const uint8_t* payload = size ? &data[position] : nullptr;
+    position += size;
+    return payload;
+}
+
+const std::string& GraphicsReplay::readName() {
+    static const std::string missing;
+    uint32_t id = readU32();
+    if (id >= names.size()) {
+        truncated = true; // Names are always defined before use
+        return missing;
+    }
+    return names[id];
+}
+
+GLuint GraphicsReplay::lookup(const std::unordered_map<GLuint, GLuint>& handles, GLuint handle) {
+    auto it = handles.find(handle);
+    return it != handles.end() ? it->second : 0;
+}
+
+bool GraphicsReplay::play(GraphicsAPI* graphics, const std::function<void()>& endFrame,
+                          const std::function<void(int width, int height)>& resize) {
+    position = sizeof(CaptureHeader);
+    truncated = false;
+    names.clear();
+    shaders.clear();
+    programs.clear();
+    buffers.clear();
+    textures.clear();
+    framebuffers.clear();
+    frameTimes.clear();
+    for (ReplayCallStats& stats : callStats) {
+        stats = ReplayCallStats();
+    }
+    
+    if (resize) {
+        resize(windowWidth, windowHeight);
+    }
+    
+    auto frameStart = ReplayClock::now();
+    while (!truncated) {
+        if (position >= data.size()) {
+            truncated = true;
+            break;
+        }
+        CaptureOp op = (CaptureOp)data[position++];
+        if (op >= CaptureOp::Count) {
+            printf("Unknown capture record %u at offset %zu\n", (unsigned)op, position - 1);
+            return false;
+        }
+        if (op == CaptureOp::EndOfCapture) {
+            break;
+        }
+        
+        if (op == CaptureOp::EndFrame) {
+            if (endFrame) {
+                endFrame();
+            }
+            auto now = ReplayClock::now();
+            frameTimes.push_back(std::chrono::duration<double, std::milli>(now - frameStart).count());
+            frameStart = now;
+            continue;
+        }
+        
+        auto callStart = ReplayClock::now();
+        execute(graphics, op, resize);
+        ReplayCallStats& stats = callStats[(size_t)op];
+        stats.count++;
+        stats.totalMs += std::chrono::duration<double, std::milli>(ReplayClock::now() - callStart).count();
+    }
+    
+    if (truncated) {
+        printf("Capture truncated or corrupt after %zu frames\n", frameTimes.size());
+        return false;
+    }
+    return true;
+}
+
+void GraphicsReplay::execute(GraphicsAPI* graphics, CaptureOp op, const std::function<void(int width, int height)>& resize) {
+    // Data payloads are empty (no data) or exactly as long as the call reads;
+    // anything else stops playback like a truncated stream
+    switch (op) {
+        case CaptureOp::DefineName: {
+            uint32_t id = readU32();
+            uint32_t size = 0;
+            const uint8_t* name = readPayload(size);
+            if (id != names.size()) {
+                truncated = true;
+                break;
+            }
+            names.emplace_back(reinterpret_cast<const char*>(name), size);
+            break;
+        }
+        case CaptureOp::CompileShader: {
+            GLenum type = readU32();
+            GLuint shader = readU32();
+            uint32_t size = 0;
+            const uint8_t* source = readPayload(size);
+            shaders[shader] = graphics->compileShader(type, std::string_view(reinterpret_cast<const char*>(source), size));
+            break;
+        }
+        case CaptureOp::CreateProgram: {
+            GLuint vertexShader = lookup(shaders, readU32());
+            GLuint fragmentShader = lookup(shaders, readU32());
+            GLuint program = readU32();
+            programs[program] = graphics->createProgram(vertexShader, fragmentShader);
+            break;
+        }
+        case CaptureOp::UseProgram:
+            graphics->useProgram(lookup(programs, readU32()));
+            break;
+        case CaptureOp::DeleteProgram: {
+            GLuint program = readU32();
+            graphics->deleteProgram(lookup(programs, program));
+            programs.erase(program);
+            break;
+        }
+        case CaptureOp::SetUniform1f: {
+            GLuint program = lookup(programs, readU32());
+            const std::string& name = readName();
+            float value = readFloat();
+            graphics->setUniform1f(program, name, value);
+            break;
+        }
+        case CaptureOp::SetUniform2f: {
+            GLuint program = lookup(programs, readU32());
+            const std::string& name = readName();
+            float x = readFloat();
+            float y = readFloat();
+            graphics->setUniform2f(program, name, x, y);
+            break;
+        }
+        case CaptureOp::SetUniform3f: {
+            GLuint program = lookup(programs, readU32());
+            const std::string& name = readName();
+            float x = readFloat();
+            float y = readFloat();
+            float z = readFloat();
+            graphics->setUniform3f(program, name, x, y, z);
+            break;
+        }
+        case CaptureOp::SetUniform1i: {
+            GLuint program = lookup(programs, readU32());
+            const std::string& name = readName();
+            int value = (int)readU32();
+            graphics->setUniform1i(program, name, value);
+            break;
+        }
+        case CaptureOp::SetUniformMatrix4fv: {
+            GLuint program = lookup(programs, readU32());
+            const std::string& name = readName();
+            float matrix[16];
+            for (float& value : matrix) {
+                value = readFloat();
+            }
+            graphics->setUniformMatrix4fv(program, name, matrix);
+            break;
+        }
+        case CaptureOp::CreateBuffer: {
+            GLuint buffer = readU32();
+            buffers[buffer] = graphics->createBuffer();
+            break;
+        }
+        case CaptureOp::BindBuffer: {
+            GLenum target = readU32();
+            graphics->bindBuffer(target, lookup(buffers, readU32()));
+            break;
+        }
+        case CaptureOp::BufferData: {
+            GLenum target = readU32();
+            GLenum usage = readU32();
+            uint32_t size = readU32();
+            uint32_t payloadSize = 0;
+            const uint8_t* payload = readPayload(payloadSize);
+            if (payloadSize && payloadSize != size) {
+                truncated = true;
+                break;
+            }
+            graphics->bufferData(target, size, payload, usage);
+            break;
+        }
+        case CaptureOp::DeleteBuffer: {
+            GLuint buffer = readU32();
+            graphics->deleteBuffer(lookup(buffers, buffer));
+            buffers.erase(buffer);
+            break;
+        }
+        case CaptureOp::CreateTexture: {
+            GLuint texture = readU32();
+            textures[texture] = graphics->createTexture();
+            break;
+        }
+        case CaptureOp::BindTexture: {
+            GLenum target = readU32();
+            graphics->bindTexture(target, lookup(textures, readU32()));
+            break;
+        }
+        case CaptureOp::TexImage2D: {
+            GLenum target = readU32();
+            GLint level = (GLint)readU32();
+            GLint internalFormat = (GLint)readU32();
+            int width = (int)readU32();
+            int height = (int)readU32();
+            GLenum format = readU32();
+            GLenum type = readU32();
+            uint32_t size = 0;
+            const uint8_t* pixels = readPayload(size);
+            if (size && size != getTextureDataSize(width, height, format, type)) {
+                truncated = true;
+                break;
+            }
+            graphics->texImage2D(target, level, internalFormat, width, height, format, type, pixels);
+            break;
+        }
+        case CaptureOp::TexSubImage2D: {
+            GLenum target = readU32();
+            GLint level = (GLint)readU32();
+            int x = (int)readU32();
+            int y = (int)readU32();
+            int width = (int)readU32();
+            int height = (int)readU32();
+            GLenum format = readU32();
+            GLenum type = readU32();
+            uint32_t size = 0;
+            const uint8_t* pixels = readPayload(size);
+            if (size && size != getTextureDataSize(width, height, format, type)) {
+                truncated = true;
+                break;
+            }
+            graphics->texSubImage2D(target, level, x, y, width, height, format, type, pixels);
+            break;
+        }
+        case CaptureOp::TexParameteri: {
+            GLenum target = readU32();
+            GLenum pname = readU32();
+            GLint param = (GLint)readU32();
+            graphics->texParameteri(target, pname, param);
+            break;
+        }
+        case CaptureOp::DeleteTexture: {
+            GLuint texture = readU32();
+            graphics->deleteTexture(lookup(textures, texture));
+            textures.erase(texture);
+            break;
+        }
+        case CaptureOp::ActiveTexture:
+            graphics->activeTexture(readU32());
+            break;
+        case CaptureOp::CreateFramebuffer: {
+            GLuint framebuffer = readU32();
+            framebuffers[framebuffer] = graphics->createFramebuffer();
+            break;
+        }
+        case CaptureOp::BindFramebuffer:
+            graphics->bindFramebuffer(lookup(framebuffers, readU32()));
+            break;
+        case CaptureOp::FramebufferTexture2D:
+            graphics->framebufferTexture2D(lookup(textures, readU32()));
+            break;
+        case CaptureOp::IsFramebufferComplete:
+            graphics->isFramebufferComplete();
+            break;
+        case CaptureOp::DeleteFramebuffer: {
+            GLuint framebuffer = readU32();
+            graphics->deleteFramebuffer(lookup(framebuffers, framebuffer));
+            framebuffers.erase(framebuffer);
+            break;
+        }
+        case CaptureOp::Viewport: {
+            int x = (int)readU32();
+            int y = (int)readU32();
+            int width = (int)readU32();
+            int height = (int)readU32();
+            graphics->viewport(x, y, width, height);
+            break;
+        }
+        case CaptureOp::SetupVertexArray: {
+            GLuint program = lookup(programs, readU32());
+            graphics->setupVertexArray(program, lookup(buffers, readU32()));
+            break;
+        }
+        case CaptureOp::EnableVertexAttribute: {
+            GLuint program = lookup(programs, readU32());
+            const std::string& name = readName();
+            int size = (int)readU32();
+            GLenum type = readU32();
+            int stride = (int)readU32();
+            int offset = (int)readU32();
+            graphics->enableVertexAttribute(program, name, size, type, stride, offset);
+            break;
+        }
+        case CaptureOp::DisableVertexAttribute: {
+            GLuint program = lookup(programs, readU32());
+            graphics->disableVertexAttribute(program, readName());
+            break;
+        }
+        case CaptureOp::DrawArrays: {
+            GLenum mode = readU32();
+            GLint first = (GLint)readU32();
+            int count = (int)readU32();
+            graphics->drawArrays(mode, first, count);
+            break;
+        }
+        case CaptureOp::DrawElements: {
+            GLenum mode = readU32();
+            int count = (int)readU32();
+            GLenum type = readU32();
+            size_t offset = readU32();
+            graphics->drawElements(mode, count, type, offset);
+            break;
+        }
+        case CaptureOp::Enable:
+            graphics->enable(readU32());
+            break;
+        case CaptureOp::Disable:
+            graphics->disable(readU32());
+            break;
+        case CaptureOp::Scissor: {
+            int x = (int)readU32();
+            int y = (int)readU32();
+            int width = (int)readU32();
+            int height = (int)readU32();
+            graphics->scissor(x, y, width, height);
+            break;
+        }
+        case CaptureOp::BlendFunc: {
+            GLenum sfactor = readU32();
+            GLenum dfactor = readU32();
+            graphics->blendFunc(sfactor, dfactor);
+            break;
+        }
+        case CaptureOp::BlendFuncSeparate: {
+            GLenum srcRGB = readU32();
+            GLenum dstRGB = readU32();
+            GLenum srcAlpha = readU32();
+            GLenum dstAlpha = readU32();
+            graphics->blendFuncSeparate(srcRGB, dstRGB, srcAlpha, dstAlpha);
+            break;
+        }
+        case CaptureOp::ClearColor: {
+            float r = readFloat();
+            float g = readFloat();
+            float b = readFloat();
+            float a = readFloat();
+            graphics->clearColor(r, g, b, a);
+            break;
+        }
+        case CaptureOp::Clear:
+            graphics->clear(readU32());
+            break;
+        case CaptureOp::WindowSize: {
+            int width = (int)readU32();
+            int height = (int)readU32();
+            if (resize) {
+                resize(width, height);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
\ No newline at end of file
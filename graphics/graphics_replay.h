@@ -0,0 +1,69 @@
+#pragma once
+
+#include "graphics_capture.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Time spent in one kind of call during a replay
+struct ReplayCallStats {
+    uint64_t count = 0;
+    double totalMs = 0.0;
+};
+
+// Plays a capture written by GraphicsCapture against any backend as fast as it
+// will go. The file is read into memory first so disk reads aren't timed.
+// Per-call times are CPU time in the backend; GL queues work, so a frame's time
+// only includes the GPU once the frame callback waits for it (a swap does).
+class GraphicsReplay {
+public:
+    GraphicsReplay();
+    
+    // Read and validate the header; records are checked while playing
+    bool load(const std::string& path);
+    
+    int getWindowWidth() const { return windowWidth; }
+    int getWindowHeight() const { return windowHeight; }
+    int getFrameCount() const { return frameCount; }
+    
+    // Issue every recorded call on graphics. endFrame runs at each frame boundary
+    // (present there), resize when the captured window was resized; either may be empty.
+    // Returns false on a truncated or corrupt stream.
+    bool play(GraphicsAPI* graphics, const std::function<void()>& endFrame,
+              const std::function<void(int width, int height)>& resize);
+    
+    // Results of the last play; frame 0 also holds startup work (shader compiles, uploads)
+    const std::vector<double>& getFrameTimes() const { return frameTimes; }
+    const ReplayCallStats& getCallStats(CaptureOp op) const { return callStats[(size_t)op]; }
+
+private:
+    std::vector<uint8_t> data;
+    size_t position;
+    bool truncated;
+    int windowWidth, windowHeight;
+    int frameCount;
+    
+    // Captured names and handles; GL gives each object type its own handle space
+    std::vector<std::string> names;
+    std::unordered_map<GLuint, GLuint> shaders;
+    std::unordered_map<GLuint, GLuint> programs;
+    std::unordered_map<GLuint, GLuint> buffers;
+    std::unordered_map<GLuint, GLuint> textures;
+    std::unordered_map<GLuint, GLuint> framebuffers;
+    
+    std::vector<double> frameTimes;
+    ReplayCallStats callStats[(size_t)CaptureOp::Count];
+    
+    uint32_t readU32();
+    float readFloat();
+    const uint8_t* readPayload(uint32_t& size);
+    const std::string& readName();
+    
+    // Captured handle to replayed handle; 0 stays 0
+    static GLuint lookup(const std::unordered_map<GLuint, GLuint>& handles, GLuint handle);
+    
+    // Decode one record's operands and issue its call
+    void execute(GraphicsAPI* graphics, CaptureOp op, const std::function<void(int width, int height)>& resize);
+};
\ No newline at end of file
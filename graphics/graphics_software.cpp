@@ -0,0 +1,999 @@
+#include "graphics_software.h"
+#include "../core/image_writer.h"
+#include "../core/job_system.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+static inline Float4 splat(float value) {
+    return Float4{value, value, value, value};
+}
+
+static inline Mask4 splatMask(int32_t value) {
+    return Mask4{value, value, value, value};
+}
+
+static inline bool anyLane(Mask4 mask) {
+    return (mask[0] | mask[1] | mask[2] | mask[3]) != 0;
+}
+
+static inline uint8_t toByte(float value) {
+    value = value < 0.0f ? 0.0f : (value > 1.0f ? 1.0f : value);
+    return (uint8_t)(value * 255.0f + 0.5f);
+}
+
+struct GraphicsSoftware::DrawState {
+    FragmentStage stage;
+    uint8_t* target;
+    int targetWidth;
+    const Texture* texture; // Text and sprite stages
+    const Texture* atlas;   // Terminal stage
+    const Texture* cells;
+    const Texture* palette;
+    float gridSize[2], cellSize[2], atlasSize[2], atlasCellSize[2], glyphSize[2];
+    float atlasColumns, atlasPadding;
+    bool blend;
+    GLenum srcRGB, dstRGB, srcAlpha, dstAlpha;
+};
+
+GraphicsSoftware::GraphicsSoftware(int width, int height, JobSystem* jobs)
+    : windowWidth(0), windowHeight(0), jobs(jobs), nextId(1), currentProgram(0), arrayBuffer(0), elementBuffer(0),
+      currentFramebuffer(0), activeUnit(0), viewportX(0), viewportY(0), viewportWidth(width), viewportHeight(height),
+      blendEnabled(false), scissorEnabled(false), scissorX(0), scissorY(0), scissorWidth(width), scissorHeight(height),
+      blendSrcRGB(GL_ONE), blendDstRGB(GL_ZERO), blendSrcAlpha(GL_ONE), blendDstAlpha(GL_ZERO),
+      clearR(0.0f), clearG(0.0f), clearB(0.0f), clearA(0.0f), warnedUnknownStage(false) {
+    std::fill(textureUnits, textureUnits + TEXTURE_UNITS, 0);
+    setWindowSize(width, height);
+}
+
+GraphicsSoftware::~GraphicsSoftware() {
+}
+
+void GraphicsSoftware::setWindowSize(int width, int height) {
+    windowWidth = std::max(1, width);
+    windowHeight = std::max(1, height);
+    windowPixels.assign((size_t)windowWidth * windowHeight * 4, 0);
+}
+
+bool GraphicsSoftware::saveFrame(const std::string& path) const {
+    return writeImage(path, windowWidth, windowHeight, windowPixels.data(), true);
+}
+
+GLuint GraphicsSoftware::compileShader(GLenum type, std::string_view source) {
+    (void)type;
+    GLuint shader = allocateId();
+    shaderSources[shader] = std::string(source);
+    return shader;
+}
+
+GLuint GraphicsSoftware::createProgram(GLuint vertexShader, GLuint fragmentShader) {
+    auto fragment = shaderSources.find(fragmentShader);
+    if (fragment == shaderSources.end()) {
+        printf("Software Program linking failed: unknown fragment shader\n");
+        return 0;
+    }
+    
+    // Fragment shaders name their built-in stage in a "// stage: <name>" line
+    Program program;
+    program.stage = parseStage(fragment->second);
+    
+    shaderSources.erase(vertexShader);
+    shaderSources.erase(fragmentShader);
+    
+    GLuint id = allocateId();
+    programs[id] = std::move(program);
+    return id;
+}
+
+void GraphicsSoftware::useProgram(GLuint program) {
+    currentProgram = program;
+}
+
+void GraphicsSoftware::deleteProgram(GLuint program) {
+    programs.erase(program);
+}
+
+GraphicsSoftware::Uniform* GraphicsSoftware::findUniform(GLuint program, const std::string& name) {
+    // Like GL, setting a uniform of a program that doesn't exist does nothing
+    auto found = programs.find(program);
+    return found != programs.end() ? &found->second.uniforms[name] : nullptr;
+}
+
+void GraphicsSoftware::setUniform1f(GLuint program, const std::string& name, float value) {
+    if (Uniform* uniform = findUniform(program, name)) {
+        uniform->values[0] = value;
+    }
+}
+
+void GraphicsSoftware::setUniform2f(GLuint program, const std::string& name, float x, float y) {
+    if (Uniform* uniform = findUniform(program, name)) {
+        uniform->values[0] = x;
+        uniform->values[1] = y;
+    }
+}
+
+void GraphicsSoftware::setUniform3f(GLuint program, const std::string& name, float x, float y, float z) {
+    if (Uniform* uniform = findUniform(program, name)) {
+        uniform->values[0] = x;
+        uniform->values[1] = y;
+        uniform->values[2] = z;
+    }
+}
+
+void GraphicsSoftware::setUniform1i(GLuint program, const std::string& name, int value) {
+    if (Uniform* uniform = findUniform(program, name)) {
+        uniform->integer = value;
+    }
+}
+
+void GraphicsSoftware::setUniformMatrix4fv(GLuint program, const std::string& name, const float* value) {
+    if (Uniform* uniform = findUniform(program, name)) {
+        std::memcpy(uniform->values, value, sizeof(float) * 16);
+    }
+}
+
+GLuint GraphicsSoftware::createBuffer() {
+    GLuint buffer = allocateId();
+    buffers[buffer];
+    return buffer;
+}
+
+void GraphicsSoftware::bindBuffer(GLenum target, GLuint buffer) {
+    if (target == GL_ARRAY_BUFFER) {
+        arrayBuffer = buffer;
+    } else if (target == GL_ELEMENT_ARRAY_BUFFER) {
+        elementBuffer = buffer;
+    }
+}
+
+void GraphicsSoftware::bufferData(GLenum target, size_t size, const void* data, GLenum usage) {
+    (void)usage;
+    GLuint buffer = target == GL_ELEMENT_ARRAY_BUFFER ? elementBuffer : arrayBuffer;
+    std::vector<uint8_t>& storage = buffers[buffer];
+    storage.resize(size);
+    if (data && size) {
+        std::memcpy(storage.data(), data, size);
+    }
+}
+
+void GraphicsSoftware::deleteBuffer(GLuint buffer) {
+    buffers.erase(buffer);
+}
+
+GLuint GraphicsSoftware::createTexture() {
+    GLuint texture = allocateId();
+    textures[texture];
+    return texture;
+}
+
+void GraphicsSoftware::bindTexture(GLenum target, GLuint texture) {
+    (void)target;
+    textureUnits[activeUnit] = texture;
+}
+
+void GraphicsSoftware::texImage2D(GLenum target, GLint level, GLint internalFormat,
+                                  int width, int height, GLenum format, GLenum type, const void* data) {
+    (void)target;
+    (void)level;
+    (void)internalFormat;
+    if (!isRgba8(format, type)) {
+        printf("Software texImage2D: only 8-bit RGBA textures are supported\n");
+        return;
+    }
+    auto found = textures.find(textureUnits[activeUnit]);
+    if (found == textures.end()) {
+        return;
+    }
+    Texture& texture = found->second;
+    texture.width = width;
+    texture.height = height;
+    texture.pixels.assign((size_t)width * height * 4, 0);
+    if (data) {
+        std::memcpy(texture.pixels.data(), data, texture.pixels.size());
+    }
+}
+
+void GraphicsSoftware::texSubImage2D(GLenum target, GLint level, int x, int y,
+                                     int width, int height, GLenum format, GLenum type, const void* data) {
+    (void)target;
+    (void)level;
+    if (!isRgba8(format, type)) {
+        printf("Software texSubImage2D: only 8-bit RGBA textures are supported\n");
+        return;
+    }
+    auto found = textures.find(textureUnits[activeUnit]);
+    if (found == textures.end()) {
+        return;
+    }
+    Texture& texture = found->second;
+    if (x < 0 || y < 0 || x + width > texture.width || y + height > texture.height) {
+        printf("Software texSubImage2D outside the texture\n");
+        return;
+    }
+    const uint8_t* source = (const uint8_t*)data;
+    for (int row = 0; row < height; row++) {
+        std::memcpy(&texture.pixels[((size_t)(y + row) * texture.width + x) * 4], source + (size_t)row * width * 4, (size_t)width * 4);
+    }
+}
+
+void GraphicsSoftware::texParameteri(GLenum target, GLenum pname, GLint param) {
+    (void)target;
+    auto found = textures.find(textureUnits[activeUnit]);
+    if (found != textures.end() && pname == GL_TEXTURE_MAG_FILTER) {
+        found->second.linear = param == GL_LINEAR;
+    }
+}
+
+void GraphicsSoftware::deleteTexture(GLuint texture) {
+    textures.erase(texture);
+    for (GLuint& unit : textureUnits) {
+        if (unit == texture) {
+            unit = 0;
+        }
+    }
+}
+
+void GraphicsSoftware::activeTexture(GLenum texture) {
+    activeUnit = std::min(std::max((int)(texture - GL_TEXTURE0), 0), TEXTURE_UNITS - 1);
+}
+
+GLuint GraphicsSoftware::createFramebuffer() {
+    GLuint framebuffer = allocateId();
+    framebuffers[framebuffer] = 0;
+    return framebuffer;
+}
+
+void GraphicsSoftware::bindFramebuffer(GLuint framebuffer) {
+    currentFramebuffer = framebuffer;
+}
+
+void GraphicsSoftware::framebufferTexture2D(GLuint texture) {
+    if (currentFramebuffer) {
+        framebuffers[currentFramebuffer] = texture;
+    }
+}
+
+bool GraphicsSoftware::isFramebufferComplete() {
+    int width, height;
+    return getTargetPixels(width, height) != nullptr;
+}
+
+void GraphicsSoftware::deleteFramebuffer(GLuint framebuffer) {
+    framebuffers.erase(framebuffer);
+    if (currentFramebuffer == framebuffer) {
+        currentFramebuffer = 0;
+    }
+}
+
+void GraphicsSoftware::viewport(int x, int y, int width, int height) {
+    viewportX = x;
+    viewportY = y;
+    viewportWidth = width;
+    viewportHeight = height;
+}
+
+void GraphicsSoftware::setupVertexArray(GLuint program, GLuint buffer) {
+    (void)program;
+    arrayBuffer = buffer;
+}
+
+int GraphicsSoftware::attributeLocation(const std::string& name) {
+    // Same fixed locations as the core profile shaders
+    if (name == "aPosition") return 0;
+    if (name == "aTexCoord") return 1;
+    if (name == "aColor") return 2;
+    return -1;
+}
+
+GraphicsSoftware::FragmentStage GraphicsSoftware::parseStage(const std::string& source) {
+    static const char tag[] = "// stage: ";
+    size_t start = source.find(tag);
+    if (start == std::string::npos) {
+        return FragmentStage::Unknown;
+    }
+    start += sizeof(tag) - 1;
+    size_t end = source.find_first_of(" \t\r\n", start);
+    std::string name = source.substr(start, end == std::string::npos ? std::string::npos : end - start);
+    if (name == "terminal") return FragmentStage::Terminal;
+    if (name == "text") return FragmentStage::Text;
+    if (name == "sprite") return FragmentStage::Sprite;
+    return FragmentStage::Unknown;
+}
+
+bool GraphicsSoftware::isRgba8(GLenum format, GLenum type) {
+    // Every texture in the engine is 8-bit RGBA, so nothing else is converted
+    return format == GL_RGBA && type == GL_UNSIGNED_BYTE;
+}
+
+void GraphicsSoftware::enableVertexAttribute(GLuint program, const std::string& name,
+                                             int size, GLenum type, int stride, int offset) {
+    (void)program;
+    int location = attributeLocation(name);
+    if (location < 0 || type != GL_FLOAT) {
+        return;
+    }
+    // Like glVertexAttribPointer, the attribute captures the buffer bound now
+    Attribute& attribute = attributes[location];
+    attribute.enabled = true;
+    attribute.buffer = arrayBuffer;
+    attribute.size = size;
+    attribute.stride = stride ? stride : size * (int)sizeof(float);
+    attribute.offset = offset;
+}
+
+void GraphicsSoftware::disableVertexAttribute(GLuint program, const std::string& name) {
+    (void)program;
+    int location = attributeLocation(name);
+    if (location >= 0) {
+        attributes[location].enabled = false;
+    }
+}
+
+void GraphicsSoftware::drawArrays(GLenum mode, GLint first, int count) {
+    if (mode != GL_TRIANGLES) {
+        return;
+    }
+    indexScratch.resize(count);
+    for (int i = 0; i < count; i++) {
+        indexScratch[i] = (uint32_t)(first + i);
+    }
+    drawTriangles(indexScratch.data(), count);
+}
+
+void GraphicsSoftware::drawElements(GLenum mode, int count, GLenum type, size_t offset) {
+    auto found = buffers.find(elementBuffer);
+    if (mode != GL_TRIANGLES || found == buffers.end()) {
+        return;
+    }
+    size_t indexSize = type == GL_UNSIGNED_INT ? 4 : 2;
+    const std::vector<uint8_t>& data = found->second;
+    if (offset + (size_t)count * indexSize > data.size()) {
+        printf("Software drawElements reads past the index buffer\n");
+        return;
+    }
+    indexScratch.resize(count);
+    for (int i = 0; i < count; i++) {
+        const uint8_t* index = &data[offset + i * indexSize];
+        if (indexSize == 4) {
+            uint32_t value;
+            std::memcpy(&value, index, 4);
+            indexScratch[i] = value;
+        } else {
+            uint16_t value;
+            std::memcpy(&value, index, 2);
+            indexScratch[i] = value;
+        }
+    }
+    drawTriangles(indexScratch.data(), count);
+}
+
+uint8_t* GraphicsSoftware::getTargetPixels(int& width, int& height) {
+    if (currentFramebuffer == 0) {
+        width = windowWidth;
+        height = windowHeight;
+        return windowPixels.data();
+    }
+    auto framebuffer = framebuffers.find(currentFramebuffer);
+    if (framebuffer == framebuffers.end()) {
+        return nullptr;
+    }
+    auto texture = textures.find(framebuffer->second);
+    if (texture == textures.end() || texture->second.pixels.empty()) {
+        return nullptr;
+    }
+    width = texture->second.width;
+    height = texture->second.height;
+    return texture->second.pixels.data();
+}
+
+void GraphicsSoftware::drawTriangles(const uint32_t* indices, int count) {
+    auto programEntry = programs.find(currentProgram);
+    if (programEntry == programs.end()) {
+        return;
+    }
+    Program& program = programEntry->second;
+    if (program.stage == FragmentStage::Unknown) {
+        if (!warnedUnknownStage) {
+            printf("Software renderer: draw with an unrecognized shader program skipped\n");
+            warnedUnknownStage = true;
+        }
+        return;
+    }
+    
+    int targetWidth, targetHeight;
+    uint8_t* target = getTargetPixels(targetWidth, targetHeight);
+    if (!target) {
+        return;
+    }
+    
+    // Pixels outside the viewport, scissor box and target are never touched
+    int clipX0 = std::max(viewportX, 0);
+    int clipY0 = std::max(viewportY, 0);
+    int clipX1 = std::min(viewportX + viewportWidth, targetWidth);
+    int clipY1 = std::min(viewportY + viewportHeight, targetHeight);
+    if (scissorEnabled) {
+        clipX0 = std::max(clipX0, scissorX);
+        clipY0 = std::max(clipY0, scissorY);
+        clipX1 = std::min(clipX1, scissorX + scissorWidth);
+        clipY1 = std::min(clipY1, scissorY + scissorHeight);
+    }
+    if (clipX0 >= clipX1 || clipY0 >= clipY1 || count < 3) {
+        return;
+    }
+    
+    // Vertex stage: projection * model for every referenced vertex
+    static const float identity[16] = {1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1};
+    auto matrix = [&](const char* name) {
+        auto uniform = program.uniforms.find(name);
+        return uniform == program.uniforms.end() ? identity : uniform->second.values;
+    };
+    const float* projection = matrix("uProjection");
+    const float* model = matrix("uModel");
+    
+    uint32_t vertexCount = *std::max_element(indices, indices + count) + 1;
+    screenVertices.resize(vertexCount);
+    for (uint32_t i = 0; i < vertexCount; i++) {
+        float values[MAX_ATTRIBUTES][4] = {{0, 0, 0, 1}, {0, 0, 0, 1}, {0, 0, 0, 1}};
+        for (int location = 0; location < MAX_ATTRIBUTES; location++) {
+            const Attribute& attribute = attributes[location];
+            if (!attribute.enabled) {
+                continue;
+            }
+            auto buffer = buffers.find(attribute.buffer);
+            size_t start = (size_t)attribute.offset + (size_t)i * attribute.stride;
+            if (buffer == buffers.end() || start + attribute.size * sizeof(float) > buffer->second.size()) {
+                continue;
+            }
+            std::memcpy(values[location], &buffer->second[start], attribute.size * sizeof(float));
+        }
+        
+        float x = values[0][0], y = values[0][1];
+        float modelX = model[0] * x + model[4] * y + model[12];
+        float modelY = model[1] * x + model[5] * y + model[13];
+        float modelZ = model[2] * x + model[6] * y + model[14];
+        float modelW = model[3] * x + model[7] * y + model[15];
+        float clipX = projection[0] * modelX + projection[4] * modelY + projection[8] * modelZ + projection[12] * modelW;
+        float clipY = projection[1] * modelX + projection[5] * modelY + projection[9] * modelZ + projection[13] * modelW;
+        float clipW = projection[3] * modelX + projection[7] * modelY + projection[11] * modelZ + projection[15] * modelW;
+        if (clipW == 0.0f) {
+            clipW = 1.0f;
+        }
+        
+        ScreenVertex& vertex = screenVertices[i];
+        vertex.x = viewportX + (clipX / clipW + 1.0f) * 0.5f * viewportWidth;
+        vertex.y = viewportY + (clipY / clipW + 1.0f) * 0.5f * viewportHeight;
+        vertex.u = values[1][0];
+        vertex.v = values[1][1];
+        vertex.r = values[2][0];
+        vertex.g = values[2][1];
+        vertex.b = values[2][2];
+        vertex.a = values[2][3];
+    }
+    
+    // Set up triangles and bin them into the tiles they overlap
+    int tilesX = (targetWidth + TILE_SIZE - 1) / TILE_SIZE;
+    int tilesY = (targetHeight + TILE_SIZE - 1) / TILE_SIZE;
+    if ((int)tileBins.size() < tilesX * tilesY) {
+        tileBins.resize(tilesX * tilesY);
+    }
+    for (int tile : activeTiles) {
+        tileBins[tile].clear();
+    }
+    activeTiles.clear();
+    triangles.clear();
+    for (int i = 0; i + 2 < count; i += 3) {
+        Triangle triangle;
+        if (!setupTriangle(screenVertices[indices[i]], screenVertices[indices[i + 1]], screenVertices[indices[i + 2]],
+                           clipX0, clipY0, clipX1, clipY1, triangle)) {
+            continue;
+        }
+        int index = (int)triangles.size();
+        triangles.push_back(triangle);
+        for (int tileY = triangle.minY / TILE_SIZE; tileY <= triangle.maxY / TILE_SIZE; tileY++) {
+            for (int tileX = triangle.minX / TILE_SIZE; tileX <= triangle.maxX / TILE_SIZE; tileX++) {
+                std::vector<int>& bin = tileBins[tileY * tilesX + tileX];
+                if (bin.empty()) {
+                    activeTiles.push_back(tileY * tilesX + tileX);
+                }
+                bin.push_back(index);
+            }
+        }
+    }
+    if (activeTiles.empty()) {
+        return;
+    }
+    
+    auto texture = [&](const char* sampler) -> const Texture* {
+        auto uniform = program.uniforms.find(sampler);
+        int unit = uniform == program.uniforms.end() ? 0 : uniform->second.integer;
+        auto found = textures.find(textureUnits[std::min(std::max(unit, 0), TEXTURE_UNITS - 1)]);
+        return found == textures.end() || found->second.pixels.empty() ? nullptr : &found->second;
+    };
+    auto vec2 = [&](const char* name, float out[2]) {
+        auto uniform = program.uniforms.find(name);
+        out[0] = uniform == program.uniforms.end() ? 0.0f : uniform->second.values[0];
+        out[1] = uniform == program.uniforms.end() ? 0.0f : uniform->second.values[1];
+    };
+    
+    DrawState state;
+    state.stage = program.stage;
+    state.target = target;
+    state.targetWidth = targetWidth;
+    state.texture = texture("uTexture");
+    state.atlas = texture("uAtlas");
+    state.cells = texture("uCells");
+    state.palette = texture("uPalette");
+    vec2("uGridSize", state.gridSize);
+    vec2("uCellSize", state.cellSize);
+    vec2("uAtlasSize", state.atlasSize);
+    vec2("uAtlasCellSize", state.atlasCellSize);
+    vec2("uGlyphSize", state.glyphSize);
+    float scalars[2];
+    vec2("uAtlasColumns", scalars);
+    state.atlasColumns = std::max(scalars[0], 1.0f);
+    vec2("uAtlasPadding", scalars);
+    state.atlasPadding = scalars[0];
+    state.blend = blendEnabled;
+    state.srcRGB = blendSrcRGB;
+    state.dstRGB = blendDstRGB;
+    state.srcAlpha = blendSrcAlpha;
+    state.dstAlpha = blendDstAlpha;
+    
+    // Tiles are independent and keep their triangles in submission order, so
+    // blending matches GL's ordering
+    if (jobs && activeTiles.size() > 1) {
+        jobs->parallelFor(activeTiles.size(), 1, [this, &state](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                rasterizeTile(state, activeTiles[i]);
+            }
+        });
+    } else {
+        for (int tile : activeTiles) {
+            rasterizeTile(state, tile);
+        }
+    }
+}
+
+bool GraphicsSoftware::setupTriangle(const ScreenVertex& v0, const ScreenVertex& v1, const ScreenVertex& v2,
+                                     int clipX0, int clipY0, int clipX1, int clipY1, Triangle& triangle) {
+    // Counter-clockwise winding so every edge function is positive inside; no face culling
+    const ScreenVertex* vertices[3] = {&v0, &v1, &v2};
+    float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+    if (std::fabs(area) < 1e-8f) {
+        return false;
+    }
+    if (area < 0.0f) {
+        std::swap(vertices[1], vertices[2]);
+        area = -area;
+    }
+    
+    float minX = std::min(std::min(v0.x, v1.x), v2.x);
+    float maxX = std::max(std::max(v0.x, v1.x), v2.x);
+    float minY = std::min(std::min(v0.y, v1.y), v2.y);
+    float maxY = std::max(std::max(v0.y, v1.y), v2.y);
+    // Pixels whose centers fall inside the bounds
+    triangle.minX = std::max(clipX0, (int)std::ceil(minX - 0.5f));
+    triangle.minY = std::max(clipY0, (int)std::ceil(minY - 0.5f));
+    triangle.maxX = std::min(clipX1 - 1, (int)std::floor(maxX - 0.5f));
+    triangle.maxY = std::min(clipY1 - 1, (int)std::floor(maxY - 0.5f));
+    if (triangle.minX > triangle.maxX || triangle.minY > triangle.maxY) {
+        return false;
+    }
+    
+    // Edge i is opposite vertex i; its function is the signed area of (p, j, k)
+    float invArea = 1.0f / area;
+    for (int i = 0; i < 6; i++) {
+        triangle.plane[i][0] = triangle.plane[i][1] = triangle.plane[i][2] = 0.0f;
+    }
+    for (int i = 0; i < 3; i++) {
+        const ScreenVertex& a = *vertices[(i + 1) % 3];
+        const ScreenVertex& b = *vertices[(i + 2) % 3];
+        triangle.edgeA[i] = a.y - b.y;
+        triangle.edgeB[i] = b.x - a.x;
+        triangle.edgeC[i] = a.x * b.y - a.y * b.x;
+        
+        // Pixels exactly on a shared edge belong to one triangle: the top or left one
+        float dx = b.x - a.x, dy = b.y - a.y;
+        triangle.topLeft[i] = dy < 0.0f || (dy == 0.0f && dx < 0.0f);
+        
+        // Attribute planes are the barycentric blend of the vertex values
+        const ScreenVertex& vertex = *vertices[i];
+        const float attributes[6] = {vertex.u, vertex.v, vertex.r, vertex.g, vertex.b, vertex.a};
+        for (int attribute = 0; attribute < 6; attribute++) {
+            float weight = attributes[attribute] * invArea;
+            triangle.plane[attribute][0] += triangle.edgeA[i] * weight;
+            triangle.plane[attribute][1] += triangle.edgeB[i] * weight;
+            triangle.plane[attribute][2] += triangle.edgeC[i] * weight;
+        }
+    }
+    return true;
+}
+
+
+// Texel coordinate of four lanes: index of the texel at or left of t, clamped to [0, size)
+static inline Mask4 clampedFloor(Float4 t, int size) {
+    Mask4 index = __builtin_convertvector(t, Mask4);
+    index += (Mask4)(t < __builtin_convertvector(index, Float4)); // Truncation rounds negatives up
+    Mask4 zero = splatMask(0);
+    Mask4 last = splatMask(size - 1);
+    index &= ~(index < zero);
+    Mask4 over = index > last;
+    return (index & ~over) | (last & over);
+}
+
+void GraphicsSoftware::sample4(const Texture* texture, Float4 u, Float4 v, Float4 out[4], bool alphaOnly) {
+    if (!texture) {
+        out[0] = out[1] = out[2] = splat(0.0f);
+        out[3] = splat(1.0f);
+        return;
+    }
+    
+    // Addressing runs on all four lanes; only the texel fetches are scalar
+    int width = texture->width, height = texture->height;
+    const uint8_t* pixels = texture->pixels.data();
+    int firstChannel = alphaOnly ? 3 : 0;
+    if (!texture->linear) {
+        Mask4 index = clampedFloor(v * splat((float)height), height) * splatMask(width) + clampedFloor(u * splat((float)width), width);
+        for (int c = firstChannel; c < 4; c++) {
+            for (int lane = 0; lane < 4; lane++) {
+                out[c][lane] = pixels[(size_t)index[lane] * 4 + c];
+            }
+            out[c] *= splat(1.0f / 255.0f);
+        }
+        return;
+    }
+    
+    Float4 tx = u * splat((float)width) - splat(0.5f);
+    Float4 ty = v * splat((float)height) - splat(0.5f);
+    Mask4 ix = __builtin_convertvector(tx, Mask4);
+    ix += (Mask4)(tx < __builtin_convertvector(ix, Float4));
+    Mask4 iy = __builtin_convertvector(ty, Mask4);
+    iy += (Mask4)(ty < __builtin_convertvector(iy, Float4));
+    Float4 wx = tx - __builtin_convertvector(ix, Float4);
+    Float4 wy = ty - __builtin_convertvector(iy, Float4);
+    Float4 fx = __builtin_convertvector(ix, Float4), fy = __builtin_convertvector(iy, Float4);
+    Mask4 x0 = clampedFloor(fx, width), x1 = clampedFloor(fx + splat(1.0f), width);
+    Mask4 y0 = clampedFloor(fy, height) * splatMask(width), y1 = clampedFloor(fy + splat(1.0f), height) * splatMask(width);
+    Mask4 i00 = y0 + x0, i10 = y0 + x1, i01 = y1 + x0, i11 = y1 + x1;
+    for (int c = firstChannel; c < 4; c++) {
+        Float4 t00, t10, t01, t11;
+        for (int lane = 0; lane < 4; lane++) {
+            t00[lane] = pixels[(size_t)i00[lane] * 4 + c];
+            t10[lane] = pixels[(size_t)i10[lane] * 4 + c];
+            t01[lane] = pixels[(size_t)i01[lane] * 4 + c];
+            t11[lane] = pixels[(size_t)i11[lane] * 4 + c];
+        }
+        Float4 top = t00 + (t10 - t00) * wx;
+        Float4 bottom = t01 + (t11 - t01) * wx;
+        out[c] = (top + (bottom - top) * wy) * splat(1.0f / 255.0f);
+    }
+}
+
+void GraphicsSoftware::shadeTerminal(const DrawState& state, float gridX, float gridY, float out[4]) {
+    out[0] = out[1] = out[2] = out[3] = 0.0f;
+    if (!state.cells || !state.palette || state.cellSize[0] <= 0.0f || state.cellSize[1] <= 0.0f) {
+        return;
+    }
+    
+    // Cell record: atlas cell (lo, hi), foreground and background palette indices
+    float cellX = std::min(std::floor(gridX / state.cellSize[0]), state.gridSize[0] - 1.0f);
+    float cellY = std::min(std::floor(gridY / state.cellSize[1]), state.gridSize[1] - 1.0f);
+    float localX = gridX - cellX * state.cellSize[0];
+    float localY = gridY - cellY * state.cellSize[1];
+    int column = std::min(std::max((int)cellX, 0), state.cells->width - 1);
+    int row = std::min(std::max((int)cellY, 0), state.cells->height - 1);
+    const uint8_t* data = &state.cells->pixels[((size_t)row * state.cells->width + column) * 4];
+    float glyph = data[0] + data[1] * 256.0f;
+    const uint8_t* foreground = &state.palette->pixels[std::min((int)data[2], state.palette->width - 1) * 4];
+    const uint8_t* background = &state.palette->pixels[std::min((int)data[3], state.palette->width - 1) * 4];
+    
+    // Glyph pixels sit at the top-left of their atlas cell, one texel per screen pixel
+    float atlasX = std::fmod(glyph, state.atlasColumns) * state.atlasCellSize[0] + state.atlasPadding + localX;
+    float atlasY = std::floor(glyph / state.atlasColumns) * state.atlasCellSize[1] + state.atlasPadding + localY;
+    float inside = (localX <= state.glyphSize[0] && localY <= state.glyphSize[1]) ? 1.0f : 0.0f;
+    Float4 texel[4];
+    sample4(state.atlas, splat(atlasX / std::max(state.atlasSize[0], 1.0f)), splat(atlasY / std::max(state.atlasSize[1], 1.0f)), texel, true);
+    float coverage = texel[3][0] * inside * (foreground[3] / 255.0f);
+    
+    float backgroundAlpha = background[3] / 255.0f;
+    float alpha = coverage + backgroundAlpha * (1.0f - coverage);
+    for (int c = 0; c < 3; c++) {
+        float color = foreground[c] / 255.0f * coverage + background[c] / 255.0f * backgroundAlpha * (1.0f - coverage);
+        out[c] = alpha > 0.0f ? color / alpha : color;
+    }
+    out[3] = alpha;
+}
+
+static inline Float4 blendFactor(GLenum factor, Float4 sourceAlpha) {
+    switch (factor) {
+        case GL_ONE:
+            return splat(1.0f);
+        case GL_SRC_ALPHA:
+            return sourceAlpha;
+        case GL_ONE_MINUS_SRC_ALPHA:
+            return splat(1.0f) - sourceAlpha;
+        default:
+            return splat(0.0f);
+    }
+}
+
+// One 8-bit channel of four RGBA pixels as floats in [0, 1]
+static inline Float4 unpackChannel(Mask4 pixels, int shift) {
+    Mask4 channel = (pixels >> splatMask(shift)) & splatMask(0xFF);
+    return __builtin_convertvector(channel, Float4) * splat(1.0f / 255.0f);
+}
+
+// Four floats clamped to [0, 1], rounded to 8 bits and moved into a channel position
+static inline Mask4 packChannel(Float4 values, int shift) {
+    Mask4 channel = __builtin_convertvector(values * splat(255.0f) + splat(0.5f), Mask4);
+    Mask4 zero = splatMask(0);
+    Mask4 full = splatMask(255);
+    Mask4 low = channel < zero;
+    channel = channel & ~low;
+    Mask4 high = channel > full;
+    channel = (channel & ~high) | (full & high);
+    return channel << splatMask(shift);
+}
+
+void GraphicsSoftware::rasterizeTile(const DrawState& state, int tile) {
+    int tilesX = (state.targetWidth + TILE_SIZE - 1) / TILE_SIZE;
+    int tileX0 = (tile % tilesX) * TILE_SIZE;
+    int tileY0 = (tile / tilesX) * TILE_SIZE;
+    const Float4 laneOffsets = {0.5f, 1.5f, 2.5f, 3.5f};
+    
+    for (int index : tileBins[tile]) {
+        const Triangle& triangle = triangles[index];
+        int x0 = std::max(triangle.minX, tileX0);
+        int y0 = std::max(triangle.minY, tileY0);
+        int x1 = std::min(triangle.maxX + 1, tileX0 + TILE_SIZE);
+        int y1 = std::min(triangle.maxY + 1, tileY0 + TILE_SIZE);
+        
+        for (int y = y0; y < y1; y++) {
+            Float4 py = splat(y + 0.5f);
+            uint8_t* row = state.target + (size_t)y * state.targetWidth * 4;
+            
+            // Each edge bounds the row's covered centers on one side; the span is
+            // widened to whole pixels and the edge tests below stay exact
+            float spanStart = (float)x0, spanEnd = (float)x1;
+            bool emptyRow = false;
+            for (int e = 0; e < 3; e++) {
+                float constant = triangle.edgeB[e] * (y + 0.5f) + triangle.edgeC[e];
+                if (triangle.edgeA[e] > 0.0f) {
+                    spanStart = std::max(spanStart, -constant / triangle.edgeA[e]);
+                } else if (triangle.edgeA[e] < 0.0f) {
+                    spanEnd = std::min(spanEnd, -constant / triangle.edgeA[e]);
+                } else if (constant < 0.0f) {
+                    emptyRow = true;
+                }
+            }
+            int rowX0 = std::max(x0, (int)std::floor(spanStart - 0.5f));
+            int rowX1 = std::min(x1, (int)std::ceil(spanEnd - 0.5f) + 1);
+            if (emptyRow) {
+                continue;
+            }
+            
+            for (int x = rowX0; x < rowX1; x += 4) {
+                // Coverage of four pixel centers against the three edges
+                Float4 px = splat((float)x) + laneOffsets;
+                Mask4 mask = px < splat((float)rowX1);
+                for (int e = 0; e < 3; e++) {
+                    Float4 edge = splat(triangle.edgeA[e]) * px + splat(triangle.edgeB[e]) * py + splat(triangle.edgeC[e]);
+                    mask &= triangle.topLeft[e] ? (edge >= splat(0.0f)) : (edge > splat(0.0f));
+                }
+                if (!anyLane(mask)) {
+                    continue;
+                }
+                
+                // Interpolated varyings: u, v, r, g, b, a
+                Float4 varyings[6];
+                for (int i = 0; i < 6; i++) {
+                    varyings[i] = splat(triangle.plane[i][0]) * px + splat(triangle.plane[i][1]) * py + splat(triangle.plane[i][2]);
+                }
+                
+                // Fragment stage
+                Float4 sourceR, sourceG, sourceB, sourceA;
+                if (state.stage == FragmentStage::Terminal) {
+                    for (int lane = 0; lane < 4; lane++) {
+                        float color[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                        if (mask[lane]) {
+                            shadeTerminal(state, varyings[0][lane], varyings[1][lane], color);
+                        }
+                        sourceR[lane] = color[0];
+                        sourceG[lane] = color[1];
+                        sourceB[lane] = color[2];
+                        sourceA[lane] = color[3];
+                    }
+                } else if (state.stage == FragmentStage::Text) {
+                    // Color from the vertex, coverage from the atlas
+                    Float4 texel[4];
+                    sample4(state.texture, varyings[0], varyings[1], texel, true);
+                    sourceR = varyings[2];
+                    sourceG = varyings[3];
+                    sourceB = varyings[4];
+                    sourceA = varyings[5] * texel[3];
+                } else {
+                    // Premultiplied texture times premultiplied color
+                    Float4 texel[4];
+                    sample4(state.texture, varyings[0], varyings[1], texel, false);
+                    sourceR = texel[0] * varyings[2];
+                    sourceG = texel[1] * varyings[3];
+                    sourceB = texel[2] * varyings[4];
+                    sourceA = texel[3] * varyings[5];
+                }
+                
+                // Blend against the target, one channel of four pixels per vector
+                uint8_t* pixels = row + (size_t)x * 4;
+                bool fullBlock = x + 4 <= rowX1;
+                Mask4 dest = splatMask(0);
+                if (fullBlock) {
+                    std::memcpy(&dest, pixels, 16);
+                } else {
+                    std::memcpy(&dest, pixels, (size_t)(rowX1 - x) * 4);
+                }
+                Float4 outR = sourceR, outG = sourceG, outB = sourceB, outA = sourceA;
+                if (state.blend) {
+                    Float4 destR = unpackChannel(dest, 0), destG = unpackChannel(dest, 8);
+                    Float4 destB = unpackChannel(dest, 16), destA = unpackChannel(dest, 24);
+                    Float4 sourceFactor = blendFactor(state.srcRGB, sourceA);
+                    Float4 destFactor = blendFactor(state.dstRGB, sourceA);
+                    outR = sourceR * sourceFactor + destR * destFactor;
+                    outG = sourceG * sourceFactor + destG * destFactor;
+                    outB = sourceB * sourceFactor + destB * destFactor;
+                    outA = sourceA * blendFactor(state.srcAlpha, sourceA) + destA * blendFactor(state.dstAlpha, sourceA);
+                }
+                Mask4 packed = packChannel(outR, 0) | packChannel(outG, 8) | packChannel(outB, 16) | packChannel(outA, 24);
+                Mask4 result = (packed & mask) | (dest & ~mask);
+                if (fullBlock) {
+                    std::memcpy(pixels, &result, 16);
+                } else {
+                    std::memcpy(pixels, &result, (size_t)(rowX1 - x) * 4);
+                }
+            }
+        }
+    }
+}
+
+void GraphicsSoftware::enable(GLenum cap) {
+    if (cap == GL_BLEND) {
+        blendEnabled = true;
+    } else if (cap == GL_SCISSOR_TEST) {
+        scissorEnabled = true;
+    }
+}
+
+void GraphicsSoftware::disable(GLenum cap) {
+    if (cap == GL_BLEND) {
+        blendEnabled = false;
+    } else if (cap == GL_SCISSOR_TEST) {
+        scissorEnabled = false;
+    }
+}
+
+void GraphicsSoftware::scissor(int x, int y, int width, int height) {
+    scissorX = x;
+    scissorY = y;
+    scissorWidth = width;
+    scissorHeight = height;
+}
+
+void GraphicsSoftware::blendFunc(GLenum sfactor, GLenum dfactor) {
+    blendFuncSeparate(sfactor, dfactor, sfactor, dfactor);
+}
+
+void GraphicsSoftware::blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) {
+    blendSrcRGB = srcRGB;
+    blendDstRGB = dstRGB;
+    blendSrcAlpha = srcAlpha;
+    blendDstAlpha = dstAlpha;
+}
+
+void GraphicsSoftware::clearColor(float r, float g, float b, float a) {
+    clearR = r;
+    clearG = g;
+    clearB = b;
+    clearA = a;
+}
+
+void GraphicsSoftware::clear(GLuint mask) {
+    int width, height;
+    uint8_t* target = getTargetPixels(width, height);
+    if (!(mask & GL_COLOR_BUFFER_BIT) || !target) {
+        return;
+    }
+    
+    // Like GL, clears ignore the viewport but respect the scissor box
+    int x0 = 0, y0 = 0, x1 = width, y1 = height;
+    if (scissorEnabled) {
+        x0 = std::max(x0, scissorX);
+        y0 = std::max(y0, scissorY);
+        x1 = std::min(x1, scissorX + scissorWidth);
+        y1 = std::min(y1, scissorY + scissorHeight);
+    }
+    const uint8_t color[4] = {toByte(clearR), toByte(clearG), toByte(clearB), toByte(clearA)};
+    for (int y = y0; y < y1; y++) {
+        uint8_t* pixel = target + ((size_t)y * width + x0) * 4;
+        for (int x = x0; x < x1; x++, pixel += 4) {
+            std::memcpy(pixel, color, 4);
+        }
+    }
+}
+
+void GraphicsSoftware::readPixels(int x, int y, int width, int height, void* pixels) {
+    int targetWidth, targetHeight;
+    const uint8_t* target = getTargetPixels(targetWidth, targetHeight);
+    uint8_t* out = static_cast<uint8_t*>(pixels);
+    for (int row = 0; row < height; row++) {
+        uint8_t* line = out + (size_t)row * width * 4;
+        int sourceY = y + row;
+        int x0 = std::max(x, 0), x1 = std::min(x + width, targetWidth);
+        if (!target || sourceY < 0 || sourceY >= targetHeight || x0 > x || x1 < x + width) {
+            std::memset(line, 0, (size_t)width * 4); // Outside the target reads as zero
+        }
+        if (target && sourceY >= 0 && sourceY < targetHeight && x0 < x1) {
+            std::memcpy(line + (x0 - x) * 4, target + ((size_t)sourceY * targetWidth + x0) * 4, (size_t)(x1 - x0) * 4);
+        }
+    }
+}
+
+// Drawing finishes before each call returns, so readback is immediate and fences are always signaled
+
+bool GraphicsSoftware::supportsAsyncReadback() const {
+    return true;
+}
+
+GLuint GraphicsSoftware::createPixelBuffer(size_t size) {
+    GLuint buffer = allocateId();
+    buffers[buffer].resize(size);
+    return buffer;
+}
+
+void GraphicsSoftware::readPixelsToBuffer(GLuint buffer, int x, int y, int width, int height) {
+    auto storage = buffers.find(buffer);
+    if (storage != buffers.end() && storage->second.size() >= (size_t)width * height * 4) {
+        readPixels(x, y, width, height, storage->second.data());
+    }
+}
+
+bool GraphicsSoftware::getPixelBufferData(GLuint buffer, size_t size, void* data) {
+    auto storage = buffers.find(buffer);
+    if (storage == buffers.end() || storage->second.size() < size) {
+        return false;
+    }
+    std::memcpy(data, storage->second.data(), size);
+    return true;
+}
+
+GLsync GraphicsSoftware::createFence() {
+    return nullptr;
+}
+
+bool GraphicsSoftware::isFenceSignaled(GLsync fence) {
+    (void)fence;
+    return true;
+}
+
+void GraphicsSoftware::deleteFence(GLsync fence) {
+    (void)fence;
+}
+
+std::string GraphicsSoftware::getRendererName() const {
+    return "Software";
+}
+
+bool GraphicsSoftware::supportsVertexArrays() const {
+    return true;
+}
+
+bool GraphicsSoftware::supportsUint32Indices() const {
+    return true;
+}
+
+std::string GraphicsSoftware::getVertexShaderPath(const std::string& baseName) const {
+    // Sources are only read to pick the fragment stage, so either dialect works
+    return "shaders/" + baseName + "_vertex_core.glsl";
+}
+
+std::string GraphicsSoftware::getFragmentShaderPath(const std::string& baseName) const {
+    return "shaders/" + baseName + "_fragment_core.glsl";
+}
\ No newline at end of file
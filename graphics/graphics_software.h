@@ -0,0 +1,211 @@
+#pragma once
+
+#include "graphics_api.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class JobSystem;
+
+// Four lanes of floats or lane masks; GCC and Clang lower these to SSE or NEON
+typedef float Float4 __attribute__((vector_size(16)));
+typedef int32_t Mask4 __attribute__((vector_size(16)));
+
+// GraphicsAPI on the CPU for machines without a GPU (thumbnails, reports).
+// Draws go into an in-memory RGBA framebuffer with GL's conventions (row 0 at
+// the bottom, same blending and texture coordinates). GLSL isn't interpreted:
+// each program runs the built-in fragment stage (text, sprite or terminal)
+// named by a "// stage: <name>" line in its fragment source. Each draw is
+// binned into tiles that are rasterized in parallel on the job system, four
+// pixels at a time with vector math (SSE or NEON, whichever the compiler targets).
+class GraphicsSoftware : public GraphicsAPI {
+public:
+    // The window framebuffer starts at width x height; jobs may be null (single-threaded)
+    GraphicsSoftware(int width, int height, JobSystem* jobs = nullptr);
+    ~GraphicsSoftware() override;
+    
+    GLuint compileShader(GLenum type, std::string_view source) override;
+    GLuint createProgram(GLuint vertexShader, GLuint fragmentShader) override;
+    void useProgram(GLuint program) override;
+    void deleteProgram(GLuint program) override;
+    
+    void setUniform1f(GLuint program, const std::string& name, float value) override;
+    void setUniform2f(GLuint program, const std::string& name, float x, float y) override;
+    void setUniform3f(GLuint program, const std::string& name, float x, float y, float z) override;
+    void setUniform1i(GLuint program, const std::string& name, int value) override;
+    void setUniformMatrix4fv(GLuint program, const std::string& name, const float* value) override;
+    
+    GLuint createBuffer() override;
+    void bindBuffer(GLenum target, GLuint buffer) override;
+    void bufferData(GLenum target, size_t size, const void* data, GLenum usage) override;
+    void deleteBuffer(GLuint buffer) override;
+    
+    GLuint createTexture() override;
+    void bindTexture(GLenum target, GLuint texture) override;
+    void texImage2D(GLenum target, GLint level, GLint internalFormat,
+                   int width, int height, GLenum format, GLenum type, const void* data) override;
+    void texSubImage2D(GLenum target, GLint level, int x, int y,
+                      int width, int height, GLenum format, GLenum type, const void* data) override;
+    void texParameteri(GLenum target, GLenum pname, GLint param) override;
+    void deleteTexture(GLuint texture) override;
+    void activeTexture(GLenum texture) override;
+    
+    GLuint createFramebuffer() override;
+    void bindFramebuffer(GLuint framebuffer) override;
+    void framebufferTexture2D(GLuint texture) override;
+    bool isFramebufferComplete() override;
+    void deleteFramebuffer(GLuint framebuffer) override;
+    void viewport(int x, int y, int width, int height) override;
+    
+    void setupVertexArray(GLuint program, GLuint buffer) override;
+    void enableVertexAttribute(GLuint program, const std::string& name,
+                             int size, GLenum type, int stride, int offset) override;
+    void disableVertexAttribute(GLuint program, const std::string& name) override;
+    
+    void drawArrays(GLenum mode, GLint first, int count) override;
+    void drawElements(GLenum mode, int count, GLenum type, size_t offset) override;
+    
+    void enable(GLenum cap) override;
+    void disable(GLenum cap) override;
+    void scissor(int x, int y, int width, int height) override;
+    void blendFunc(GLenum sfactor, GLenum dfactor) override;
+    void blendFuncSeparate(GLenum srcRGB, GLenum dstRGB, GLenum srcAlpha, GLenum dstAlpha) override;
+    void clearColor(float r, float g, float b, float a) override;
+    void clear(GLuint mask) override;
+    
+    void readPixels(int x, int y, int width, int height, void* pixels) override;
+    bool supportsAsyncReadback() const override;
+    GLuint createPixelBuffer(size_t size) override;
+    void readPixelsToBuffer(GLuint buffer, int x, int y, int width, int height) override;
+    bool getPixelBufferData(GLuint buffer, size_t size, void* data) override;
+    GLsync createFence() override;
+    bool isFenceSignaled(GLsync fence) override;
+    void deleteFence(GLsync fence) override;
+    
+    std::string getRendererName() const override;
+    bool supportsVertexArrays() const override;
+    bool supportsUint32Indices() const override;
+    
+    std::string getVertexShaderPath(const std::string& baseName) const override;
+    std::string getFragmentShaderPath(const std::string& baseName) const override;
+    
+    // Resize the window framebuffer; contents are cleared
+    void setWindowSize(int width, int height);
+    
+    // Window framebuffer: width x height RGBA, bottom row first
+    const uint8_t* getPixels() const { return windowPixels.data(); }
+    int getWidth() const { return windowWidth; }
+    int getHeight() const { return windowHeight; }
+    
+    // Save the window framebuffer as a .png or .tga, top row first like a screenshot
+    bool saveFrame(const std::string& path) const;
+
+private:
+    static constexpr int TILE_SIZE = 64;
+    static constexpr int TEXTURE_UNITS = 8;
+    static constexpr int MAX_ATTRIBUTES = 3; // aPosition, aTexCoord, aColor
+    
+    enum class FragmentStage { Unknown, Text, Sprite, Terminal };
+    
+    struct Texture {
+        int width = 0, height = 0;
+        std::vector<uint8_t> pixels;
+        bool linear = true; // Magnification filter; minification isn't distinguished
+    };
+    
+    struct Uniform {
+        float values[16] = {};
+        int integer = 0;
+    };
+    
+    struct Program {
+        FragmentStage stage = FragmentStage::Unknown;
+        std::unordered_map<std::string, Uniform> uniforms;
+    };
+    
+    struct Attribute {
+        bool enabled = false;
+        GLuint buffer = 0;
+        int size = 0;
+        int stride = 0;
+        int offset = 0;
+    };
+    
+    // Vertex after projection, in framebuffer pixels
+    struct ScreenVertex {
+        float x, y;
+        float u, v;
+        float r, g, b, a;
+    };
+    
+    // Triangle set up for rasterization: edge and attribute planes f(x, y) = A x + B y + C
+    struct Triangle {
+        float edgeA[3], edgeB[3], edgeC[3];
+        bool topLeft[3];
+        float plane[6][3]; // u, v, r, g, b, a
+        int minX, minY, maxX, maxY;
+    };
+    
+    // Everything a tile needs to shade one draw
+    struct DrawState;
+    
+    int windowWidth, windowHeight;
+    std::vector<uint8_t> windowPixels;
+    JobSystem* jobs;
+    
+    // Object tables; ids start at 1 so 0 stays "none" as in GL
+    GLuint nextId;
+    std::unordered_map<GLuint, std::string> shaderSources;
+    std::unordered_map<GLuint, Program> programs;
+    std::unordered_map<GLuint, std::vector<uint8_t>> buffers;
+    std::unordered_map<GLuint, Texture> textures;
+    std::unordered_map<GLuint, GLuint> framebuffers; // Framebuffer -> color texture
+    
+    // Bound state
+    GLuint currentProgram;
+    GLuint arrayBuffer;
+    GLuint elementBuffer;
+    GLuint currentFramebuffer;
+    int activeUnit;
+    GLuint textureUnits[TEXTURE_UNITS];
+    Attribute attributes[MAX_ATTRIBUTES];
+    int viewportX, viewportY, viewportWidth, viewportHeight;
+    bool blendEnabled, scissorEnabled;
+    int scissorX, scissorY, scissorWidth, scissorHeight;
+    GLenum blendSrcRGB, blendDstRGB, blendSrcAlpha, blendDstAlpha;
+    float clearR, clearG, clearB, clearA;
+    bool warnedUnknownStage;
+    
+    // Per-draw scratch, kept to avoid reallocating every frame
+    std::vector<uint32_t> indexScratch;
+    std::vector<ScreenVertex> screenVertices;
+    std::vector<Triangle> triangles;
+    std::vector<std::vector<int>> tileBins;
+    std::vector<int> activeTiles;
+    
+    GLuint allocateId() { return nextId++; }
+    static int attributeLocation(const std::string& name);
+    static FragmentStage parseStage(const std::string& source);
+    static bool isRgba8(GLenum format, GLenum type);
+    
+    // Storage for a uniform of an existing program; null for unknown programs
+    Uniform* findUniform(GLuint program, const std::string& name);
+    
+    // Color buffer of the bound framebuffer; null when incomplete
+    uint8_t* getTargetPixels(int& width, int& height);
+    
+    // Shared by drawArrays and drawElements: indices select vertices of the bound attributes
+    void drawTriangles(const uint32_t* indices, int count);
+    bool setupTriangle(const ScreenVertex& v0, const ScreenVertex& v1, const ScreenVertex& v2,
+                       int clipX0, int clipY0, int clipX1, int clipY1, Triangle& triangle);
+    void rasterizeTile(const DrawState& state, int tile);
+    
+    // Bilinear or nearest lookup of four pixels with clamp-to-edge, like the samplers the
+    // renderers configure; out is r, g, b, a per lane. A missing texture reads as opaque
+    // black, as an incomplete one does in GL. alphaOnly leaves the color channels unset.
+    static void sample4(const Texture* texture, Float4 u, Float4 v, Float4 out[4], bool alphaOnly);
+    
+    // Terminal fragment stage for one pixel at a grid position
+    static void shadeTerminal(const DrawState& state, float gridX, float gridY, float out[4]);
+};
\ No newline at end of file
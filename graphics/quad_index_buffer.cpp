@@ -0,0 +1,56 @@
+#include "quad_index_buffer.h"
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+QuadIndexBuffer::QuadIndexBuffer(GraphicsAPI* graphics, GpuResources* resources) : graphics(graphics), resources(resources) {
+}
+
+QuadIndexBuffer::~QuadIndexBuffer() {
+    cleanup();
+}
+
+bool QuadIndexBuffer::initialize() {
+    std::vector<uint16_t> indices(MAX_QUADS * INDICES_PER_QUAD);
+    for (int quad = 0; quad < MAX_QUADS; quad++) {
+        uint16_t base = (uint16_t)(quad * VERTICES_PER_QUAD);
+        uint16_t* out = &indices[quad * INDICES_PER_QUAD];
+        out[0] = base;
+        out[1] = base + 1;
+        out[2] = base + 2;
+        out[3] = base;
+        out[4] = base + 2;
+        out[5] = base + 3;
+    }
+    
+    buffer = resources->createBuffer();
+    if (!resources->get(buffer)) {
+        printf("Failed to create quad index buffer\n");
+        return false;
+    }
+    
+    // Element array bindings are vertex array state on core profiles, so make sure one is bound
+    graphics->setupVertexArray(0, 0);
+    graphics->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, resources->get(buffer));
+    graphics->bufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(uint16_t), indices.data(), GL_STATIC_DRAW);
+    resources->setSize(buffer, indices.size() * sizeof(uint16_t));
+    return true;
+}
+
+void QuadIndexBuffer::bind() {
+    graphics->bindBuffer(GL_ELEMENT_ARRAY_BUFFER, resources->get(buffer));
+}
+
+void QuadIndexBuffer::drawQuads(int quadCount) {
+    if (quadCount > MAX_QUADS) {
+        printf("Quad draw truncated: %d > %d\n", quadCount, MAX_QUADS);
+        quadCount = MAX_QUADS;
+    }
+    graphics->drawElements(GL_TRIANGLES, quadCount * INDICES_PER_QUAD, GL_UNSIGNED_SHORT, 0);
+}
+
+void QuadIndexBuffer::cleanup() {
+    if (resources) {
+        resources->destroy(buffer);
+    }
+}
\ No newline at end of file
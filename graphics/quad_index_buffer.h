@@ -0,0 +1,35 @@
+#pragma once
+
+#include "graphics_api.h"
+#include "gpu_resources.h"
+
+// Static index buffer shared by every quad renderer (text, sprites). Quads are
+// submitted as 4 vertices each (top-left, top-right, bottom-right, bottom-left)
+// and expanded to two triangles by the indices, so vertex data is 4/6 of what
+// drawArrays needed and the post-transform cache reuses shared corners.
+class QuadIndexBuffer {
+public:
+    // 16-bit indices address 65536 vertices
+    static constexpr int MAX_QUADS = 16384;
+    static constexpr int VERTICES_PER_QUAD = 4;
+    static constexpr int INDICES_PER_QUAD = 6;
+    
+    QuadIndexBuffer(GraphicsAPI* graphics, GpuResources* resources);
+    ~QuadIndexBuffer();
+    
+    // Build and upload the indices once
+    bool initialize();
+    
+    // Bind as GL_ELEMENT_ARRAY_BUFFER; call after the vertex buffer/VAO is set up
+    void bind();
+    
+    // Draw quadCount quads from the bound vertex buffer (at most MAX_QUADS)
+    void drawQuads(int quadCount);
+    
+    void cleanup();
+
+private:
+    GraphicsAPI* graphics;
+    GpuResources* resources;
+    BufferHandle buffer;
+};
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "render_target.h"
+#include <iostream>
+
+// Innermost target between begin() and end()
+static RenderTarget* boundTarget = nullptr;
+
+RenderTarget::RenderTarget(GraphicsAPI* graphics, GpuResources* resources) : graphics(graphics), resources(resources),
+      externalTexture(0), width(0), height(0), viewportWidth(0), viewportHeight(0), previous(nullptr) {
+}
+
+RenderTarget::~RenderTarget() {
+    cleanup();
+}
+
+bool RenderTarget::initialize(int targetWidth, int targetHeight) {
+    cleanup();
+    
+    // Linear filtering so targets can be drawn scaled
+    texture = resources->createTexture();
+    graphics->bindTexture(GL_TEXTURE_2D, resources->get(texture));
+    graphics->texImage2D(GL_TEXTURE_2D, 0, GL_RGBA, targetWidth, targetHeight, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    resources->setSize(texture, GpuResources::getTextureBytes(targetWidth, targetHeight));
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    return attach(targetWidth, targetHeight, resources->get(texture));
+}
+
+bool RenderTarget::initialize(int targetWidth, int targetHeight, GLuint colorTexture) {
+    cleanup();
+    externalTexture = colorTexture;
+    return attach(targetWidth, targetHeight, colorTexture);
+}
+
+bool RenderTarget::attach(int targetWidth, int targetHeight, GLuint colorTexture) {
+    width = targetWidth;
+    height = targetHeight;
+    framebuffer = resources->createFramebuffer();
+    graphics->bindFramebuffer(resources->get(framebuffer));
+    graphics->framebufferTexture2D(colorTexture);
+    bool complete = graphics->isFramebufferComplete();
+    graphics->bindFramebuffer(0);
+    
+    if (!complete) {
+        printf("Render target %dx%d is incomplete\n", width, height);
+        cleanup();
+        return false;
+    }
+    return true;
+}
+
+void RenderTarget::begin() {
+    begin(width, height);
+}
+
+void RenderTarget::begin(int targetViewportWidth, int targetViewportHeight) {
+    previous = boundTarget;
+    boundTarget = this;
+    viewportWidth = targetViewportWidth;
+    viewportHeight = targetViewportHeight;
+    graphics->bindFramebuffer(resources->get(framebuffer));
+    graphics->viewport(0, 0, viewportWidth, viewportHeight);
+}
+
+void RenderTarget::end(int windowWidth, int windowHeight) {
+    boundTarget = previous;
+    if (previous) {
+        graphics->bindFramebuffer(resources->get(previous->framebuffer));
+        graphics->viewport(0, 0, previous->viewportWidth, previous->viewportHeight);
+    } else {
+        graphics->bindFramebuffer(0);
+        graphics->viewport(0, 0, windowWidth, windowHeight);
+    }
+    previous = nullptr;
+}
+
+void RenderTarget::cleanup() {
+    // Released once the GPU is done with them, so a resize mid-frame is safe
+    if (resources) {
+        resources->destroy(framebuffer);
+        resources->destroy(texture);
+    }
+    externalTexture = 0;
+    width = 0;
+    height = 0;
+}
\ No newline at end of file
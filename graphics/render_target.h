@@ -0,0 +1,48 @@
+#pragma once
+
+#include "gpu_resources.h"
+#include "graphics_api.h"
+
+// Offscreen color buffer: a framebuffer with an RGBA texture attached. Draws
+// between begin() and end() land in the texture, which can then be sampled
+// like any other. Row 0 of the texture is the bottom of what was drawn.
+// Targets nest: end() returns to whichever target was bound before begin().
+class RenderTarget {
+public:
+    RenderTarget(GraphicsAPI* graphics, GpuResources* resources);
+    ~RenderTarget();
+    
+    // Create (or recreate at a new size) the texture and framebuffer
+    bool initialize(int width, int height);
+    
+    // Draw into a texture owned elsewhere; only the framebuffer belongs to the target
+    bool initialize(int width, int height, GLuint colorTexture);
+    
+    // Redirect drawing into the texture and set the viewport to cover it
+    void begin();
+    
+    // Same, but only into the bottom-left viewportWidth x viewportHeight corner
+    void begin(int viewportWidth, int viewportHeight);
+    
+    // Return to the previously bound target, or to the window with the given viewport
+    void end(int windowWidth, int windowHeight);
+    
+    GLuint getTexture() const { return externalTexture ? externalTexture : resources->get(texture); }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    
+    void cleanup();
+
+private:
+    GraphicsAPI* graphics;
+    GpuResources* resources;
+    FramebufferHandle framebuffer;
+    TextureHandle texture;
+    GLuint externalTexture; // Set instead of texture when the color buffer isn't ours
+    int width, height;
+    int viewportWidth, viewportHeight;
+    RenderTarget* previous; // Target bound when begin() was called
+    
+    // Create the framebuffer around the color texture
+    bool attach(int targetWidth, int targetHeight, GLuint colorTexture);
+};
\ No newline at end of file
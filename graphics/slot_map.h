@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Typed reference into a SlotMap. The tag keeps handles of different resource
+// types from being mixed up; the generation makes a handle to a removed value
+// fail lookups instead of finding whatever reused its slot.
+template<typename Tag>
+struct ResourceHandle {
+    static constexpr uint32_t INVALID = 0xFFFFFFFF;
+    
+    uint32_t index = INVALID;
+    uint32_t generation = 0;
+    
+    bool isNull() const { return index == INVALID; }
+    bool operator==(const ResourceHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const ResourceHandle& other) const { return !(*this == other); }
+};
+
+// Values addressed by generation-checked handles. Values are stored densely for
+// iteration; a slot table maps a handle's index to the value's position in O(1).
+// Free slots form a list threaded through the table, and removing a value swaps
+// the last one into its place.
+template<typename T, typename Handle>
+class SlotMap {
+public:
+    SlotMap() : freeHead(NONE) {}
+    
+    Handle insert(T value) {
+        Handle handle;
+        if (freeHead != NONE) {
+            handle.index = freeHead;
+            freeHead = slots[freeHead].position;
+        } else {
+            handle.index = (uint32_t)slots.size();
+            slots.push_back(Slot{0, 0});
+        }
+        Slot& slot = slots[handle.index];
+        slot.position = (uint32_t)values.size();
+        handle.generation = slot.generation;
+        values.push_back(std::move(value));
+        owners.push_back(handle.index);
+        return handle;
+    }
+    
+    // False when the handle is stale; the handle and any copies of it go stale either way
+    bool remove(Handle handle) {
+        if (!get(handle)) {
+            return false;
+        }
+        Slot& slot = slots[handle.index];
+        uint32_t last = (uint32_t)values.size() - 1;
+        if (slot.position != last) {
+            values[slot.position] = std::move(values[last]);
+            owners[slot.position] = owners[last];
+            slots[owners[last]].position = slot.position;
+        }
+        values.pop_back();
+        owners.pop_back();
+        
+        slot.generation++;
+        slot.position = freeHead;
+        freeHead = handle.index;
+        return true;
+    }
+    
+    T* get(Handle handle) {
+        if (handle.index >= slots.size() || slots[handle.index].generation != handle.generation) {
+            return nullptr;
+        }
+        return &values[slots[handle.index].position];
+    }
+    
+    const T* get(Handle handle) const {
+        return const_cast<SlotMap*>(this)->get(handle);
+    }
+    
+    // Live values, in no particular order
+    size_t size() const { return values.size(); }
+    T* data() { return values.data(); }
+    const T* data() const { return values.data(); }
+
+private:
+    static constexpr uint32_t NONE = 0xFFFFFFFF;
+    
+    struct Slot {
+        uint32_t position;   // Value position while live, next free slot while free
+        uint32_t generation; // Bumped on removal
+    };
+    
+    std::vector<Slot> slots;
+    std::vector<T> values;
+    std::vector<uint32_t> owners; // Slot of each value, to fix up the slot a removal moves
+    uint32_t freeHead;
+};
\ No newline at end of file
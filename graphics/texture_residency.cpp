@@ -0,0 +1,187 @@
+#include "texture_residency.h"
+#include <algorithm>
+#include <iostream>
+
+TextureResidency::TextureResidency(GraphicsAPI* graphics, GpuResources* resources, size_t budgetBytes)
+    : graphics(graphics), resources(resources), budgetBytes(budgetBytes), residentBytes(0), frameIndex(0), frameEvictions(0),
+      frameRestores(0), lastFrameEvictions(0), lastFrameRestores(0), totalEvictions(0), totalRestores(0) {
+}
+
+TextureResidency::~TextureResidency() {
+    cleanup();
+}
+
+ResidentTexture TextureResidency::createFromPixels(int width, int height, std::vector<uint8_t> pixels) {
+    if (pixels.size() != GpuResources::getTextureBytes(width, height)) {
+        printf("Resident texture %dx%d has %zu bytes of pixels\n", width, height, pixels.size());
+        return ResidentTexture();
+    }
+    return add(width, height, std::move(pixels), nullptr);
+}
+
+ResidentTexture TextureResidency::createFromCallback(int width, int height, TextureRegenerator regenerate) {
+    return add(width, height, std::vector<uint8_t>(), std::move(regenerate));
+}
+
+void TextureResidency::destroy(ResidentTexture& handle) {
+    Entry* entry = entries.get(handle);
+    if (entry) {
+        if (!entry->texture.isNull()) {
+            residentBytes -= entry->bytes;
+            resources->destroy(entry->texture);
+        }
+        entries.remove(handle);
+    }
+    handle = ResidentTexture();
+}
+
+GLuint TextureResidency::use(ResidentTexture handle) {
+    Entry* entry = entries.get(handle);
+    if (!entry) {
+        return 0;
+    }
+    entry->lastUse = frameIndex;
+    if (entry->texture.isNull()) {
+        makeRoom(entry->bytes);
+        makeResident(*entry);
+    }
+    return resources->get(entry->texture);
+}
+
+bool TextureResidency::isResident(ResidentTexture handle) const {
+    const Entry* entry = entries.get(handle);
+    return entry && !entry->texture.isNull();
+}
+
+void TextureResidency::setEvictable(ResidentTexture handle, bool evictable) {
+    Entry* entry = entries.get(handle);
+    if (entry) {
+        entry->evictable = evictable;
+    }
+}
+
+void TextureResidency::endFrame() {
+    // Textures of the frame just drawn are likely needed by the next one
+    makeRoom(0);
+    frameIndex++;
+    lastFrameEvictions = frameEvictions;
+    lastFrameRestores = frameRestores;
+    frameEvictions = 0;
+    frameRestores = 0;
+}
+
+TextureResidencyStats TextureResidency::getStats() const {
+    TextureResidencyStats stats;
+    stats.budgetBytes = budgetBytes;
+    stats.otherBytes = getUsedBytes() - residentBytes;
+    const Entry* values = entries.data();
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (values[i].texture.isNull()) {
+            stats.evictedCount++;
+            stats.evictedBytes += values[i].bytes;
+        } else {
+            stats.residentCount++;
+            stats.residentBytes += values[i].bytes;
+        }
+    }
+    stats.frameEvictions = lastFrameEvictions;
+    stats.frameRestores = lastFrameRestores;
+    stats.totalEvictions = totalEvictions;
+    stats.totalRestores = totalRestores;
+    return stats;
+}
+
+void TextureResidency::printReport() const {
+    TextureResidencyStats stats = getStats();
+    printf("Texture residency: %.2f of %.2f MB budget\n", (stats.residentBytes + stats.otherBytes) / (1024.0 * 1024.0),
+           stats.budgetBytes / (1024.0 * 1024.0));
+    printf("  %-14s %6s  %10.2f KB\n", "other", "", stats.otherBytes / 1024.0);
+    printf("  %-14s %6zu  %10.2f KB\n", "resident", stats.residentCount, stats.residentBytes / 1024.0);
+    printf("  %-14s %6zu  %10.2f KB\n", "evicted", stats.evictedCount, stats.evictedBytes / 1024.0);
+    printf("  evictions %zu last frame, %zu total; restores %zu last frame, %zu total\n", stats.frameEvictions,
+           stats.totalEvictions, stats.frameRestores, stats.totalRestores);
+}
+
+void TextureResidency::cleanup() {
+    if (!resources) {
+        return;
+    }
+    Entry* values = entries.data();
+    for (size_t i = 0; i < entries.size(); i++) {
+        resources->destroy(values[i].texture);
+    }
+    entries = SlotMap<Entry, ResidentTexture>();
+    residentBytes = 0;
+    resources = nullptr;
+}
+
+ResidentTexture TextureResidency::add(int width, int height, std::vector<uint8_t> pixels, TextureRegenerator regenerate) {
+    Entry entry;
+    entry.width = width;
+    entry.height = height;
+    entry.bytes = GpuResources::getTextureBytes(width, height);
+    entry.lastUse = 0;
+    entry.evictable = true;
+    entry.evicted = false;
+    entry.pixels = std::move(pixels);
+    entry.regenerate = std::move(regenerate);
+    return entries.insert(std::move(entry));
+}
+
+void TextureResidency::makeResident(Entry& entry) {
+    entry.texture = resources->createTexture();
+    graphics->bindTexture(GL_TEXTURE_2D, resources->get(entry.texture));
+    graphics->texImage2D(GL_TEXTURE_2D, 0, GL_RGBA, entry.width, entry.height, GL_RGBA, GL_UNSIGNED_BYTE,
+                         entry.pixels.empty() ? nullptr : entry.pixels.data());
+    resources->setSize(entry.texture, entry.bytes);
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    residentBytes += entry.bytes;
+    if (entry.evicted) {
+        entry.evicted = false;
+        frameRestores++;
+        totalRestores++;
+    }
+    if (entry.regenerate) {
+        entry.regenerate(resources->get(entry.texture));
+    }
+}
+
+void TextureResidency::evict(Entry& entry) {
+    // GpuResources holds the delete until the GPU is done with earlier frames
+    resources->destroy(entry.texture);
+    residentBytes -= entry.bytes;
+    entry.evicted = true;
+    frameEvictions++;
+    totalEvictions++;
+}
+
+size_t TextureResidency::getUsedBytes() const {
+    return resources ? resources->getLiveBytes(GpuResourceType::Texture) : 0;
+}
+
+void TextureResidency::makeRoom(size_t incoming) {
+    if (getUsedBytes() + incoming <= budgetBytes) {
+        return;
+    }
+    
+    // Anything used this frame may already be referenced by queued draws
+    candidates.clear();
+    Entry* values = entries.data();
+    for (size_t i = 0; i < entries.size(); i++) {
+        if (values[i].evictable && !values[i].texture.isNull() && values[i].lastUse < frameIndex) {
+            candidates.push_back(&values[i]);
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const Entry* a, const Entry* b) {
+        return a->lastUse < b->lastUse;
+    });
+    for (Entry* entry : candidates) {
+        if (getUsedBytes() + incoming <= budgetBytes) {
+            break;
+        }
+        evict(*entry);
+    }
+}
\ No newline at end of file
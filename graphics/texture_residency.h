@@ -0,0 +1,112 @@
+#pragma once
+
+#include "gpu_resources.h"
+#include "graphics_api.h"
+#include "slot_map.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+struct ResidentTextureTag;
+typedef ResourceHandle<ResidentTextureTag> ResidentTexture;
+
+// Fills the contents of a texture that was just (re)created. Storage of the
+// registered size is already allocated and the texture is bound to GL_TEXTURE_2D.
+// It must not register or destroy resident textures.
+typedef std::function<void(GLuint texture)> TextureRegenerator;
+
+struct TextureResidencyStats {
+    size_t budgetBytes = 0;
+    size_t otherBytes = 0; // Textures owned elsewhere (atlases, render targets), charged against the budget
+    size_t residentCount = 0;
+    size_t residentBytes = 0;
+    size_t evictedCount = 0;  // Registered but not on the GPU right now
+    size_t evictedBytes = 0;
+    size_t frameEvictions = 0; // During the last completed frame
+    size_t frameRestores = 0;
+    size_t totalEvictions = 0;
+    size_t totalRestores = 0;
+};
+
+// Keeps registered textures within a GPU memory budget. Each texture is created
+// on its first use and remembers the frame it was last used in; when the
+// textures go over budget, the least recently used evictable textures are
+// deleted, and re-created on their next use from a CPU copy of their pixels or
+// a regeneration callback. Textures used in the current frame are never
+// evicted, so a frame that needs more than the budget goes over it rather than
+// drawing garbage. The budget covers every live texture in GpuResources, so
+// atlases and render targets owned elsewhere take room from the cached ones.
+class TextureResidency {
+public:
+    TextureResidency(GraphicsAPI* graphics, GpuResources* resources, size_t budgetBytes);
+    ~TextureResidency();
+    
+    TextureResidency(const TextureResidency&) = delete;
+    TextureResidency& operator=(const TextureResidency&) = delete;
+    
+    // Register an RGBA8 texture restored from a CPU copy of its pixels
+    ResidentTexture createFromPixels(int width, int height, std::vector<uint8_t> pixels);
+    
+    // Register an RGBA8 texture whose contents regenerate produces
+    ResidentTexture createFromCallback(int width, int height, TextureRegenerator regenerate);
+    
+    // Unregister and release the texture; stale and null handles are ignored
+    void destroy(ResidentTexture& handle);
+    
+    // The texture for drawing this frame, created first if it isn't resident.
+    // 0 for a null or stale handle.
+    GLuint use(ResidentTexture handle);
+    
+    bool isResident(ResidentTexture handle) const;
+    
+    // Non-evictable textures stay resident once used and still count against the budget
+    void setEvictable(ResidentTexture handle, bool evictable);
+    
+    // A lower budget takes effect at the next endFrame
+    void setBudget(size_t bytes) { budgetBytes = bytes; }
+    size_t getBudget() const { return budgetBytes; }
+    
+    // Once per frame: evict down to the budget, sparing what this frame used,
+    // and start counting the next frame
+    void endFrame();
+    
+    TextureResidencyStats getStats() const;
+    void printReport() const;
+    
+    // Release every texture; handles go stale
+    void cleanup();
+
+private:
+    struct Entry {
+        TextureHandle texture; // Null while not resident
+        int width, height;
+        size_t bytes;
+        uint64_t lastUse;
+        bool evictable;
+        bool evicted; // Created before, so the next creation is a restore
+        std::vector<uint8_t> pixels; // CPU copy, empty when a callback regenerates it
+        TextureRegenerator regenerate;
+    };
+    
+    GraphicsAPI* graphics;
+    GpuResources* resources;
+    SlotMap<Entry, ResidentTexture> entries;
+    std::vector<Entry*> candidates; // Reused by makeRoom
+    size_t budgetBytes;
+    size_t residentBytes;
+    uint64_t frameIndex;
+    size_t frameEvictions, frameRestores;
+    size_t lastFrameEvictions, lastFrameRestores;
+    size_t totalEvictions, totalRestores;
+    
+    ResidentTexture add(int width, int height, std::vector<uint8_t> pixels, TextureRegenerator regenerate);
+    void makeResident(Entry& entry);
+    void evict(Entry& entry);
+    
+    // Live texture bytes in GpuResources, registered or not
+    size_t getUsedBytes() const;
+    
+    // Evict least recently used textures until incoming more bytes fit the budget
+    void makeRoom(size_t incoming);
+};
\ No newline at end of file
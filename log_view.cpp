@@ -0,0 +1,94 @@
+#include "log_view.h"
+#include <algorithm>
+#include <cmath>
+
+LogView::LogView(GraphicsAPI* graphics, TextRenderer* renderer, size_t maxLines, size_t arenaBytes)
+    : graphics(graphics), renderer(renderer), buffer(maxLines, arenaBytes), following(true), bottomLine(0), viewportWidth(0), viewportHeight(0) {
+}
+
+void LogView::append(std::string_view text) {
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = std::min(text.find('\n', start), text.size());
+        if (end == text.size() && start == end && start > 0) {
+            break; // Trailing newline doesn't start another line
+        }
+        buffer.append(text.substr(start, end - start));
+        start = end + 1;
+    }
+}
+
+void LogView::scroll(int lines) {
+    if (buffer.getLineCount() == 0) {
+        return;
+    }
+    
+    uint64_t first = buffer.getFirstLineNumber();
+    uint64_t last = buffer.getTotalLines() - 1;
+    int64_t target = (int64_t)getBottomLine() - lines;
+    target = std::max<int64_t>(target, (int64_t)first);
+    
+    following = target >= (int64_t)last;
+    bottomLine = following ? last : (uint64_t)target;
+}
+
+void LogView::scrollToEnd() {
+    following = true;
+}
+
+void LogView::setViewportSize(int width, int height) {
+    viewportWidth = width;
+    viewportHeight = height;
+}
+
+void LogView::draw(float x, float y, float width, float height) {
+    float lineHeight = renderer->getLineHeight();
+    if (buffer.getLineCount() == 0 || lineHeight <= 0.0f) {
+        return;
+    }
+    
+    // Clip to the part of the panel inside the window; a panel entirely outside draws nothing
+    int left = std::max(0, (int)std::floor(x));
+    int right = std::min(viewportWidth, (int)std::ceil(x + width));
+    int bottom = std::max(0, viewportHeight - (int)std::ceil(y + height));
+    int top = std::min(viewportHeight, viewportHeight - (int)std::floor(y));
+    if (left >= right || bottom >= top) {
+        return;
+    }
+    
+    // Text queued before the panel must not be clipped by it
+    renderer->flush();
+    graphics->enable(GL_SCISSOR_TEST);
+    graphics->scissor(left, bottom, right - left, top - bottom);
+    
+    // Bottom-up from the anchored line; a partial line at the top is clipped
+    uint64_t first = buffer.getFirstLineNumber();
+    uint64_t line = getBottomLine();
+    int visible = (int)std::ceil(height / lineHeight);
+    for (int row = 0; row < visible; row++) {
+        float lineY = y + height - (row + 1) * lineHeight;
+        renderer->renderText(buffer.getLine((size_t)(line - first)), x, lineY);
+        if (line == first) {
+            break;
+        }
+        line--;
+    }
+    
+    renderer->flush();
+    graphics->disable(GL_SCISSOR_TEST);
+}
+
+void LogView::clear() {
+    buffer.clear();
+    following = true;
+}
+
+uint64_t LogView::getBottomLine() const {
+    uint64_t last = buffer.getTotalLines() - 1;
+    if (following) {
+        return last;
+    }
+    
+    // Lines scrolled to may have been dropped since; stop at the oldest kept
+    return std::min(std::max(bottomLine, buffer.getFirstLineNumber()), last);
+}
\ No newline at end of file
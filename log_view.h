@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "core/log_buffer.h"
+#include "text_renderer.h"
+#include "graphics/graphics_api.h"
+
+// Scrolling log panel over a LogBuffer. Only the lines inside the panel are
+// queued for drawing, clipped to its edges with the scissor test, so the cost
+// of a frame depends on the panel height rather than on how much history is kept.
+// Appending and scrolling never allocate.
+class LogView {
+public:
+    LogView(GraphicsAPI* graphics, TextRenderer* renderer, size_t maxLines = 100000, size_t arenaBytes = 8 * 1024 * 1024);
+    
+    // Append text, one line per newline; ANSI color escapes are kept and drawn
+    void append(std::string_view text);
+    
+    // Positive lines scroll back into history. Scrolled back, the view stays on
+    // the same lines as new ones arrive; at the bottom it follows the newest.
+    void scroll(int lines);
+    void scrollToEnd();
+    bool isFollowing() const { return following; }
+    
+    // The framebuffer size places the scissor rectangle and clips it to the window
+    void setViewportSize(int width, int height);
+    
+    // Draw the visible lines inside the rectangle; flushes the renderer before and after
+    void draw(float x, float y, float width, float height);
+    
+    const LogBuffer& getBuffer() const { return buffer; }
+    
+    void clear();
+
+private:
+    GraphicsAPI* graphics;
+    TextRenderer* renderer;
+    LogBuffer buffer;
+    bool following;
+    uint64_t bottomLine; // Absolute number of the bottom line while scrolled back
+    int viewportWidth, viewportHeight;
+    
+    // Absolute number of the line at the bottom of the panel
+    uint64_t getBottomLine() const;
+};
\ No newline at end of file
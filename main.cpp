@@ -1,9 +1,31 @@
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
 #include <iostream>
 #include <memory>
+#include <string>
+#include <vector>
 #include <SDL2/SDL_ttf.h>
 #include "platform/platform_factory.h"
 #include "graphics/graphics_factory.h"
 #include "text_renderer.h"
+#include "terminal_grid.h"
+#include "log_view.h"
+#include "quad_renderer.h"
+#include "cached_layer.h"
+#include "dynamic_resolution.h"
+#include "graphics/frame_graph.h"
+#include "graphics/gpu_resources.h"
+#include "graphics/graphics_capture.h"
+#include "graphics/texture_residency.h"
+#include "graphics/frame_recorder.h"
+#include "assets/asset_pack.h"
+#include "assets/asset_loader.h"
+#include "core/entity_registry.h"
+#include "core/job_system.h"
+#include "core/spatial_grid.h"
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten.h>
@@ -15,18 +37,96 @@ using namespace std;
 const int WINDOW_WIDTH = 1000;
 const int WINDOW_HEIGHT = 1000;
 
+// Packed assets, built with tools/asset_packer; loose files are used when absent
+const char* ASSET_PACK_PATH = "assets.pak";
+const char* FONT_PATH = "DejaVuSansMono-Bold.ttf";
+
+// Pre-baked atlas from tools/font_baker; skips FreeType at startup when present
+const char* BAKED_FONT_PATH = "DejaVuSansMono-Bold.ejfa";
+
+// Sprites in the entity stress test move in pixels per second
+struct Velocity {
+    float dx, dy;
+};
+
+const int STRESS_SPRITES = 10000;
+const int STRESS_LABELS = 10000;
+
+// Stress entities spread over a canvas this many windows wide and tall; the
+// spatial grid leaves the off-screen ones out of the frame
+const int STRESS_CANVAS_SCALE = 3;
+
+// Wrapped paragraphs on the static panel, laid out together once the font is resident
+const std::vector<std::string> PANEL_PARAGRAPHS = {
+    "Text is measured from cached glyph metrics, wrapped to the panel width and aligned without rasterizing it first.",
+};
+const float PANEL_TEXT_WIDTH = 900.0f;
+
+// Cached textures are evicted beyond this; WebGL contexts get less room
+const int DESKTOP_TEXTURE_BUDGET_MB = 256;
+const int WEB_TEXTURE_BUDGET_MB = 64;
+
 // Application state
 struct AppState {
+    std::unique_ptr<JobSystem> jobs;
     std::unique_ptr<Platform> platform;
+    std::unique_ptr<AssetPack> assets;
     std::unique_ptr<GraphicsAPI> graphics;
+    std::unique_ptr<GpuResources> resources;
+    std::unique_ptr<TextureResidency> residency;
+    std::unique_ptr<AssetLoader> loader;
+    std::unique_ptr<QuadIndexBuffer> quadIndices;
     std::unique_ptr<TextRenderer> textRenderer;
+    std::unique_ptr<TerminalGrid> console;
+    std::unique_ptr<LogView> log;
+    std::unique_ptr<QuadRenderer> quadRenderer;
+    std::unique_ptr<CachedLayer> staticPanel;
+    std::unique_ptr<DynamicResolution> resolution;
+    std::unique_ptr<FrameGraph> frameGraph;
+    std::unique_ptr<FrameRecorder> recorder;
+    EntityRegistry world;
+    SpatialGrid sceneIndex; // Bounds of every world entity that draws, by entity index
+    std::vector<uint32_t> visibleEntities;
+    std::vector<Sprite> visibleSprites;
+    std::vector<Label> visibleLabels;
+    LabelText labelText; // Characters of every Label in the world
+    bool labelFontReady = false; // Whether label bounds were measured with the real font or placeholders
+    float canvasX = 0.0f, canvasY = 0.0f; // Window's top-left on the stress canvas, moved with the arrow keys
+    bool staticPanelFontReady = false;
+    TextMesh animatedLabel;
+    Uint32 startTicks = 0;
+    Uint32 frameCount = 0;
+    Uint32 consoleSeconds = 0;
+    Uint32 lastFrameTicks = 0;
+    double pendingLogLines = 0.0;
+    bool logStress = false; // 10k lines/sec into the log panel, toggled with S
+    bool firstFrame = true;
+    bool dumpFrameGraph = false; // Print the next frame's graph, requested with G
+    bool spriteStress = false; // 10k moving sprites and 10k labels on a large canvas, toggled with E
+    bool lowLatencyInput = false; // Poll input just before the frame is described, toggled with L or --low-latency
+    int windowWidth = WINDOW_WIDTH;
+    int windowHeight = WINDOW_HEIGHT;
+    GraphicsCapture* capture = nullptr; // Owned by graphics when --capture is given
+    std::string capturePath;
+    int captureFrames = 60;
+    int textureBudgetMB = 0; // --texture-budget, or the platform default
 };
 
 AppState app;
 
 // Function declarations
 void mainLoop();
+void processEvents();
+void spawnSprites(int count);
+void spawnLabels(int count);
+void indexLabels();
+void clearWorld();
+void updateSprites(float seconds);
+void cullWorld();
+void clampCanvasView();
+void drawInterface();
 void handleKeyPress(int key);
+void handleResize(int width, int height);
 bool initialize();
 void shutdown();
 
@@ -34,6 +134,20 @@ void shutdown();
 int main(int argc, char* argv[]) {
     printf("Starting Endjinn on %s platform\n", PlatformFactory::getPlatformName().c_str());
     
+    // --capture <file> [frames] records the graphics calls of the first frames for tools/replay
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--capture") == 0 && i + 1 < argc) {
+            app.capturePath = argv[++i];
+            if (i + 1 < argc && isdigit((unsigned char)argv[i + 1][0])) {
+                app.captureFrames = atoi(argv[++i]);
+            }
+        } else if (strcmp(argv[i], "--low-latency") == 0) {
+            app.lowLatencyInput = true;
+        } else if (strcmp(argv[i], "--texture-budget") == 0 && i + 1 < argc) {
+            app.textureBudgetMB = atoi(argv[++i]);
+        }
+    }
+    
     if (!initialize()) {
         printf("Failed to initialize application\n");
         return -1;
@@ -58,6 +172,12 @@ int main(int argc, char* argv[]) {
 }
 
 bool initialize() {
+    app.startTicks = SDL_GetTicks();
+    
+    // Worker threads for parallel startup work (inline on single-threaded web builds)
+    app.jobs = std::make_unique<JobSystem>();
+    printf("Job system: %d worker threads\n", app.jobs->getWorkerCount());
+    
     // Initialize SDL_TTF globally
     if (TTF_Init() == -1) {
         printf("SDL_ttf initialization failed: %s\n", TTF_GetError());
@@ -84,15 +204,99 @@ bool initialize() {
         return false;
     }
     
+    // Recording wraps the backend before any GL object exists, so the capture is self-contained
+    if (!app.capturePath.empty()) {
+        auto capture = std::make_unique<GraphicsCapture>(std::move(app.graphics), WINDOW_WIDTH, WINDOW_HEIGHT);
+        if (!capture->start(app.capturePath, app.captureFrames)) {
+            return false;
+        }
+        app.capture = capture.get();
+        app.graphics = std::move(capture);
+    }
+    
+    // Frames are fenced to time input through to GPU completion where the backend can
+    app.platform->getInputLatency().setGraphics(app.graphics.get());
+    
+    // Renderer-owned textures, buffers and framebuffers, freed once the GPU is done with them
+    app.resources = std::make_unique<GpuResources>(app.graphics.get());
+    
+    // Every texture counts against one memory budget; the least recently drawn cached ones are evicted
+    // and re-created on demand
+    if (app.textureBudgetMB <= 0) {
+        app.textureBudgetMB = PlatformFactory::isWebBuild() ? WEB_TEXTURE_BUDGET_MB : DESKTOP_TEXTURE_BUDGET_MB;
+    }
+    app.residency = std::make_unique<TextureResidency>(app.graphics.get(), app.resources.get(), (size_t)app.textureBudgetMB * 1024 * 1024);
+    
+    // Shared index buffer for every quad renderer
+    app.quadIndices = std::make_unique<QuadIndexBuffer>(app.graphics.get(), app.resources.get());
+    if (!app.quadIndices->initialize()) {
+        printf("Failed to create quad index buffer\n");
+        return false;
+    }
+    
+    // Map the asset pack if one was built; entries are verified as they load
+    app.assets = std::make_unique<AssetPack>();
+    if (!app.assets->open(ASSET_PACK_PATH)) {
+        printf("No asset pack, loading loose files\n");
+        app.assets.reset();
+    } else {
+        printf("Asset pack loaded: %zu assets\n", app.assets->getEntryCount());
+    }
+    
+    // Fonts and shaders load in the background; the first frame doesn't wait for them
+    app.loader = std::make_unique<AssetLoader>(app.graphics.get(), app.resources.get(), app.jobs.get(), app.assets.get());
+    
     // Create text renderer
-    app.textRenderer = std::make_unique<TextRenderer>(app.graphics.get());
-    if (!app.textRenderer->initialize("DejaVuSansMono-Bold.ttf", 24, WINDOW_WIDTH, WINDOW_HEIGHT)) {
+    app.textRenderer = std::make_unique<TextRenderer>(app.graphics.get(), app.resources.get(), app.quadIndices.get(), app.jobs.get());
+    bool baked = (app.assets && app.assets->contains(BAKED_FONT_PATH)) || std::ifstream(BAKED_FONT_PATH).good();
+    const char* fontName = baked ? BAKED_FONT_PATH : FONT_PATH;
+    if (!app.textRenderer->initialize(*app.loader, fontName, 24, WINDOW_WIDTH, WINDOW_HEIGHT)) {
         printf("Failed to initialize text renderer\n");
         return false;
     }
     
-    // Set up input handling
-    app.platform->setKeyHandler(handleKeyPress);
+    // Rectangles and composited layers
+    app.quadRenderer = std::make_unique<QuadRenderer>(app.graphics.get(), app.resources.get(), app.quadIndices.get());
+    if (!app.quadRenderer->initialize(*app.loader, WINDOW_WIDTH, WINDOW_HEIGHT)) {
+        printf("Failed to initialize quad renderer\n");
+        return false;
+    }
+    
+    // Static text panel rendered once into a texture, then one quad per frame
+    app.staticPanel = std::make_unique<CachedLayer>(app.graphics.get(), app.resources.get(), app.textRenderer.get(), app.quadRenderer.get(),
+                                                    app.residency.get());
+    if (!app.staticPanel->initialize(900, 420, WINDOW_WIDTH, WINDOW_HEIGHT)) {
+        printf("Failed to create static panel layer\n");
+        return false;
+    }
+    
+    // Scene resolution follows frame time; text is composited at native resolution
+    app.resolution = std::make_unique<DynamicResolution>(app.graphics.get(), app.resources.get(), app.quadRenderer.get());
+    if (!app.resolution->initialize(WINDOW_WIDTH, WINDOW_HEIGHT)) {
+        printf("Failed to create scene render target\n");
+        return false;
+    }
+    
+    // Passes are declared each frame; pooled targets persist in the graph
+    app.frameGraph = std::make_unique<FrameGraph>(app.graphics.get(), app.resources.get());
+    
+    // Session recording for QA, toggled with R; reads frames back without stalling
+    app.recorder = std::make_unique<FrameRecorder>(app.graphics.get(), app.resources.get());
+    
+    // Console panel drawn as one character grid; it rasterizes from the TTF
+    // since baked atlases aren't laid out as a grid
+    app.console = std::make_unique<TerminalGrid>(app.graphics.get(), app.resources.get(), app.quadIndices.get());
+    if (!app.console->initialize(*app.loader, FONT_PATH, 16, 48, 8, WINDOW_WIDTH, WINDOW_HEIGHT)) {
+        printf("Failed to initialize console\n");
+        return false;
+    }
+    app.console->clear(7, 235);
+    app.console->write(0, 0, " endjinn console ", 16, 45);
+    
+    // Log panel drawing only its visible lines out of a large history
+    app.log = std::make_unique<LogView>(app.graphics.get(), app.textRenderer.get());
+    app.log->setViewportSize(WINDOW_WIDTH, WINDOW_HEIGHT);
+    app.log->append("Log panel: S toggles 10k lines/sec, Page Up/Down scrolls, End follows, D toggles dynamic resolution, G dumps the frame graph, M reports GPU memory and texture residency, R records frames, L polls input late, E spawns 10k sprites and labels, arrow keys scroll their canvas");
     
     // Fix scaling issues
     app.platform->setWindowSize(WINDOW_WIDTH, WINDOW_HEIGHT);
@@ -106,45 +310,506 @@ bool initialize() {
 }
 
 void mainLoop() {
-    // Handle events - platform abstracted
-    app.platform->pollEvents();
+    Uint64 frameStart = SDL_GetPerformanceCounter();
+    
+    // Handle events - platform abstracted. Low-latency mode polls later, once the
+    // work input can't affect is done, so presses make this frame with less delay
+    if (!app.lowLatencyInput) {
+        processEvents();
+    }
     
-    // Render frame - graphics abstracted
-    app.graphics->clearColor(0.1f, 0.1f, 0.3f, 1.0f);
-    app.graphics->clear(GL_COLOR_BUFFER_BIT);
+    // Create GL objects for assets that finished loading in the background
+    app.loader->update();
     
-    // Render text - completely abstracted
-    app.textRenderer->setColor(1.0f, 1.0f, 0.0f); // Yellow
-    app.textRenderer->renderText("Platform Abstraction Success!", 50, 400);
-    app.textRenderer->renderText("No preprocessor directives!", 50, 500);
-    app.textRenderer->renderText("Write once, run everywhere!", 50, 600);
+    // Console: a log line per second and a live status row, one draw for the whole grid
+    Uint32 seconds = (SDL_GetTicks() - app.startTicks) / 1000;
+    if (seconds != app.consoleSeconds) {
+        app.consoleSeconds = seconds;
+        app.console->scroll(1, 7, 235);
+        app.console->write(0, 0, " endjinn console ", 16, 45);
+        char line[64];
+        InputLatencyStats input = app.platform->getInputLatency().getStats();
+        if (input.samples) {
+            snprintf(line, sizeof(line), "[%5us] input p50 %.1fms p99 %.1fms%s", seconds, input.presentP50, input.presentP99,
+                     app.lowLatencyInput ? " late" : "");
+        } else {
+            snprintf(line, sizeof(line), "[%5us] \xE2\x9C\x93 tick, %d assets loading", seconds, app.loader->getPendingCount());
+        }
+        app.console->write(0, app.console->getRows() - 2, line, 10, 235);
+    }
+    char status[80];
+    int statusLength = snprintf(status, sizeof(status), "frame %-8u draws %-5d scale %.2f", app.frameCount,
+                                app.textRenderer->getDrawCallCount(), app.resolution->getScale());
+    if (app.recorder->isRecording()) {
+        snprintf(status + statusLength, sizeof(status) - statusLength, " rec %.2fms", app.recorder->getAverageOverheadMs());
+    }
+    app.console->write(0, app.console->getRows() - 1, status, 11, 236);
+    app.frameCount++;
+    
+    // Log panel: a line every quarter second, or 10k lines/sec under stress
+    Uint32 now = SDL_GetTicks();
+    Uint32 elapsedTicks = app.lastFrameTicks ? now - app.lastFrameTicks : 0;
+    app.pendingLogLines += elapsedTicks * (app.logStress ? 10.0 : 0.004);
+    app.lastFrameTicks = now;
+    char logLine[96];
+    for (; app.pendingLogLines >= 1.0; app.pendingLogLines -= 1.0) {
+        uint64_t number = app.log->getBuffer().getTotalLines();
+        snprintf(logLine, sizeof(logLine), "\x1b[90m%8llu\x1b[0m \x1b[%dmevent\x1b[0m worker %llu finished job in %llu us",
+                 (unsigned long long)number, number % 7 == 0 ? 33 : 32, (unsigned long long)(number % 8), (unsigned long long)(number * 37 % 900));
+        app.log->append(logLine);
+    }
+    
+    if (app.lowLatencyInput) {
+        processEvents();
+    }
+    
+    updateSprites(elapsedTicks * 0.001f);
+    if (app.spriteStress && app.labelFontReady != app.textRenderer->isFontReady()) {
+        indexLabels();
+    }
+    cullWorld();
+    
+    // Describe the frame: the scene at the scaled resolution, its upscale, then the UI at native
+    // resolution. The console goes through a transient so its text stays sharp when the scene shrinks.
+    FrameGraph& graph = *app.frameGraph;
+    graph.reset();
+    FrameGraphResource backbuffer = graph.importBackbuffer(app.windowWidth, app.windowHeight);
+    FrameGraphResource scene = graph.importTarget("scene", app.resolution->getTarget(), app.resolution->getRenderWidth(),
+                                                  app.resolution->getRenderHeight());
+    FrameGraphResource console = -1;
+    graph.addPass("scene", [&](FrameGraphBuilder& builder) {
+        builder.write(scene);
+    }, [](FrameGraphContext&) {
+        // Clear screen - graphics abstracted
+        app.graphics->clearColor(0.1f, 0.1f, 0.3f, 1.0f);
+        app.graphics->clear(GL_COLOR_BUFFER_BIT);
+        app.quadRenderer->drawSprites(app.visibleSprites.data(), app.visibleSprites.size());
+        app.quadRenderer->flush();
+    });
+    graph.addPass("console", [&](FrameGraphBuilder& builder) {
+        // Window-sized, so the renderers' window projection applies unchanged
+        console = builder.write(builder.create("console", app.windowWidth, app.windowHeight));
+    }, [](FrameGraphContext&) {
+        app.graphics->clearColor(0.0f, 0.0f, 0.0f, 0.0f);
+        app.graphics->clear(GL_COLOR_BUFFER_BIT);
+        app.console->draw(50.0f, 50.0f);
+    });
+    graph.addPass("upscale", [&](FrameGraphBuilder& builder) {
+        builder.read(scene);
+        builder.write(backbuffer);
+    }, [](FrameGraphContext&) {
+        app.resolution->present();
+    });
+    graph.addPass("interface", [&](FrameGraphBuilder& builder) {
+        builder.read(console);
+        builder.write(backbuffer);
+    }, [console](FrameGraphContext& context) {
+        // Texture rows run bottom-up, so the top edge samples v = 1
+        GLuint consoleTexture = context.getTexture(console);
+        if (consoleTexture) {
+            app.quadRenderer->drawTexture(consoleTexture, 0.0f, 0.0f, (float)context.getWidth(), (float)context.getHeight(),
+                                          0.0f, 1.0f, 1.0f, 0.0f);
+            app.quadRenderer->flush();
+        }
+        drawInterface();
+    });
+    if (graph.compile()) {
+        graph.execute();
+    }
+    if (app.dumpFrameGraph) {
+        app.dumpFrameGraph = false;
+        graph.dump();
+    }
+    
+    // Queue this frame's readback before the swap; its pixels are fetched a few frames later
+    app.recorder->captureFrame();
     
     // Present frame - platform abstracted
+    app.resolution->submitFrame();
+    Uint64 swapStart = SDL_GetPerformanceCounter();
     app.platform->swapBuffers();
+    Uint64 swapEnd = SDL_GetPerformanceCounter();
+    app.residency->endFrame();
+    app.resources->endFrame();
+    size_t evictions = app.residency->getStats().frameEvictions;
+    if (evictions) {
+        snprintf(logLine, sizeof(logLine), "\x1b[33mresidency\x1b[0m evicted %zu textures to stay within %d MB", evictions,
+                 app.textureBudgetMB);
+        app.log->append(logLine);
+    }
+    if (app.capture) {
+        app.capture->endFrame();
+    }
+    
+    // Frame time drives the scene resolution; the swap is reported apart since it may just be vsync
+    double ticksToMs = 1000.0 / SDL_GetPerformanceFrequency();
+    float swapMs = (float)((swapEnd - swapStart) * ticksToMs);
+    float frameMs = (float)((SDL_GetPerformanceCounter() - frameStart) * ticksToMs);
+    app.resolution->reportFrameTime(frameMs - swapMs, swapMs);
+    
+    if (app.firstFrame) {
+        app.firstFrame = false;
+        printf("First frame after %u ms (%d assets still loading)\n", SDL_GetTicks() - app.startTicks, app.loader->getPendingCount());
+    }
+}
+
+// Sprites with random colors and velocities, scattered over the canvas
+void spawnSprites(int count) {
+    app.world.reserve(app.world.getAliveCount() + count);
+    for (int i = 0; i < count; i++) {
+        Entity entity = app.world.create();
+        Sprite sprite;
+        sprite.x = (float)(rand() % (app.windowWidth * STRESS_CANVAS_SCALE));
+        sprite.y = (float)(rand() % (app.windowHeight * STRESS_CANVAS_SCALE));
+        sprite.width = sprite.height = 4.0f + rand() % 8;
+        sprite.r = (rand() % 256) / 255.0f;
+        sprite.g = (rand() % 256) / 255.0f;
+        sprite.b = 1.0f;
+        sprite.a = 0.8f;
+        app.world.add(entity, sprite);
+        app.world.add(entity, Velocity{(float)(rand() % 400 - 200), (float)(rand() % 400 - 200)});
+        app.sceneIndex.update(entity.index, Rect2D{sprite.x, sprite.y, sprite.width, sprite.height});
+    }
+    
+    // The movement system walks velocities and looks sprites up; same order keeps both reads sequential
+    app.world.getArray<Sprite>().arrangeLike(app.world.getArray<Velocity>());
+}
+
+// Static labels scattered over the canvas; their text never changes, so they are
+// only measured again when the font they were measured with does
+void spawnLabels(int count) {
+    app.world.reserve(app.world.getAliveCount() + count);
+    char text[32];
+    for (int i = 0; i < count; i++) {
+        Entity entity = app.world.create();
+        Label label;
+        label.x = (float)(rand() % (app.windowWidth * STRESS_CANVAS_SCALE));
+        label.y = (float)(rand() % (app.windowHeight * STRESS_CANVAS_SCALE));
+        label.color = TextColor{0.6f + (rand() % 100) / 250.0f, 0.9f, 0.6f, 1.0f};
+        snprintf(text, sizeof(text), "label %u", entity.index);
+        app.labelText.assign(label, text);
+        app.world.add(entity, label);
+    }
+    indexLabels();
+}
+
+// Put every label's bounds in the scene index, measured with the font as it is now;
+// placeholder metrics differ from the real font's, so this runs again once it is resident
+void indexLabels() {
+    app.labelFontReady = app.textRenderer->isFontReady();
+    float lineHeight = app.textRenderer->getLineHeight();
+    app.world.each<Label>([lineHeight](Entity entity, Label& label) {
+        TextSize size = app.textRenderer->measureText(app.labelText.get(label));
+        app.sceneIndex.update(entity.index, Rect2D{label.x, label.y, size.width, std::max(size.height, lineHeight)});
+    });
+}
+
+void clearWorld() {
+    std::vector<Entity> entities;
+    ComponentArray<Sprite>& sprites = app.world.getArray<Sprite>();
+    entities.insert(entities.end(), sprites.getEntities(), sprites.getEntities() + sprites.size());
+    ComponentArray<Label>& labels = app.world.getArray<Label>();
+    entities.insert(entities.end(), labels.getEntities(), labels.getEntities() + labels.size());
+    for (Entity entity : entities) {
+        app.world.destroy(entity);
+    }
+    app.sceneIndex.clear();
+    app.labelText.clear();
+    app.canvasX = 0.0f;
+    app.canvasY = 0.0f;
+}
+
+// Move sprites and bounce them off the canvas edges, in chunks across the workers
+void updateSprites(float seconds) {
+    float width = (float)(app.windowWidth * STRESS_CANVAS_SCALE);
+    float height = (float)(app.windowHeight * STRESS_CANVAS_SCALE);
+    app.world.parallelEachPair<Velocity, Sprite>(*app.jobs, 2048, [=](Entity, Velocity& velocity, Sprite& sprite) {
+        sprite.x += velocity.dx * seconds;
+        sprite.y += velocity.dy * seconds;
+        if ((sprite.x < 0.0f && velocity.dx < 0.0f) || (sprite.x + sprite.width > width && velocity.dx > 0.0f)) {
+            velocity.dx = -velocity.dx;
+        }
+        if ((sprite.y < 0.0f && velocity.dy < 0.0f) || (sprite.y + sprite.height > height && velocity.dy > 0.0f)) {
+            velocity.dy = -velocity.dy;
+        }
+    });
+    
+    // The grid isn't thread-safe; most sprites stay in their cells, which makes this a compare and a store
+    app.world.each<Sprite>([](Entity entity, Sprite& sprite) {
+        app.sceneIndex.update(entity.index, Rect2D{sprite.x, sprite.y, sprite.width, sprite.height});
+    });
+}
+
+// Gather the sprites and labels overlapping the window's view of the canvas, in entity
+// order so overlaps draw the same way every frame. Sprites are moved into window space here;
+// labels are drawn through the same offset.
+void cullWorld() {
+    app.visibleEntities.clear();
+    app.visibleSprites.clear();
+    app.visibleLabels.clear();
+    app.sceneIndex.query(Rect2D{app.canvasX, app.canvasY, (float)app.windowWidth, (float)app.windowHeight}, app.visibleEntities);
+    std::sort(app.visibleEntities.begin(), app.visibleEntities.end());
+    
+    ComponentArray<Sprite>& sprites = app.world.getArray<Sprite>();
+    ComponentArray<Label>& labels = app.world.getArray<Label>();
+    for (uint32_t index : app.visibleEntities) {
+        if (const Sprite* sprite = sprites.find(index)) {
+            app.visibleSprites.push_back(*sprite);
+            app.visibleSprites.back().x -= app.canvasX;
+            app.visibleSprites.back().y -= app.canvasY;
+        }
+        if (const Label* label = labels.find(index)) {
+            app.visibleLabels.push_back(*label);
+        }
+    }
+}
+
+// Keep the window's view inside the stress canvas
+void clampCanvasView() {
+    float maxX = (float)(app.windowWidth * (STRESS_CANVAS_SCALE - 1));
+    float maxY = (float)(app.windowHeight * (STRESS_CANVAS_SCALE - 1));
+    app.canvasX = std::min(std::max(app.canvasX, 0.0f), maxX);
+    app.canvasY = std::min(std::max(app.canvasY, 0.0f), maxY);
+}
+
+// Poll the platform, then handle what it queued in batches
+void processEvents() {
+    app.platform->pollEvents();
+    
+    InputEvent batch[64];
+    size_t count;
+    while ((count = app.platform->getEvents().drain(batch, 64)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            const InputEvent& event = batch[i];
+            if (event.type == InputEventType::KeyDown) {
+                app.platform->getInputLatency().inputHandled(event.timestamp);
+                handleKeyPress(event.key.key);
+            } else if (event.type == InputEventType::Resize) {
+                handleResize(event.resize.width, event.resize.height);
+            }
+        }
+    }
+}
+
+// Text and panels composited over the upscaled scene at native resolution
+void drawInterface() {
+    // Canvas labels that survived culling, beneath the panels
+    app.textRenderer->renderLabels(app.visibleLabels.data(), app.visibleLabels.size(), app.labelText, -app.canvasX, -app.canvasY);
+    
+    // Static panel - re-rendered only when the real font replaces the placeholders
+    if (!app.staticPanelFontReady && app.textRenderer->isFontReady()) {
+        app.staticPanelFontReady = true;
+        TextStyle centered;
+        centered.align = TextAlign::Center;
+        app.textRenderer->getLayout()->layoutBatch(PANEL_PARAGRAPHS, PANEL_TEXT_WIDTH, centered, *app.jobs);
+        app.staticPanel->invalidate();
+    }
+    app.staticPanel->draw(50.0f, 380.0f, []() {
+        app.quadRenderer->fillRect(0.0f, 0.0f, 900.0f, 420.0f, 0.05f, 0.05f, 0.15f, 0.6f);
+        
+        // Render text - completely abstracted
+        app.textRenderer->setColor(1.0f, 1.0f, 0.0f); // Yellow
+        app.textRenderer->renderText("Platform Abstraction Success!", 0, 20);
+        app.textRenderer->renderText("No preprocessor directives!", 0, 120);
+        app.textRenderer->renderText("Write once, run everywhere!", 0, 220);
+        
+        // Wrapped paragraphs - laid out by layoutBatch above, then served from the layout cache
+        TextStyle centered;
+        centered.align = TextAlign::Center;
+        float paragraphY = 320.0f;
+        for (const std::string& paragraph : PANEL_PARAGRAPHS) {
+            app.textRenderer->renderTextBlock(paragraph, 0, paragraphY, PANEL_TEXT_WIDTH, centered);
+            TextLayout* layout = app.textRenderer->getLayout();
+            float height = layout ? layout->layout(paragraph, PANEL_TEXT_WIDTH, centered)->height : app.textRenderer->getLineHeight();
+            paragraphY += height + app.textRenderer->getLineHeight() * 0.5f;
+        }
+    });
+    app.quadRenderer->flush();
+    
+    // Multicolor status line - inline escapes, still one batch
+    app.textRenderer->setColor(0.8f, 0.8f, 0.8f);
+    app.textRenderer->renderText("[\x1b[32m OK \x1b[0m] assets  [\x1b[33mWARN\x1b[0m] layout  [\x1b[31mFAIL\x1b[0m] \x1b[2mnone\x1b[22m", 50, 850);
+    
+    // Animated label - built from placeholders on the first frame and rebuilt by
+    // the renderer once the font is resident; rotates about its own center
+    // without re-uploading vertices
+    if (app.animatedLabel.buffer.isNull()) {
+        app.textRenderer->setColor(0.4f, 0.9f, 1.0f);
+        app.animatedLabel = app.textRenderer->createTextMesh("GPU transforms", 0, 0);
+    }
+    Transform2D spin;
+    spin.x = 750.0f;
+    spin.y = 150.0f;
+    spin.originX = 90.0f;
+    spin.originY = 14.0f;
+    spin.rotation = SDL_GetTicks() * 0.001f;
+    app.textRenderer->drawTextMesh(app.animatedLabel, spin);
+    
+    // Log panel
+    app.textRenderer->setColor(0.85f, 0.85f, 0.85f);
+    app.log->draw(50.0f, 220.0f, 900.0f, 160.0f);
+    
+    // One draw call for all queued text this frame
+    app.textRenderer->flush();
 }
 
 void handleKeyPress(int key) {
     printf("Key pressed: %d\n", key);
+    if (key == SDLK_s && app.log) {
+        app.logStress = !app.logStress;
+        printf("Log stress %s\n", app.logStress ? "on" : "off");
+    } else if (key == SDLK_PAGEUP && app.log) {
+        app.log->scroll(5);
+    } else if (key == SDLK_PAGEDOWN && app.log) {
+        app.log->scroll(-5);
+    } else if (key == SDLK_END && app.log) {
+        app.log->scrollToEnd();
+    } else if (key == SDLK_d && app.resolution) {
+        app.resolution->setEnabled(!app.resolution->isEnabled());
+        app.resolution->setScale(app.resolution->getSettings().maxScale);
+        printf("Dynamic resolution %s\n", app.resolution->isEnabled() ? "on" : "off");
+    } else if (key == SDLK_g) {
+        app.dumpFrameGraph = true;
+    } else if (key == SDLK_m && app.resources) {
+        app.resources->printReport();
+        app.residency->printReport();
+    } else if (key == SDLK_r && app.recorder) {
+        if (app.recorder->isRecording()) {
+            app.recorder->stop();
+        } else {
+            app.recorder->start("recording", app.windowWidth, app.windowHeight);
+        }
+    } else if (key == SDLK_e) {
+        app.spriteStress = !app.spriteStress;
+        if (app.spriteStress) {
+            spawnSprites(STRESS_SPRITES);
+            spawnLabels(STRESS_LABELS);
+        } else {
+            clearWorld();
+        }
+        printf("Sprite stress %s (%zu entities)\n", app.spriteStress ? "on" : "off", app.world.getAliveCount());
+    } else if (key == SDLK_l) {
+        app.lowLatencyInput = !app.lowLatencyInput;
+        printf("Low-latency input %s\n", app.lowLatencyInput ? "on" : "off");
+    } else if (key == SDLK_LEFT || key == SDLK_RIGHT || key == SDLK_UP || key == SDLK_DOWN) {
+        // A quarter window per press, kept on the canvas
+        float stepX = key == SDLK_LEFT ? -0.25f : key == SDLK_RIGHT ? 0.25f : 0.0f;
+        float stepY = key == SDLK_UP ? -0.25f : key == SDLK_DOWN ? 0.25f : 0.0f;
+        app.canvasX += stepX * app.windowWidth;
+        app.canvasY += stepY * app.windowHeight;
+        clampCanvasView();
+    }
     // Add your key handling logic here
     // This function is completely platform-agnostic
 }
 
+void handleResize(int width, int height) {
+    app.windowWidth = width;
+    app.windowHeight = height;
+    clampCanvasView();
+    if (app.capture) {
+        app.capture->setWindowSize(width, height);
+    }
+    
+    // Recorded frames keep one size
+    if (app.recorder && app.recorder->isRecording()) {
+        printf("Window resized, recording stopped\n");
+        app.recorder->stop();
+    }
+    
+    // Vertices are in pixel space, so only the projection changes
+    if (app.textRenderer) {
+        app.textRenderer->setViewportSize(width, height);
+    }
+    if (app.console) {
+        app.console->setViewportSize(width, height);
+    }
+    if (app.log) {
+        app.log->setViewportSize(width, height);
+    }
+    if (app.quadRenderer) {
+        app.quadRenderer->setViewportSize(width, height);
+    }
+    if (app.staticPanel) {
+        app.staticPanel->setViewportSize(width, height);
+    }
+    if (app.resolution) {
+        app.resolution->setViewportSize(width, height);
+    }
+}
+
 void shutdown() {
     // Clean shutdown - all platform abstracted
+    app.log.reset();
+    if (app.staticPanel) {
+        app.staticPanel->cleanup();
+        app.staticPanel.reset();
+    }
+    // Writes out frames still in flight
+    app.recorder.reset();
+    if (app.frameGraph) {
+        app.frameGraph->cleanup();
+        app.frameGraph.reset();
+    }
+    if (app.resolution) {
+        app.resolution->cleanup();
+        app.resolution.reset();
+    }
+    if (app.quadRenderer) {
+        app.quadRenderer->cleanup();
+        app.quadRenderer.reset();
+    }
+    
     if (app.textRenderer) {
+        app.textRenderer->destroyTextMesh(app.animatedLabel);
         app.textRenderer->cleanup();
         app.textRenderer.reset();
     }
     
+    if (app.console) {
+        app.console->cleanup();
+        app.console.reset();
+    }
+    
+    // Waits for loads still in flight
+    app.loader.reset();
+    
+    if (app.quadIndices) {
+        app.quadIndices->cleanup();
+        app.quadIndices.reset();
+    }
+    
+    // Input latency fences belong to the backend
+    if (app.platform) {
+        app.platform->getInputLatency().printReport();
+        app.platform->getInputLatency().setGraphics(nullptr);
+    }
+    
+    // Everything released above, deleted now rather than after the usual frames in flight
+    app.residency.reset();
+    if (app.resources) {
+        app.resources->cleanup();
+        app.resources.reset();
+    }
+    
+    // Finishes a capture that was still recording
     if (app.graphics) {
+        app.capture = nullptr;
         app.graphics.reset();
     }
     
+    if (app.assets) {
+        app.assets->close();
+        app.assets.reset();
+    }
+    
     if (app.platform) {
         app.platform->shutdown();
         app.platform.reset();
     }
     
+    app.jobs.reset();
+    
     TTF_Quit();
     printf("Application shut down cleanly\n");
 }
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include "event_queue.h"
+
+EventQueue::EventQueue(size_t capacity) : mask(0), enqueuePosition(0), dequeuePosition(0), dropped(0) {
+    size_t size = 2;
+    while (size < capacity) {
+        size *= 2;
+    }
+    mask = size - 1;
+    
+    // A cell is free for the producer at position p while its sequence is p
+    cells.reset(new Cell[size]);
+    for (size_t i = 0; i < size; i++) {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool EventQueue::push(const InputEvent& event) {
+    size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = cells[position & mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+        if (difference == 0) {
+            // Free; claim it, or retry from wherever another producer moved the position
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                cell.event = event;
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            // Still holds an event from a lap ago
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        } else {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+size_t EventQueue::drain(InputEvent* events, size_t maxEvents) {
+    size_t count = 0;
+    while (count < maxEvents && pop(events[count])) {
+        count++;
+    }
+    return count;
+}
+
+bool EventQueue::pop(InputEvent& event) {
+    size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    while (true) {
+        Cell& cell = cells[position & mask];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t difference = (intptr_t)sequence - (intptr_t)(position + 1);
+        if (difference == 0) {
+            // Written; claim it, then hand the cell back to producers one lap ahead
+            if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                event = cell.event;
+                cell.sequence.store(position + mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (difference < 0) {
+            return false; // Empty
+        } else {
+            position = dequeuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
\ No newline at end of file
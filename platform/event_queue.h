@@ -0,0 +1,95 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+enum class InputEventType : uint8_t {
+    None,
+    KeyDown,
+    KeyUp,
+    TextInput,
+    MouseMove,
+    MouseButtonDown,
+    MouseButtonUp,
+    MouseWheel,
+    Resize,
+    Quit
+};
+
+struct InputKey {
+    int32_t key; // SDL keycode
+};
+
+struct InputMouse {
+    int32_t x, y;   // Window pixels
+    int32_t dx, dy; // Motion since the last move
+    uint8_t button; // SDL_BUTTON_* for button events
+    uint8_t clicks;
+};
+
+struct InputWheel {
+    int32_t x, y;
+};
+
+struct InputResize {
+    int32_t width, height;
+};
+
+// One platform event as plain data, so it can be copied through the queue
+struct InputEvent {
+    static const size_t MAX_TEXT = 24; // Longer text input arrives as several events
+    
+    InputEventType type;
+    uint8_t repeat;     // KeyDown: generated by a held key
+    uint16_t modifiers; // Key events: SDL KMOD_* bits
+    uint32_t timestamp; // SDL_GetTicks when the OS delivered the event
+    union {
+        InputKey key;
+        InputMouse mouse;
+        InputWheel wheel;
+        InputResize resize;
+        char text[MAX_TEXT]; // UTF-8, NUL-terminated
+    };
+};
+
+static_assert(sizeof(InputEvent) == 32, "InputEvent should stay two to a cache line");
+
+// Bounded lock-free queue of input events. Any thread may push and any thread may
+// drain; each cell carries a sequence number that tells producers and consumers
+// whose turn it is, so neither side takes a lock. A full queue drops the new
+// event rather than blocking the platform.
+class EventQueue {
+public:
+    // Capacity is rounded up to a power of two
+    explicit EventQueue(size_t capacity = 1024);
+    
+    EventQueue(const EventQueue&) = delete;
+    EventQueue& operator=(const EventQueue&) = delete;
+    
+    // False when the queue is full and the event was dropped
+    bool push(const InputEvent& event);
+    
+    // Move up to maxEvents of the oldest events into events; returns how many
+    size_t drain(InputEvent* events, size_t maxEvents);
+    
+    size_t getCapacity() const { return mask + 1; }
+    uint64_t getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        InputEvent event;
+    };
+    
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    
+    // Producers and consumers each get their own cache line
+    alignas(64) std::atomic<size_t> enqueuePosition;
+    alignas(64) std::atomic<size_t> dequeuePosition;
+    std::atomic<uint64_t> dropped;
+    
+    bool pop(InputEvent& event);
+};
\ No newline at end of file
@@ -0,0 +1,125 @@
+#include "input_latency.h"
+#include "../graphics/graphics_api.h"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <iostream>
+
+InputLatencyTracker::InputLatencyTracker() : graphics(nullptr), totalInputs(0) {
+}
+
+InputLatencyTracker::~InputLatencyTracker() {
+    releaseGpuFrames();
+}
+
+void InputLatencyTracker::setGraphics(GraphicsAPI* backend) {
+    releaseGpuFrames();
+    graphics = backend;
+}
+
+void InputLatencyTracker::inputHandled(uint32_t eventTimestamp) {
+    // SDL stamps events with SDL_GetTicks; the event's age moves it onto the counter clock
+    Uint32 age = SDL_GetTicks() - eventTimestamp;
+    handled.add(age);
+    frameInputs.push_back(nowMs() - age);
+    totalInputs++;
+}
+
+void InputLatencyTracker::framePresented() {
+    pollGpu();
+    if (frameInputs.empty()) {
+        return;
+    }
+    
+    double now = nowMs();
+    for (double eventTime : frameInputs) {
+        presented.add(now - eventTime);
+    }
+    
+    // Fence the frame; backends without fences return none and skip the GPU stage
+    GLsync fence = graphics ? graphics->createFence() : nullptr;
+    if (fence) {
+        if (gpuFrames.size() >= MAX_GPU_FRAMES) {
+            // pollGpu just found it still running, so its latency is at least
+            // what has passed; dropping it unrecorded would bias the tail low
+            GpuFrame& oldest = gpuFrames.front();
+            for (double eventTime : oldest.eventTimes) {
+                gpu.add(now - eventTime);
+            }
+            graphics->deleteFence(oldest.fence);
+            gpuFrames.pop_front();
+        }
+        gpuFrames.push_back(GpuFrame{fence, std::move(frameInputs)});
+    }
+    frameInputs.clear();
+}
+
+void InputLatencyTracker::pollGpu() {
+    if (gpuFrames.empty()) {
+        return;
+    }
+    
+    // Frames complete in order, so stop at the first one still running
+    double now = nowMs();
+    while (!gpuFrames.empty() && graphics->isFenceSignaled(gpuFrames.front().fence)) {
+        GpuFrame& frame = gpuFrames.front();
+        for (double eventTime : frame.eventTimes) {
+            gpu.add(now - eventTime);
+        }
+        graphics->deleteFence(frame.fence);
+        gpuFrames.pop_front();
+    }
+}
+
+InputLatencyStats InputLatencyTracker::getStats() const {
+    InputLatencyStats stats;
+    stats.samples = presented.samples.size();
+    handled.percentiles(stats.handledP50, stats.handledP99);
+    presented.percentiles(stats.presentP50, stats.presentP99);
+    stats.gpuSamples = gpu.samples.size();
+    gpu.percentiles(stats.gpuP50, stats.gpuP99);
+    return stats;
+}
+
+void InputLatencyTracker::printReport() const {
+    if (!totalInputs) {
+        return;
+    }
+    InputLatencyStats stats = getStats();
+    printf("Input latency over the last %zu of %llu inputs (ms):\n", stats.samples, (unsigned long long)totalInputs);
+    printf("  handled  p50 %6.2f  p99 %6.2f\n", stats.handledP50, stats.handledP99);
+    printf("  present  p50 %6.2f  p99 %6.2f\n", stats.presentP50, stats.presentP99);
+    if (stats.gpuSamples) {
+        printf("  gpu done p50 %6.2f  p99 %6.2f\n", stats.gpuP50, stats.gpuP99);
+    }
+}
+
+double InputLatencyTracker::nowMs() const {
+    return SDL_GetPerformanceCounter() * 1000.0 / SDL_GetPerformanceFrequency();
+}
+
+void InputLatencyTracker::releaseGpuFrames() {
+    for (GpuFrame& frame : gpuFrames) {
+        graphics->deleteFence(frame.fence);
+    }
+    gpuFrames.clear();
+}
+
+void InputLatencyTracker::History::add(double ms) {
+    if (samples.size() < HISTORY) {
+        samples.push_back((float)ms);
+    } else {
+        samples[next] = (float)ms;
+    }
+    next = (next + 1) % HISTORY;
+}
+
+void InputLatencyTracker::History::percentiles(double& p50, double& p99) const {
+    if (samples.empty()) {
+        p50 = p99 = 0.0;
+        return;
+    }
+    std::vector<float> sorted(samples);
+    std::sort(sorted.begin(), sorted.end());
+    p50 = sorted[sorted.size() / 2];
+    p99 = sorted[std::min(sorted.size() - 1, sorted.size() * 99 / 100)];
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+class GraphicsAPI;
+typedef struct __GLsync* GLsync;
+
+// Percentiles over the recent inputs, in milliseconds from the OS event timestamp
+struct InputLatencyStats {
+    size_t samples = 0;
+    double handledP50 = 0.0, handledP99 = 0.0; // Until the key handler ran
+    double presentP50 = 0.0, presentP99 = 0.0; // Until the frame that consumed it was swapped
+    size_t gpuSamples = 0;
+    double gpuP50 = 0.0, gpuP99 = 0.0;         // Until the GPU finished that frame (fenced backends only)
+};
+
+// Follows key presses from the OS event to the screen. The event consumer stamps
+// each press as it handles it, which tags it with the frame being built; the
+// platform closes it at the swap, and with a graphics backend that has fences, the
+// frame's fence completes it. Not thread-safe: use it from the rendering thread.
+// SDL event timestamps are whole milliseconds, so every latency carries up to 1 ms
+// of rounding. Fences are polled, never waited on, at each poll and swap, so the
+// GPU figure can overstate completion by up to the gap between them.
+class InputLatencyTracker {
+public:
+    static const size_t HISTORY = 512;      // Samples kept per stage
+    static const size_t MAX_GPU_FRAMES = 8; // Fenced frames awaited; past this the oldest is recorded as still running
+    
+    InputLatencyTracker();
+    ~InputLatencyTracker();
+    
+    InputLatencyTracker(const InputLatencyTracker&) = delete;
+    InputLatencyTracker& operator=(const InputLatencyTracker&) = delete;
+    
+    // Backend to fence presented frames on; nullptr releases outstanding fences.
+    // Clear it before the backend is destroyed.
+    void setGraphics(GraphicsAPI* graphics);
+    
+    // An input with this SDL event timestamp reached its handler now
+    void inputHandled(uint32_t eventTimestamp);
+    
+    // The frame holding the inputs handled since the last swap was presented
+    void framePresented();
+    
+    // Check fenced frames for GPU completion without blocking
+    void pollGpu();
+    
+    InputLatencyStats getStats() const;
+    uint64_t getTotalInputs() const { return totalInputs; }
+    void printReport() const;
+
+private:
+    struct GpuFrame {
+        GLsync fence;
+        std::vector<double> eventTimes;
+    };
+    
+    // Fixed-size history of one stage
+    struct History {
+        std::vector<float> samples;
+        size_t next = 0;
+        
+        void add(double ms);
+        void percentiles(double& p50, double& p99) const;
+    };
+    
+    GraphicsAPI* graphics;
+    std::vector<double> frameInputs; // Event times of inputs handled for the frame being built
+    std::deque<GpuFrame> gpuFrames;
+    History handled;
+    History presented;
+    History gpu;
+    uint64_t totalInputs;
+    
+    // Performance counter time in ms; event times are moved onto the same clock
+    double nowMs() const;
+    
+    void releaseGpuFrames();
+};
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include "platform.h"
+#include <SDL2/SDL.h>
+#include <cstring>
+
+void Platform::queueEvent(const SDL_Event& event) {
+    InputEvent input;
+    memset(&input, 0, sizeof(input));
+    input.timestamp = event.common.timestamp;
+    
+    switch (event.type) {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            input.type = event.type == SDL_KEYDOWN ? InputEventType::KeyDown : InputEventType::KeyUp;
+            input.repeat = event.key.repeat;
+            input.modifiers = event.key.keysym.mod;
+            input.key.key = event.key.keysym.sym;
+            break;
+        case SDL_TEXTINPUT: {
+            // Split on character boundaries into events that fit
+            input.type = InputEventType::TextInput;
+            const char* text = event.text.text;
+            size_t length = strlen(text);
+            while (length > 0) {
+                size_t limit = length < InputEvent::MAX_TEXT - 1 ? length : InputEvent::MAX_TEXT - 1;
+                size_t chunk = limit;
+                while (chunk < length && chunk > 0 && ((unsigned char)text[chunk] & 0xC0) == 0x80) {
+                    chunk--;
+                }
+                
+                // Malformed text with no boundary in reach is cut at the limit so it still drains
+                if (chunk == 0) {
+                    chunk = limit;
+                }
+                memset(input.text, 0, sizeof(input.text));
+                memcpy(input.text, text, chunk);
+                events.push(input);
+                text += chunk;
+                length -= chunk;
+            }
+            return;
+        }
+        case SDL_MOUSEMOTION:
+            input.type = InputEventType::MouseMove;
+            input.mouse.x = event.motion.x;
+            input.mouse.y = event.motion.y;
+            input.mouse.dx = event.motion.xrel;
+            input.mouse.dy = event.motion.yrel;
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            input.type = event.type == SDL_MOUSEBUTTONDOWN ? InputEventType::MouseButtonDown : InputEventType::MouseButtonUp;
+            input.mouse.x = event.button.x;
+            input.mouse.y = event.button.y;
+            input.mouse.button = event.button.button;
+            input.mouse.clicks = event.button.clicks;
+            break;
+        case SDL_MOUSEWHEEL:
+            input.type = InputEventType::MouseWheel;
+            input.wheel.x = event.wheel.x;
+            input.wheel.y = event.wheel.y;
+            break;
+        case SDL_WINDOWEVENT:
+            if (event.window.event != SDL_WINDOWEVENT_SIZE_CHANGED) {
+                return;
+            }
+            input.type = InputEventType::Resize;
+            input.resize.width = event.window.data1;
+            input.resize.height = event.window.data2;
+            break;
+        case SDL_QUIT:
+            input.type = InputEventType::Quit;
+            break;
+        default:
+            return;
+    }
+    events.push(input);
+}
\ No newline at end of file
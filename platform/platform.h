@@ -1,6 +1,7 @@
 #pragma once
 
-#include <functional>
+#include "event_queue.h"
+#include "input_latency.h"
 #include <string>
 
 // Forward declarations
@@ -20,12 +21,12 @@ public:
     virtual void swapBuffers() = 0;
     virtual void setViewport(int width, int height) = 0;
     
-    // Events
+    // Events - pollEvents moves OS events into the event queue
     virtual void pollEvents() = 0;
     virtual bool shouldQuit() const = 0;
     
-    // Input callbacks
-    virtual void setKeyHandler(std::function<void(int key)> handler) = 0;
+    // Input, resize and quit events, drained by the consumer on any thread
+    EventQueue& getEvents() { return events; }
     
     // Window management
     virtual void setWindowSize(int width, int height) = 0;
@@ -35,7 +36,14 @@ public:
     virtual std::string getPlatformName() const = 0;
     virtual bool isWeb() const = 0;
     
+    // Key press latency, stamped by the consumer and closed at each swap
+    InputLatencyTracker& getInputLatency() { return inputLatency; }
+    
 protected:
-    std::function<void(int key)> keyHandler;
+    // Translate an SDL event and push it; SDL events with no InputEvent form are ignored
+    void queueEvent(const SDL_Event& event);
+    
     bool quitRequested = false;
+    EventQueue events;
+    InputLatencyTracker inputLatency;
 };
\ No newline at end of file
@@ -74,6 +74,7 @@ void DesktopPlatform::swapBuffers() {
     if (window) {
         SDL_GL_SwapWindow(window);
     }
+    inputLatency.framePresented();
 }
 
 void DesktopPlatform::setViewport(int width, int height) {
@@ -81,6 +82,7 @@ void DesktopPlatform::setViewport(int width, int height) {
 }
 
 void DesktopPlatform::pollEvents() {
+    inputLatency.pollGpu();
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         handleEvent(event);
@@ -91,10 +93,6 @@ bool DesktopPlatform::shouldQuit() const {
     return quitRequested;
 }
 
-void DesktopPlatform::setKeyHandler(std::function<void(int key)> handler) {
-    keyHandler = handler;
-}
-
 void DesktopPlatform::setWindowSize(int width, int height) {
     windowWidth = width;
     windowHeight = height;
@@ -124,9 +122,16 @@ void DesktopPlatform::handleEvent(const SDL_Event& event) {
         case SDL_KEYDOWN:
             if (event.key.keysym.sym == SDLK_ESCAPE) {
                 quitRequested = true;
-            } else if (keyHandler) {
-                keyHandler(event.key.keysym.sym);
+                return;
+            }
+            break;
+        case SDL_WINDOWEVENT:
+            if (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+                windowWidth = event.window.data1;
+                windowHeight = event.window.data2;
+                setViewport(windowWidth, windowHeight);
             }
             break;
     }
+    queueEvent(event);
 }
\ No newline at end of file
@@ -17,8 +17,6 @@ public:
     void pollEvents() override;
     bool shouldQuit() const override;
     
-    void setKeyHandler(std::function<void(int key)> handler) override;
-    
     void setWindowSize(int width, int height) override;
     SDL_Window* getWindow() override;
     
@@ -68,6 +68,7 @@ void WebPlatform::swapBuffers() {
     if (window) {
         SDL_GL_SwapWindow(window);
     }
+    inputLatency.framePresented();
 }
 
 void WebPlatform::setViewport(int width, int height) {
@@ -75,6 +76,7 @@ void WebPlatform::setViewport(int width, int height) {
 }
 
 void WebPlatform::pollEvents() {
+    inputLatency.pollGpu();
     SDL_Event event;
     while (SDL_PollEvent(&event)) {
         handleEvent(event);
@@ -85,10 +87,6 @@ bool WebPlatform::shouldQuit() const {
     return quitRequested;
 }
 
-void WebPlatform::setKeyHandler(std::function<void(int key)> handler) {
-    keyHandler = handler;
-}
-
 void WebPlatform::setWindowSize(int width, int height) {
     windowWidth = width;
     windowHeight = height;
@@ -112,9 +110,11 @@ bool WebPlatform::isWeb() const {
 
 void WebPlatform::handleEvent(const SDL_Event& event) {
     switch (event.type) {
-        case SDL_KEYDOWN:
-            if (keyHandler) {
-                keyHandler(event.key.keysym.sym);
+        case SDL_WINDOWEVENT:
+            if (event.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+                windowWidth = event.window.data1;
+                windowHeight = event.window.data2;
+                setViewport(windowWidth, windowHeight);
             }
             break;
         // Web typically doesn't get SDL_QUIT events, but handle anyway
@@ -122,4 +122,5 @@ void WebPlatform::handleEvent(const SDL_Event& event) {
             quitRequested = true;
             break;
     }
+    queueEvent(event);
 }
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "quad_renderer.h"
+#include "assets/asset_loader.h"
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+QuadRenderer::QuadRenderer(GraphicsAPI* graphics, GpuResources* resources, QuadIndexBuffer* quadIndices)
+    : graphics(graphics), resources(resources), quadIndices(quadIndices), batchTexture(0), projection(Mat4::identity()),
+      drawCalls(0) {
+}
+
+QuadRenderer::~QuadRenderer() {
+    cleanup();
+}
+
+bool QuadRenderer::initialize(AssetLoader& loader, int windowWidth, int windowHeight) {
+    shaderAsset = loader.load<ShaderAsset>(graphics->getVertexShaderPath("sprite"), graphics->getFragmentShaderPath("sprite"));
+    setViewportSize(windowWidth, windowHeight);
+    VBO = resources->createBuffer();
+    
+    // Solid rectangles sample a single white texel
+    const uint8_t white[4] = {255, 255, 255, 255};
+    whiteTexture = resources->createTexture();
+    graphics->bindTexture(GL_TEXTURE_2D, resources->get(whiteTexture));
+    graphics->texImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, white);
+    resources->setSize(whiteTexture, GpuResources::getTextureBytes(1, 1));
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    return true;
+}
+
+void QuadRenderer::fillRect(float x, float y, float width, float height, float r, float g, float b, float a) {
+    appendQuad(resources->get(whiteTexture), x, y, width, height, 0.0f, 0.0f, 1.0f, 1.0f, r * a, g * a, b * a, a);
+}
+
+void QuadRenderer::drawTexture(GLuint texture, float x, float y, float width, float height,
+                               float u0, float v0, float u1, float v1, float opacity) {
+    appendQuad(texture, x, y, width, height, u0, v0, u1, v1, opacity, opacity, opacity, opacity);
+}
+
+void QuadRenderer::drawSprites(const Sprite* sprites, size_t count) {
+    GLuint white = resources->get(whiteTexture);
+    batch.reserve(batch.size() + count * QuadIndexBuffer::VERTICES_PER_QUAD);
+    for (size_t i = 0; i < count; i++) {
+        const Sprite& sprite = sprites[i];
+        appendQuad(sprite.texture ? sprite.texture : white, sprite.x, sprite.y, sprite.width, sprite.height,
+                   sprite.u0, sprite.v0, sprite.u1, sprite.v1, sprite.r * sprite.a, sprite.g * sprite.a, sprite.b * sprite.a, sprite.a);
+    }
+}
+
+bool QuadRenderer::isReady() const {
+    return shaderAsset && shaderAsset->isReady();
+}
+
+void QuadRenderer::flush() {
+    if (batch.empty()) {
+        return;
+    }
+    if (!isReady()) {
+        batch.clear();
+        return;
+    }
+    Shader* shader = shaderAsset->getShader();
+    
+    GLuint buffer = resources->get(VBO);
+    graphics->bindBuffer(GL_ARRAY_BUFFER, buffer);
+    graphics->bufferData(GL_ARRAY_BUFFER, batch.size() * sizeof(QuadVertex), batch.data(), GL_DYNAMIC_DRAW);
+    resources->setSize(VBO, batch.size() * sizeof(QuadVertex));
+    
+    shader->use();
+    graphics->setupVertexArray(shader->getProgram(), buffer);
+    quadIndices->bind();
+    shader->setMat4("uProjection", projection.m);
+    shader->setInt("uTexture", 0);
+    graphics->activeTexture(GL_TEXTURE0);
+    graphics->bindTexture(GL_TEXTURE_2D, batchTexture);
+    graphics->blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    
+    int quadCount = (int)batch.size() / QuadIndexBuffer::VERTICES_PER_QUAD;
+    for (int first = 0; first < quadCount; first += QuadIndexBuffer::MAX_QUADS) {
+        int base = first * QuadIndexBuffer::VERTICES_PER_QUAD * sizeof(QuadVertex);
+        graphics->enableVertexAttribute(shader->getProgram(), "aPosition", 2, GL_FLOAT, sizeof(QuadVertex), base + offsetof(QuadVertex, x));
+        graphics->enableVertexAttribute(shader->getProgram(), "aTexCoord", 2, GL_FLOAT, sizeof(QuadVertex), base + offsetof(QuadVertex, u));
+        graphics->enableVertexAttribute(shader->getProgram(), "aColor", 4, GL_FLOAT, sizeof(QuadVertex), base + offsetof(QuadVertex, r));
+        
+        quadIndices->drawQuads(std::min(quadCount - first, QuadIndexBuffer::MAX_QUADS));
+        drawCalls++;
+    }
+    
+    graphics->disableVertexAttribute(shader->getProgram(), "aPosition");
+    graphics->disableVertexAttribute(shader->getProgram(), "aTexCoord");
+    graphics->disableVertexAttribute(shader->getProgram(), "aColor");
+    
+    // Back to the blending the text renderer set up
+    graphics->blendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    batch.clear();
+}
+
+void QuadRenderer::setViewportSize(int width, int height) {
+    projection = Mat4::ortho(0.0f, (float)width, (float)height, 0.0f);
+}
+
+void QuadRenderer::cleanup() {
+    if (resources) {
+        resources->destroy(VBO);
+        resources->destroy(whiteTexture);
+    }
+    batch.clear();
+    shaderAsset.reset();
+}
+
+void QuadRenderer::appendQuad(GLuint texture, float x, float y, float width, float height,
+                              float u0, float v0, float u1, float v1, float r, float g, float b, float a) {
+    // A texture change ends the batch
+    if (texture != batchTexture && !batch.empty()) {
+        flush();
+    }
+    batchTexture = texture;
+    
+    QuadVertex topLeft     = {x,         y,          u0, v0, r, g, b, a};
+    QuadVertex topRight    = {x + width, y,          u1, v0, r, g, b, a};
+    QuadVertex bottomRight = {x + width, y + height, u1, v1, r, g, b, a};
+    QuadVertex bottomLeft  = {x,         y + height, u0, v1, r, g, b, a};
+    batch.push_back(topLeft);
+    batch.push_back(topRight);
+    batch.push_back(bottomRight);
+    batch.push_back(bottomLeft);
+}
\ No newline at end of file
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "shader_asset.h"
+#include "transform.h"
+#include "graphics/gpu_resources.h"
+#include "graphics/graphics_api.h"
+#include "graphics/quad_index_buffer.h"
+
+class AssetLoader;
+
+// A rectangle as stored per entity and drawn in bulk by drawSprites. Colors are
+// straight alpha, like fillRect; a texture is tinted by the color.
+struct Sprite {
+    float x = 0.0f, y = 0.0f;
+    float width = 0.0f, height = 0.0f;
+    float r = 1.0f, g = 1.0f, b = 1.0f, a = 1.0f;
+    GLuint texture = 0; // 0 fills with the color
+    float u0 = 0.0f, v0 = 0.0f, u1 = 1.0f, v1 = 1.0f;
+};
+
+// Batched solid and textured rectangles (panel backgrounds, composited render
+// targets). Consecutive quads with the same texture share one draw call.
+// Colors and textures use premultiplied alpha, which is what render targets
+// hold after text and quads are blended into them.
+class QuadRenderer {
+public:
+    QuadRenderer(GraphicsAPI* graphics, GpuResources* resources, QuadIndexBuffer* quadIndices);
+    ~QuadRenderer();
+    
+    // Start loading the shaders; quads queued before they are ready are dropped at flush
+    bool initialize(AssetLoader& loader, int windowWidth, int windowHeight);
+    
+    // Queue a solid rectangle
+    void fillRect(float x, float y, float width, float height, float r, float g, float b, float a = 1.0f);
+    
+    // Queue a textured rectangle; (u0, v0) maps to the top-left corner
+    void drawTexture(GLuint texture, float x, float y, float width, float height,
+                     float u0, float v0, float u1, float v1, float opacity = 1.0f);
+    
+    // Queue a packed array of sprites, such as a component array, in one pass;
+    // runs of the same texture share a draw call
+    void drawSprites(const Sprite* sprites, size_t count);
+    
+    // Draw everything queued since the last flush. Until the shaders are ready
+    // the queued quads are dropped.
+    void flush();
+    bool isReady() const;
+    
+    // Update the projection after a resize (or to draw into a render target)
+    void setViewportSize(int width, int height);
+    
+    int getDrawCallCount() const { return drawCalls; }
+    
+    void cleanup();
+
+private:
+    struct QuadVertex {
+        float x, y;
+        float u, v;
+        float r, g, b, a;
+    };
+    
+    GraphicsAPI* graphics;
+    GpuResources* resources;
+    QuadIndexBuffer* quadIndices;
+    std::shared_ptr<ShaderAsset> shaderAsset;
+    TextureHandle whiteTexture;
+    GLuint batchTexture; // Texture of the quads in the batch
+    std::vector<QuadVertex> batch;
+    BufferHandle VBO;
+    Mat4 projection;
+    int drawCalls;
+    
+    void appendQuad(GLuint texture, float x, float y, float width, float height,
+                    float u0, float v0, float u1, float v1, float r, float g, float b, float a);
+};
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include <sstream>
 #include <iostream>
 
-Shader::Shader(GraphicsAPI* graphics) : program(0), graphics(graphics) {
+Shader::Shader(GraphicsAPI* graphics) : graphics(graphics), program(0) {
 }
 
 Shader::~Shader() {
@@ -22,6 +22,15 @@ bool Shader::loadFromFiles(const std::string& vertexPath, const std::string& fra
         return false;
     }
     
+    return loadFromSources(vertexSource, fragmentSource);
+}
+
+bool Shader::loadFromSources(std::string_view vertexSource, std::string_view fragmentSource) {
+    if (vertexSource.empty() || fragmentSource.empty()) {
+        printf("Empty shader source\n");
+        return false;
+    }
+    
     // Compile shaders using graphics API
     GLuint vertexShader = graphics->compileShader(GL_VERTEX_SHADER, vertexSource);
     GLuint fragmentShader = graphics->compileShader(GL_FRAGMENT_SHADER, fragmentSource);
@@ -54,6 +63,12 @@ void Shader::setFloat(const std::string& name, float value) {
     }
 }
 
+void Shader::setVec2(const std::string& name, float x, float y) {
+    if (graphics) {
+        graphics->setUniform2f(program, name, x, y);
+    }
+}
+
 void Shader::setVec3(const std::string& name, float x, float y, float z) {
     if (graphics) {
         graphics->setUniform3f(program, name, x, y, z);
@@ -66,6 +81,12 @@ void Shader::setInt(const std::string& name, int value) {
     }
 }
 
+void Shader::setMat4(const std::string& name, const float* value) {
+    if (graphics) {
+        graphics->setUniformMatrix4fv(program, name, value);
+    }
+}
+
 std::string Shader::loadFile(const std::string& filepath) {
     std::ifstream file(filepath);
     if (!file.is_open()) {
@@ -2,28 +2,36 @@
 
 #include "graphics/graphics_api.h"
 #include <string>
+#include <string_view>
 #include <memory>
 
 class Shader {
 public:
-    GLuint program;
-    
     Shader(GraphicsAPI* graphics);
     ~Shader();
     
     // Load and compile shaders from files
     bool loadFromFiles(const std::string& vertexPath, const std::string& fragmentPath);
     
+    // Compile shaders from in-memory sources (e.g. spans from an asset pack)
+    bool loadFromSources(std::string_view vertexSource, std::string_view fragmentSource);
+    
     // Use the shader program
     void use();
     
+    // Program object for vertex attribute setup; owned by the shader
+    GLuint getProgram() const { return program; }
+    
     // Utility functions for setting uniforms
     void setFloat(const std::string& name, float value);
+    void setVec2(const std::string& name, float x, float y);
     void setVec3(const std::string& name, float x, float y, float z);
     void setInt(const std::string& name, int value);
+    void setMat4(const std::string& name, const float* value);
     
 private:
     GraphicsAPI* graphics;
+    GLuint program;
     
     // Load file contents as string
     std::string loadFile(const std::string& filepath);
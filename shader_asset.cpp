@@ -0,0 +1,34 @@
+#include "shader_asset.h"
+#include "assets/asset_loader.h"
+#include <iostream>
+
+ShaderAsset::ShaderAsset(const std::string& vertexName, const std::string& fragmentName)
+    : Asset(vertexName), fragmentName(fragmentName) {
+}
+
+bool ShaderAsset::decode(AssetLoader& loader) {
+    std::vector<uint8_t> storage;
+    AssetSpan vertex = loader.read(name, storage);
+    vertexSource = std::string(vertex.asString());
+    
+    AssetSpan fragment = loader.read(fragmentName, storage);
+    fragmentSource = std::string(fragment.asString());
+    
+    if (vertexSource.empty() || fragmentSource.empty()) {
+        printf("Failed to load shader files\n");
+        return false;
+    }
+    return true;
+}
+
+bool ShaderAsset::finalize(GraphicsAPI* graphics) {
+    shader = std::make_unique<Shader>(graphics);
+    bool compiled = shader->loadFromSources(vertexSource, fragmentSource);
+    
+    // Sources are only needed until the program links
+    vertexSource.clear();
+    vertexSource.shrink_to_fit();
+    fragmentSource.clear();
+    fragmentSource.shrink_to_fit();
+    return compiled;
+}
\ No newline at end of file
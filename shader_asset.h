@@ -0,0 +1,25 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include "assets/asset.h"
+#include "shader.h"
+
+// Vertex/fragment source pair read on a worker and compiled on the render thread
+class ShaderAsset : public Asset {
+public:
+    ShaderAsset(const std::string& vertexName, const std::string& fragmentName);
+    
+    // Valid once the asset is ready
+    Shader* getShader() const { return shader.get(); }
+
+protected:
+    bool decode(AssetLoader& loader) override;
+    bool finalize(GraphicsAPI* graphics) override;
+
+private:
+    std::string fragmentName;
+    std::string vertexSource;
+    std::string fragmentSource;
+    std::unique_ptr<Shader> shader;
+};
\ No newline at end of file
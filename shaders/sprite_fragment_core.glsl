@@ -0,0 +1,11 @@
+#version 330 core
+// stage: sprite
+in vec2 vTexCoord;
+in vec4 vColor;
+out vec4 FragColor;
+uniform sampler2D uTexture;
+
+// Texture and color are both premultiplied
+void main() {
+    FragColor = texture(uTexture, vTexCoord) * vColor;
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+// stage: sprite
+precision mediump float;
+varying vec2 vTexCoord;
+varying vec4 vColor;
+uniform sampler2D uTexture;
+
+// Texture and color are both premultiplied
+void main() {
+    gl_FragColor = texture2D(uTexture, vTexCoord) * vColor;
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+attribute vec2 aPosition;
+attribute vec2 aTexCoord;
+attribute vec4 aColor;
+varying vec2 vTexCoord;
+varying vec4 vColor;
+uniform mat4 uProjection;
+
+void main() {
+    gl_Position = uProjection * vec4(aPosition, 0.0, 1.0);
+    vTexCoord = aTexCoord;
+    vColor = aColor;
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#version 330 core
+// stage: terminal
+in vec2 vGridPosition;
+out vec4 FragColor;
+uniform sampler2D uAtlas;
+uniform sampler2D uCells;    // columns x rows: atlas cell (lo, hi), foreground, background
+uniform sampler2D uPalette;  // 256 x 1
+uniform vec2 uGridSize;
+uniform vec2 uCellSize;
+uniform vec2 uAtlasSize;
+uniform vec2 uAtlasCellSize;
+uniform vec2 uGlyphSize;
+uniform float uAtlasColumns;
+uniform float uAtlasPadding;
+
+void main() {
+    vec2 cell = min(floor(vGridPosition / uCellSize), uGridSize - 1.0);
+    vec2 local = vGridPosition - cell * uCellSize;
+    vec4 data = texelFetch(uCells, ivec2(cell), 0) * 255.0 + 0.5;
+    float glyph = floor(data.r) + floor(data.g) * 256.0;
+    vec4 foreground = texelFetch(uPalette, ivec2(int(data.b), 0), 0);
+    vec4 background = texelFetch(uPalette, ivec2(int(data.a), 0), 0);
+    
+    // Glyph pixels sit at the top-left of their atlas cell, one texel per screen pixel
+    vec2 atlasCell = vec2(mod(glyph, uAtlasColumns), floor(glyph / uAtlasColumns));
+    vec2 atlasPixel = atlasCell * uAtlasCellSize + uAtlasPadding + local;
+    float inside = step(local.x, uGlyphSize.x) * step(local.y, uGlyphSize.y);
+    float coverage = texture(uAtlas, atlasPixel / uAtlasSize).a * inside * foreground.a;
+    
+    float alpha = coverage + background.a * (1.0 - coverage);
+    vec3 color = foreground.rgb * coverage + background.rgb * background.a * (1.0 - coverage);
+    FragColor = vec4(alpha > 0.0 ? color / alpha : color, alpha);
+}
\ No newline at end of file
@@ -0,0 +1,36 @@
+// stage: terminal
+#ifdef GL_FRAGMENT_PRECISION_HIGH
+precision highp float;
+#else
+precision mediump float;
+#endif
+varying vec2 vGridPosition;
+uniform sampler2D uAtlas;
+uniform sampler2D uCells;    // columns x rows: atlas cell (lo, hi), foreground, background
+uniform sampler2D uPalette;  // 256 x 1
+uniform vec2 uGridSize;
+uniform vec2 uCellSize;
+uniform vec2 uAtlasSize;
+uniform vec2 uAtlasCellSize;
+uniform vec2 uGlyphSize;
+uniform float uAtlasColumns;
+uniform float uAtlasPadding;
+
+void main() {
+    vec2 cell = min(floor(vGridPosition / uCellSize), uGridSize - 1.0);
+    vec2 local = vGridPosition - cell * uCellSize;
+    vec4 data = floor(texture2D(uCells, (cell + 0.5) / uGridSize) * 255.0 + 0.5);
+    float glyph = data.r + data.g * 256.0;
+    vec4 foreground = texture2D(uPalette, vec2((data.b + 0.5) / 256.0, 0.5));
+    vec4 background = texture2D(uPalette, vec2((data.a + 0.5) / 256.0, 0.5));
+    
+    // Glyph pixels sit at the top-left of their atlas cell, one texel per screen pixel
+    vec2 atlasCell = vec2(mod(glyph, uAtlasColumns), floor(glyph / uAtlasColumns));
+    vec2 atlasPixel = atlasCell * uAtlasCellSize + uAtlasPadding + local;
+    float inside = step(local.x, uGlyphSize.x) * step(local.y, uGlyphSize.y);
+    float coverage = texture2D(uAtlas, atlasPixel / uAtlasSize).a * inside * foreground.a;
+    
+    float alpha = coverage + background.a * (1.0 - coverage);
+    vec3 color = foreground.rgb * coverage + background.rgb * background.a * (1.0 - coverage);
+    gl_FragColor = vec4(alpha > 0.0 ? color / alpha : color, alpha);
+}
\ No newline at end of file
@@ -0,0 +1,10 @@
+#version 330 core
+layout (location = 0) in vec2 aPosition;
+layout (location = 1) in vec2 aTexCoord;
+out vec2 vGridPosition;
+uniform mat4 uProjection;
+
+void main() {
+    gl_Position = uProjection * vec4(aPosition, 0.0, 1.0);
+    vGridPosition = aTexCoord;
+}
\ No newline at end of file
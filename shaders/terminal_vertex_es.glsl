@@ -0,0 +1,9 @@
+attribute vec2 aPosition;
+attribute vec2 aTexCoord;
+varying vec2 vGridPosition;
+uniform mat4 uProjection;
+
+void main() {
+    gl_Position = uProjection * vec4(aPosition, 0.0, 1.0);
+    vGridPosition = aTexCoord;
+}
\ No newline at end of file
@@ -1,10 +1,11 @@
 #version 330 core
+// stage: text
 in vec2 vTexCoord;
+in vec4 vColor;
 out vec4 FragColor;
 uniform sampler2D uTexture;
-uniform vec3 uColor;
 
 void main() {
     vec4 texColor = texture(uTexture, vTexCoord);
-    FragColor = vec4(uColor, texColor.a);
+    FragColor = vec4(vColor.rgb, vColor.a * texColor.a);
 }
\ No newline at end of file
@@ -1,9 +1,10 @@
+// stage: text
 precision mediump float;
 varying vec2 vTexCoord;
+varying vec4 vColor;
 uniform sampler2D uTexture;
-uniform vec3 uColor;
 
 void main() {
     vec4 texColor = texture2D(uTexture, vTexCoord);
-    gl_FragColor = vec4(uColor, texColor.a);
+    gl_FragColor = vec4(vColor.rgb, vColor.a * texColor.a);
 }
\ No newline at end of file
@@ -1,9 +1,14 @@
 #version 330 core
 layout (location = 0) in vec2 aPosition;
 layout (location = 1) in vec2 aTexCoord;
+layout (location = 2) in vec4 aColor;
 out vec2 vTexCoord;
+out vec4 vColor;
+uniform mat4 uProjection;
+uniform mat4 uModel;
 
 void main() {
-    gl_Position = vec4(aPosition, 0.0, 1.0);
+    gl_Position = uProjection * uModel * vec4(aPosition, 0.0, 1.0);
     vTexCoord = aTexCoord;
+    vColor = aColor;
 }
\ No newline at end of file
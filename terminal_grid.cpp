@@ -0,0 +1,294 @@
+#include "terminal_grid.h"
+#include "assets/asset_loader.h"
+#include "text_markup.h"
+#include "utf8.h"
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+
+TerminalGrid::TerminalGrid(GraphicsAPI* graphics, GpuResources* resources, QuadIndexBuffer* quadIndices)
+    : graphics(graphics), resources(resources), quadIndices(quadIndices), fontResident(false), columns(0), rows(0),
+      cellWidth(0.0f), cellHeight(0.0f), dirtyBegin(0), dirtyEnd(0), paletteDirty(false), projection(Mat4::identity()) {
+}
+
+TerminalGrid::~TerminalGrid() {
+    cleanup();
+}
+
+bool TerminalGrid::initialize(AssetLoader& loader, const std::string& fontName, int fontSize, int columns, int rows,
+                              int windowWidth, int windowHeight) {
+    fontAsset = loader.load<FontAsset>(fontName, fontSize);
+    shaderAsset = loader.load<ShaderAsset>(graphics->getVertexShaderPath("terminal"), graphics->getFragmentShaderPath("terminal"));
+    
+    // Monospace estimate until the real metrics arrive
+    cellWidth = fontSize * 0.6f;
+    cellHeight = fontSize * 1.2f;
+    projection = Mat4::ortho(0.0f, (float)windowWidth, (float)windowHeight, 0.0f);
+    
+    palette.resize(256 * 4);
+    for (int i = 0; i < 256; i++) {
+        TextColor color = getPaletteColor(i);
+        setPaletteColor(i, color.r, color.g, color.b, color.a);
+    }
+    
+    const uint8_t transparent[4] = {0, 0, 0, 0};
+    blankTexture = createDataTexture(1, 1, transparent);
+    paletteTexture = createDataTexture(256, 1, palette.data());
+    paletteDirty = false;
+    VBO = resources->createBuffer();
+    
+    resize(columns, rows);
+    printf("Terminal grid initialized: %dx%d cells\n", columns, rows);
+    return true;
+}
+
+void TerminalGrid::resize(int newColumns, int newRows) {
+    newColumns = std::max(1, newColumns);
+    newRows = std::max(1, newRows);
+    
+    std::vector<TerminalCell> resized((size_t)newColumns * newRows, TerminalCell{' ', 7, 0});
+    for (int row = 0; row < std::min(rows, newRows); row++) {
+        for (int column = 0; column < std::min(columns, newColumns); column++) {
+            resized[(size_t)row * newColumns + column] = cells[(size_t)row * columns + column];
+        }
+    }
+    cells.swap(resized);
+    columns = newColumns;
+    rows = newRows;
+    
+    // Allocate the cell texture at the new size; contents follow on the next draw
+    releasePins();
+    cellPins.assign(cells.size(), 0);
+    texels.assign(cells.size() * 4, 0);
+    // The old texture may still be read by frames in flight
+    resources->destroy(cellTexture);
+    cellTexture = createDataTexture(columns, rows, texels.data());
+    markDirty(0, rows);
+}
+
+void TerminalGrid::setCell(int column, int row, uint32_t codepoint, uint8_t foreground, uint8_t background) {
+    if (column < 0 || column >= columns || row < 0 || row >= rows) {
+        return;
+    }
+    
+    TerminalCell& cell = cells[(size_t)row * columns + column];
+    if (cell.codepoint == codepoint && cell.foreground == foreground && cell.background == background) {
+        return; // Rewriting an unchanged screen uploads nothing
+    }
+    cell = TerminalCell{codepoint, foreground, background};
+    markDirty(row, row + 1);
+}
+
+int TerminalGrid::write(int column, int row, std::string_view text, uint8_t foreground, uint8_t background) {
+    int start = column;
+    size_t i = 0;
+    while (i < text.size() && column < columns) {
+        setCell(column++, row, nextCodepoint(text, i), foreground, background);
+    }
+    return column - start;
+}
+
+void TerminalGrid::clear(uint8_t foreground, uint8_t background) {
+    std::fill(cells.begin(), cells.end(), TerminalCell{' ', foreground, background});
+    markDirty(0, rows);
+}
+
+void TerminalGrid::scroll(int lines, uint8_t foreground, uint8_t background) {
+    lines = std::min(std::max(lines, 0), rows);
+    if (lines == 0) {
+        return;
+    }
+    
+    std::move(cells.begin() + (size_t)lines * columns, cells.end(), cells.begin());
+    std::fill(cells.end() - (size_t)lines * columns, cells.end(), TerminalCell{' ', foreground, background});
+    markDirty(0, rows);
+}
+
+void TerminalGrid::setPaletteColor(int index, float r, float g, float b, float a) {
+    uint8_t* entry = &palette[(index & 0xFF) * 4];
+    entry[0] = (uint8_t)(std::min(std::max(r, 0.0f), 1.0f) * 255.0f + 0.5f);
+    entry[1] = (uint8_t)(std::min(std::max(g, 0.0f), 1.0f) * 255.0f + 0.5f);
+    entry[2] = (uint8_t)(std::min(std::max(b, 0.0f), 1.0f) * 255.0f + 0.5f);
+    entry[3] = (uint8_t)(std::min(std::max(a, 0.0f), 1.0f) * 255.0f + 0.5f);
+    paletteDirty = true;
+}
+
+void TerminalGrid::draw(float x, float y) {
+    updateFontResidency();
+    if (!shaderAsset || !shaderAsset->isReady()) {
+        return;
+    }
+    uploadCells();
+    
+    // One quad covering the grid; the fragment shader does the rest
+    float width = columns * cellWidth;
+    float height = rows * cellHeight;
+    GridVertex quad[4] = {
+        {x,         y,          0.0f,  0.0f},
+        {x + width, y,          width, 0.0f},
+        {x + width, y + height, width, height},
+        {x,         y + height, 0.0f,  height}
+    };
+    GLuint buffer = resources->get(VBO);
+    graphics->bindBuffer(GL_ARRAY_BUFFER, buffer);
+    graphics->bufferData(GL_ARRAY_BUFFER, sizeof(quad), quad, GL_DYNAMIC_DRAW);
+    resources->setSize(VBO, sizeof(quad));
+    
+    Shader* shader = shaderAsset->getShader();
+    shader->use();
+    graphics->setupVertexArray(shader->getProgram(), buffer);
+    quadIndices->bind();
+    
+    GlyphAtlas* atlas = fontResident ? fontAsset->getAtlas() : nullptr;
+    shader->setMat4("uProjection", projection.m);
+    shader->setInt("uAtlas", 0);
+    shader->setInt("uCells", 1);
+    shader->setInt("uPalette", 2);
+    shader->setVec2("uGridSize", (float)columns, (float)rows);
+    shader->setVec2("uCellSize", cellWidth, cellHeight);
+    if (atlas) {
+        float inner = (float)(atlas->getCellWidth() - atlas->getCellPadding() * 2);
+        float innerHeight = (float)(atlas->getCellHeight() - atlas->getCellPadding() * 2);
+        shader->setVec2("uAtlasSize", (float)atlas->getTextureWidth(), (float)atlas->getTextureHeight());
+        shader->setVec2("uAtlasCellSize", (float)atlas->getCellWidth(), (float)atlas->getCellHeight());
+        shader->setVec2("uGlyphSize", inner, innerHeight);
+        shader->setFloat("uAtlasColumns", (float)atlas->getGridColumns());
+        shader->setFloat("uAtlasPadding", (float)atlas->getCellPadding());
+    } else {
+        // Blank 1x1 atlas: backgrounds only
+        shader->setVec2("uAtlasSize", 1.0f, 1.0f);
+        shader->setVec2("uAtlasCellSize", 1.0f, 1.0f);
+        shader->setVec2("uGlyphSize", 0.0f, 0.0f);
+        shader->setFloat("uAtlasColumns", 1.0f);
+        shader->setFloat("uAtlasPadding", 0.0f);
+    }
+    
+    graphics->activeTexture(GL_TEXTURE0);
+    graphics->bindTexture(GL_TEXTURE_2D, atlas ? atlas->getTexture() : resources->get(blankTexture));
+    graphics->activeTexture(GL_TEXTURE0 + 1);
+    graphics->bindTexture(GL_TEXTURE_2D, resources->get(cellTexture));
+    graphics->activeTexture(GL_TEXTURE0 + 2);
+    graphics->bindTexture(GL_TEXTURE_2D, resources->get(paletteTexture));
+    
+    graphics->enableVertexAttribute(shader->getProgram(), "aPosition", 2, GL_FLOAT, sizeof(GridVertex), offsetof(GridVertex, x));
+    graphics->enableVertexAttribute(shader->getProgram(), "aTexCoord", 2, GL_FLOAT, sizeof(GridVertex), offsetof(GridVertex, u));
+    quadIndices->drawQuads(1);
+    graphics->disableVertexAttribute(shader->getProgram(), "aPosition");
+    graphics->disableVertexAttribute(shader->getProgram(), "aTexCoord");
+    
+    // Other renderers bind on unit 0 without selecting it. The atlas batch
+    // belongs to the text renderer; the grid's glyphs are held by pins instead.
+    graphics->activeTexture(GL_TEXTURE0);
+}
+
+void TerminalGrid::setViewportSize(int width, int height) {
+    projection = Mat4::ortho(0.0f, (float)width, (float)height, 0.0f);
+}
+
+void TerminalGrid::cleanup() {
+    if (resources) {
+        resources->destroy(cellTexture);
+        resources->destroy(paletteTexture);
+        resources->destroy(blankTexture);
+        resources->destroy(VBO);
+    }
+    
+    releasePins();
+    cells.clear();
+    cellPins.clear();
+    texels.clear();
+    columns = 0;
+    rows = 0;
+    fontResident = false;
+    fontAsset.reset();
+    shaderAsset.reset();
+}
+
+void TerminalGrid::markDirty(int beginRow, int endRow) {
+    if (dirtyBegin == dirtyEnd) {
+        dirtyBegin = beginRow;
+        dirtyEnd = endRow;
+    } else {
+        dirtyBegin = std::min(dirtyBegin, beginRow);
+        dirtyEnd = std::max(dirtyEnd, endRow);
+    }
+}
+
+void TerminalGrid::updateFontResidency() {
+    if (fontResident || !fontAsset || !fontAsset->isReady()) {
+        return;
+    }
+    
+    if (fontAsset->getAtlas()->getGridColumns() == 0) {
+        printf("Terminal grid needs a TTF font, not a baked atlas: %s\n", fontAsset->getName().c_str());
+        fontAsset.reset();
+        return;
+    }
+    fontResident = true;
+    
+    // Cells are sized by the font's advance and line height, not its glyph boxes
+    FontMetrics& metrics = fontAsset->getLayout()->getMetrics();
+    cellWidth = (float)(int)(metrics.getAdvance('M') + 0.5f);
+    cellHeight = metrics.getLineHeight();
+    markDirty(0, rows);
+}
+
+void TerminalGrid::uploadCells() {
+    if (paletteDirty) {
+        graphics->bindTexture(GL_TEXTURE_2D, resources->get(paletteTexture));
+        graphics->texSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 256, 1, GL_RGBA, GL_UNSIGNED_BYTE, palette.data());
+        paletteDirty = false;
+    }
+    if (dirtyBegin == dirtyEnd) {
+        return;
+    }
+    
+    // Each cell pins the glyph it shows for as long as it shows it
+    GlyphAtlas* atlas = fontResident ? fontAsset->getAtlas() : nullptr;
+    for (size_t i = (size_t)dirtyBegin * columns; i < (size_t)dirtyEnd * columns; i++) {
+        const TerminalCell& cell = cells[i];
+        int glyph = atlas && cell.codepoint != ' ' ? atlas->getCellIndex(cell.codepoint) : -1;
+        if (atlas && cellPins[i] != cell.codepoint) {
+            if (cellPins[i]) {
+                atlas->unpin(cellPins[i]);
+            }
+            cellPins[i] = glyph >= 0 && atlas->pin(cell.codepoint) ? cell.codepoint : 0;
+        }
+        glyph = std::max(glyph, 0); // Cell 0 holds the blank space glyph
+        texels[i * 4 + 0] = (uint8_t)(glyph & 0xFF);
+        texels[i * 4 + 1] = (uint8_t)(glyph >> 8);
+        texels[i * 4 + 2] = cell.foreground;
+        texels[i * 4 + 3] = cell.background;
+    }
+    
+    graphics->bindTexture(GL_TEXTURE_2D, resources->get(cellTexture));
+    graphics->texSubImage2D(GL_TEXTURE_2D, 0, 0, dirtyBegin, columns, dirtyEnd - dirtyBegin, GL_RGBA, GL_UNSIGNED_BYTE,
+                            &texels[(size_t)dirtyBegin * columns * 4]);
+    dirtyBegin = 0;
+    dirtyEnd = 0;
+}
+
+void TerminalGrid::releasePins() {
+    GlyphAtlas* atlas = fontResident ? fontAsset->getAtlas() : nullptr;
+    if (atlas) {
+        for (uint32_t codepoint : cellPins) {
+            if (codepoint) {
+                atlas->unpin(codepoint);
+            }
+        }
+    }
+    std::fill(cellPins.begin(), cellPins.end(), 0);
+}
+
+TextureHandle TerminalGrid::createDataTexture(int width, int height, const void* data) {
+    // Texels are looked up, never filtered
+    TextureHandle texture = resources->createTexture();
+    graphics->bindTexture(GL_TEXTURE_2D, resources->get(texture));
+    graphics->texImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, GL_RGBA, GL_UNSIGNED_BYTE, data);
+    resources->setSize(texture, GpuResources::getTextureBytes(width, height));
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    return texture;
+}
\ No newline at end of file
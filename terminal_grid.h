@@ -0,0 +1,113 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "font_asset.h"
+#include "shader_asset.h"
+#include "transform.h"
+#include "graphics/graphics_api.h"
+#include "graphics/gpu_resources.h"
+#include "graphics/quad_index_buffer.h"
+
+class AssetLoader;
+
+// One character cell; colors index the 256-entry palette
+struct TerminalCell {
+    uint32_t codepoint;
+    uint8_t foreground;
+    uint8_t background;
+};
+
+// Fixed-pitch character grid drawn as a single quad. Each cell is 4 bytes in
+// a columns x rows texture (atlas cell index, foreground, background) and the
+// fragment shader looks the glyph up in the font's grid atlas, so a full
+// 200x60 refresh costs one small texture upload and one draw regardless of
+// how much text is on screen. Needs a TTF font; baked atlases aren't gridded.
+class TerminalGrid {
+public:
+    TerminalGrid(GraphicsAPI* graphics, GpuResources* resources, QuadIndexBuffer* quadIndices);
+    ~TerminalGrid();
+    
+    // Start loading the font and shaders; backgrounds are drawn until the font is resident
+    bool initialize(AssetLoader& loader, const std::string& fontName, int fontSize, int columns, int rows,
+                    int windowWidth, int windowHeight);
+    
+    // Change the grid size; existing cells are kept where they overlap
+    void resize(int columns, int rows);
+    
+    // Cell writes only touch CPU memory; changed rows are uploaded on the next draw
+    void setCell(int column, int row, uint32_t codepoint, uint8_t foreground, uint8_t background);
+    const TerminalCell& getCell(int column, int row) const { return cells[(size_t)row * columns + column]; }
+    
+    // Write UTF-8 text from (column, row), clipped at the right edge. Returns columns written.
+    int write(int column, int row, std::string_view text, uint8_t foreground, uint8_t background);
+    
+    // Fill every cell with blanks of the given colors
+    void clear(uint8_t foreground, uint8_t background);
+    
+    // Move every row up by lines, clearing the rows uncovered at the bottom
+    void scroll(int lines, uint8_t foreground, uint8_t background);
+    
+    // Palette entries default to the xterm 256-color palette; alpha 0 gives a see-through background
+    void setPaletteColor(int index, float r, float g, float b, float a = 1.0f);
+    
+    // Draw the whole grid with its top-left corner at (x, y)
+    void draw(float x, float y);
+    
+    // Update the projection after a resize
+    void setViewportSize(int width, int height);
+    
+    int getColumns() const { return columns; }
+    int getRows() const { return rows; }
+    
+    // Cell size in pixels (an estimate until the font is resident)
+    float getCellWidth() const { return cellWidth; }
+    float getCellHeight() const { return cellHeight; }
+    
+    bool isFontReady() const { return fontResident; }
+    
+    void cleanup();
+
+private:
+    struct GridVertex {
+        float x, y;
+        float u, v; // Pixels from the grid's top-left corner
+    };
+    
+    GraphicsAPI* graphics;
+    GpuResources* resources;
+    QuadIndexBuffer* quadIndices;
+    std::shared_ptr<FontAsset> fontAsset;
+    std::shared_ptr<ShaderAsset> shaderAsset;
+    bool fontResident;
+    int columns, rows;
+    float cellWidth, cellHeight;
+    std::vector<TerminalCell> cells;
+    std::vector<uint8_t> texels;  // GPU copy of the cells, 4 bytes each
+    std::vector<uint32_t> cellPins; // Codepoint each cell holds an atlas pin for, 0 for none
+    std::vector<uint8_t> palette; // 256 RGBA entries
+    int dirtyBegin, dirtyEnd;     // Rows changed since the last upload
+    bool paletteDirty;
+    TextureHandle cellTexture;
+    TextureHandle paletteTexture;
+    TextureHandle blankTexture; // Stands in for the atlas until the font is resident
+    BufferHandle VBO;
+    Mat4 projection;
+    
+    void markDirty(int beginRow, int endRow);
+    
+    // Switch to the real atlas once the font is ready; every row is re-resolved
+    void updateFontResidency();
+    
+    // Resolve changed rows to atlas cells and upload them
+    void uploadCells();
+    
+    // Drop every pin the cells hold, before the cells or the font go away
+    void releasePins();
+    
+    // Create a texture sampled texel-exact
+    TextureHandle createDataTexture(int width, int height, const void* data);
+};
\ No newline at end of file
@@ -0,0 +1,331 @@
+#include "text_layout.h"
+#include "text_markup.h"
+#include "baked_font.h"
+#include "utf8.h"
+#include "core/job_system.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+FontMetrics::FontMetrics(TTF_Font* font)
+    : font(font), kerningEnabled(false), lineHeight(0.0f), kerning(TABLE_SIZE * TABLE_SIZE) {
+    for (std::atomic<int16_t>& entry : kerning) {
+        entry.store(KERNING_UNKNOWN, std::memory_order_relaxed);
+    }
+
+    kerningEnabled = TTF_GetFontKerning(font) != 0;
+    lineHeight = (float)TTF_FontLineSkip(font);
+    
+    // Latin-1 advances are read up front so layout never calls into the font for them
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        int advance = 0;
+        if (TTF_GlyphMetrics(font, (Uint16)i, nullptr, nullptr, nullptr, nullptr, &advance) != 0) {
+            advance = 0;
+        }
+        advances[i] = (float)advance;
+    }
+}
+
+FontMetrics::FontMetrics(const BakedFont& baked, const BakedFaceRecord& face)
+    : font(nullptr), kerningEnabled(face.kerningCount > 0), lineHeight(face.lineHeight), kerning(TABLE_SIZE * TABLE_SIZE) {
+    // Pairs missing from the bake have no kerning
+    for (std::atomic<int16_t>& entry : kerning) {
+        entry.store(0, std::memory_order_relaxed);
+    }
+    for (int i = 0; i < TABLE_SIZE; i++) {
+        advances[i] = 0.0f;
+    }
+    
+    const BakedGlyphRecord* glyphs = baked.getGlyphs(face);
+    for (uint32_t i = 0; i < face.glyphCount; i++) {
+        if (glyphs[i].codepoint < TABLE_SIZE) {
+            advances[glyphs[i].codepoint] = glyphs[i].advance;
+        } else {
+            extendedAdvances[glyphs[i].codepoint] = glyphs[i].advance;
+        }
+    }
+    
+    // BakedFont::load checked the pairs are sorted, so the extended ones stay in key order
+    const BakedKerningRecord* pairs = baked.getKerning(face);
+    for (uint32_t i = 0; i < face.kerningCount; i++) {
+        const BakedKerningRecord& pair = pairs[i];
+        if (pair.left < TABLE_SIZE && pair.right < TABLE_SIZE) {
+            kerning[pair.left * TABLE_SIZE + pair.right].store((int16_t)pair.amount, std::memory_order_relaxed);
+        } else {
+            extendedKerning.push_back(KerningPair{(uint64_t)pair.left << 32 | pair.right, pair.amount});
+        }
+    }
+}
+
+float FontMetrics::getAdvance(uint32_t codepoint) {
+    if (codepoint < TABLE_SIZE) {
+        return advances[codepoint];
+    }
+    
+    std::lock_guard<std::mutex> lock(fontMutex);
+    auto it = extendedAdvances.find(codepoint);
+    if (it != extendedAdvances.end()) {
+        return it->second;
+    }
+    if (!font) {
+        return 0.0f; // Not in the bake
+    }
+    
+    int advance = 0;
+    if (TTF_GlyphMetrics32(font, codepoint, nullptr, nullptr, nullptr, nullptr, &advance) != 0) {
+        advance = 0;
+    }
+    extendedAdvances[codepoint] = (float)advance;
+    return (float)advance;
+}
+
+float FontMetrics::getKerning(uint32_t left, uint32_t right) {
+    if (!kerningEnabled) {
+        return 0.0f;
+    }
+    if (!font && (left >= TABLE_SIZE || right >= TABLE_SIZE)) {
+        // Baked metrics are read-only after construction
+        uint64_t key = (uint64_t)left << 32 | right;
+        auto it = std::lower_bound(extendedKerning.begin(), extendedKerning.end(), key,
+                                   [](const KerningPair& pair, uint64_t value) { return pair.key < value; });
+        return it != extendedKerning.end() && it->key == key ? it->amount : 0.0f;
+    }
+    if (left >= TABLE_SIZE || right >= TABLE_SIZE) {
+        std::lock_guard<std::mutex> lock(fontMutex);
+        return (float)TTF_GetFontKerningSizeGlyphs32(font, left, right);
+    }
+    
+    // Racing fills write the same value, so relaxed ordering is enough
+    std::atomic<int16_t>& entry = kerning[left * TABLE_SIZE + right];
+    int16_t cached = entry.load(std::memory_order_relaxed);
+    if (cached == KERNING_UNKNOWN) {
+        std::lock_guard<std::mutex> lock(fontMutex);
+        cached = (int16_t)TTF_GetFontKerningSizeGlyphs(font, (Uint16)left, (Uint16)right);
+        entry.store(cached, std::memory_order_relaxed);
+    }
+    return (float)cached;
+}
+
+size_t TextLayout::CacheKeyHash::operator()(const CacheKey& key) const {
+    uint32_t widthBits;
+    memcpy(&widthBits, &key.maxWidth, sizeof(widthBits));
+    size_t value = std::hash<std::string_view>()(key.text);
+    value ^= (size_t)widthBits * 0x9E3779B97F4A7C15ull;
+    value ^= (size_t)key.style.align * 0xC2B2AE3D27D4EB4Full;
+    return value;
+}
+
+TextLayout::TextLayout(TTF_Font* font, size_t cacheCapacity)
+    : metrics(font), cacheCapacity(cacheCapacity), cacheHits(0), cacheMisses(0) {
+}
+
+TextLayout::TextLayout(const BakedFont& baked, const BakedFaceRecord& face, size_t cacheCapacity)
+    : metrics(baked, face), cacheCapacity(cacheCapacity), cacheHits(0), cacheMisses(0) {
+}
+
+std::shared_ptr<const TextLayoutResult> TextLayout::layout(const std::string& text, float maxWidth, const TextStyle& style) {
+    // The key views text, so a hit allocates nothing
+    CacheKey key{text, maxWidth, style};
+    std::shared_ptr<const TextLayoutResult> cached = findCached(key);
+    if (cached) {
+        return cached;
+    }
+    
+    std::shared_ptr<const TextLayoutResult> result = computeLayout(text, maxWidth, style);
+    insertCached(key, result);
+    return result;
+}
+
+std::vector<std::shared_ptr<const TextLayoutResult>> TextLayout::layoutBatch(const std::vector<std::string>& texts, float maxWidth,
+                                                                             const TextStyle& style, JobSystem& jobs) {
+    std::vector<std::shared_ptr<const TextLayoutResult>> results(texts.size());
+    
+    // Serve hits from the cache, collect misses
+    std::vector<size_t> misses;
+    for (size_t i = 0; i < texts.size(); i++) {
+        results[i] = findCached(CacheKey{texts[i], maxWidth, style});
+        if (!results[i]) {
+            misses.push_back(i);
+        }
+    }
+    
+    // Line breaking only reads font metrics, so misses are independent
+    jobs.parallelFor(misses.size(), 16, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            results[misses[i]] = computeLayout(texts[misses[i]], maxWidth, style);
+        }
+    });
+    
+    for (size_t index : misses) {
+        insertCached(CacheKey{texts[index], maxWidth, style}, results[index]);
+    }
+    return results;
+}
+
+std::shared_ptr<TextLayoutResult> TextLayout::computeLayout(const std::string& text, float maxWidth, const TextStyle& style) {
+    auto result = std::make_shared<TextLayoutResult>();
+    
+    // Paragraphs are separated by explicit newlines
+    size_t start = 0;
+    while (true) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        layoutParagraph(std::string_view(text).substr(0, end), start, maxWidth, *result);
+        if (end >= text.size()) {
+            break;
+        }
+        start = end + 1;
+    }
+    
+    // Position lines vertically and align them within the box
+    float lineAdvance = metrics.getLineHeight() * style.lineSpacing;
+    float boxWidth = maxWidth > 0.0f ? maxWidth : result->width;
+    for (size_t i = 0; i < result->lines.size(); i++) {
+        TextLine& line = result->lines[i];
+        line.y = i * lineAdvance;
+        switch (style.align) {
+            case TextAlign::Left:
+                line.x = 0.0f;
+                break;
+            case TextAlign::Center:
+                line.x = (boxWidth - line.width) * 0.5f;
+                break;
+            case TextAlign::Right:
+                line.x = boxWidth - line.width;
+                break;
+        }
+    }
+    result->height = result->lines.size() * lineAdvance;
+    return result;
+}
+
+std::shared_ptr<const TextLayoutResult> TextLayout::findCached(const CacheKey& key) {
+    auto it = cache.find(key);
+    if (it == cache.end()) {
+        cacheMisses++;
+        return nullptr;
+    }
+    
+    cacheHits++;
+    lru.splice(lru.begin(), lru, it->second.lruPosition);
+    return it->second.result;
+}
+
+void TextLayout::insertCached(const CacheKey& key, std::shared_ptr<const TextLayoutResult> result) {
+    if (cache.find(key) != cache.end()) {
+        return; // Duplicate text within one batch
+    }
+    
+    // Evict the least recently used layout when full
+    if (cache.size() >= cacheCapacity && !lru.empty()) {
+        const CachedText& oldest = lru.back();
+        cache.erase(CacheKey{oldest.text, oldest.maxWidth, oldest.style});
+        lru.pop_back();
+    }
+    
+    // Copy the text into the list node first so the stored key can view it
+    lru.push_front(CachedText{std::string(key.text), key.maxWidth, key.style});
+    const CachedText& stored = lru.front();
+    cache.emplace(CacheKey{stored.text, stored.maxWidth, stored.style}, CacheEntry{std::move(result), lru.begin()});
+}
+
+TextSize TextLayout::measureText(std::string_view text) {
+    float width = 0.0f;
+    float lineWidth = 0.0f;
+    int lines = 1;
+    uint32_t previous = 0;
+    
+    for (size_t i = 0; i < text.size();) {
+        if (text[i] == TEXT_ESCAPE) {
+            i += getEscapeLength(text, i); // Markup has no width
+            continue;
+        }
+        uint32_t c = nextCodepoint(text, i);
+        if (c == '\n') {
+            width = std::max(width, lineWidth);
+            lineWidth = 0.0f;
+            previous = 0;
+            lines++;
+            continue;
+        }
+        if (previous) {
+            lineWidth += metrics.getKerning(previous, c);
+        }
+        lineWidth += metrics.getAdvance(c);
+        previous = c;
+    }
+    width = std::max(width, lineWidth);
+    
+    return TextSize{width, lines * metrics.getLineHeight()};
+}
+
+void TextLayout::clearCache() {
+    cache.clear();
+    lru.clear();
+}
+
+void TextLayout::layoutParagraph(std::string_view text, size_t offset, float maxWidth, TextLayoutResult& result) {
+    const size_t end = text.size();
+    size_t lineStart = offset;
+    
+    // Greedy word wrap: break at the last space that fits, or mid-word if a word is wider than the box
+    do {
+        float width = 0.0f;
+        uint32_t previous = 0;
+        size_t breakPosition = std::string_view::npos;
+        float breakWidth = 0.0f;
+        size_t i = lineStart;
+        bool overflow = false;
+        
+        while (i < end) {
+            if (text[i] == TEXT_ESCAPE) {
+                i += getEscapeLength(text, i);
+                continue;
+            }
+            if (text[i] == ' ' && i > lineStart && text[i - 1] != ' ') {
+                breakPosition = i;
+                breakWidth = width;
+            }
+            
+            // Lines only ever break on codepoint boundaries
+            size_t next = i;
+            uint32_t c = nextCodepoint(text, next);
+            float advance = metrics.getAdvance(c);
+            if (previous) {
+                advance += metrics.getKerning(previous, c);
+            }
+            if (maxWidth > 0.0f && c != ' ' && i > lineStart && width + advance > maxWidth) {
+                overflow = true;
+                break;
+            }
+            width += advance;
+            previous = c;
+            i = next;
+        }
+        
+        if (!overflow) {
+            result.lines.push_back(TextLine{lineStart, end - lineStart, 0.0f, 0.0f, width});
+            result.width = std::max(result.width, width);
+            return;
+        }
+        
+        size_t next;
+        if (breakPosition != std::string_view::npos) {
+            result.lines.push_back(TextLine{lineStart, breakPosition - lineStart, 0.0f, 0.0f, breakWidth});
+            result.width = std::max(result.width, breakWidth);
+            next = breakPosition;
+        } else {
+            result.lines.push_back(TextLine{lineStart, i - lineStart, 0.0f, 0.0f, width});
+            result.width = std::max(result.width, width);
+            next = i;
+        }
+        
+        // Spaces at a wrap point are consumed by the break
+        while (next < end && text[next] == ' ') {
+            next++;
+        }
+        lineStart = next;
+    } while (lineStart < end);
+}
\ No newline at end of file
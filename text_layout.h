@@ -0,0 +1,154 @@
+#pragma once
+
+#include <SDL2/SDL_ttf.h>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+enum class TextAlign {
+    Left,
+    Center,
+    Right
+};
+
+struct TextStyle {
+    TextAlign align = TextAlign::Left;
+    float lineSpacing = 1.0f; // Multiplier on the font's line skip
+    
+    bool operator==(const TextStyle& other) const {
+        return align == other.align && lineSpacing == other.lineSpacing;
+    }
+};
+
+// One laid out line; start/length index into the source text
+struct TextLine {
+    size_t start;
+    size_t length;
+    float x;
+    float y;
+    float width;
+};
+
+struct TextLayoutResult {
+    std::vector<TextLine> lines;
+    float width = 0.0f;
+    float height = 0.0f;
+};
+
+struct TextSize {
+    float width;
+    float height;
+};
+
+class BakedFont;
+struct BakedFaceRecord;
+class JobSystem;
+
+// Per-glyph advances and kerning pairs pulled from the font once and cached.
+// Safe to query from several threads; font lookups on a cache miss are serialized.
+class FontMetrics {
+public:
+    FontMetrics(TTF_Font* font);
+    
+    // Metrics from a baked atlas face; everything is known up front, no font needed
+    FontMetrics(const BakedFont& baked, const BakedFaceRecord& face);
+    
+    float getAdvance(uint32_t codepoint);
+    float getKerning(uint32_t left, uint32_t right);
+    float getLineHeight() const { return lineHeight; }
+
+private:
+    static constexpr int TABLE_SIZE = 256;
+    static constexpr int16_t KERNING_UNKNOWN = INT16_MIN;
+    
+    TTF_Font* font;
+    bool kerningEnabled;
+    float lineHeight;
+    float advances[TABLE_SIZE];
+    std::vector<std::atomic<int16_t>> kerning; // TABLE_SIZE x TABLE_SIZE, filled on demand
+    std::unordered_map<uint32_t, float> extendedAdvances;
+    
+    // Baked pairs outside the table, sorted by key (left << 32 | right) for binary search
+    struct KerningPair {
+        uint64_t key;
+        float amount;
+    };
+    std::vector<KerningPair> extendedKerning;
+    std::mutex fontMutex; // Guards the font and extendedAdvances
+};
+
+// Measures, wraps and aligns text without rasterizing it
+class TextLayout {
+public:
+    TextLayout(TTF_Font* font, size_t cacheCapacity = 1024);
+    TextLayout(const BakedFont& baked, const BakedFaceRecord& face, size_t cacheCapacity = 1024);
+    
+    // Lay out a paragraph within maxWidth (<= 0 disables wrapping); results are memoized
+    std::shared_ptr<const TextLayoutResult> layout(const std::string& text, float maxWidth, const TextStyle& style = TextStyle());
+    
+    // Lay out many paragraphs at once (e.g. every panel on resize); cache misses run in parallel
+    std::vector<std::shared_ptr<const TextLayoutResult>> layoutBatch(const std::vector<std::string>& texts, float maxWidth,
+                                                                    const TextStyle& style, JobSystem& jobs);
+    
+    // Size of the text without wrapping, honoring explicit newlines
+    TextSize measureText(std::string_view text);
+    
+    float getLineHeight() const { return metrics.getLineHeight(); }
+    FontMetrics& getMetrics() { return metrics; }
+    
+    // Cache management
+    void clearCache();
+    size_t getCacheHits() const { return cacheHits; }
+    size_t getCacheMisses() const { return cacheMisses; }
+
+private:
+    // Lookup key; the text views the caller's string or, for stored entries,
+    // the copy owned by the entry's LRU node
+    struct CacheKey {
+        std::string_view text;
+        float maxWidth;
+        TextStyle style;
+        
+        bool operator==(const CacheKey& other) const {
+            return maxWidth == other.maxWidth && style == other.style && text == other.text;
+        }
+    };
+    
+    struct CacheKeyHash {
+        size_t operator()(const CacheKey& key) const;
+    };
+    
+    // List nodes own the key text; their addresses are stable across splicing
+    struct CachedText {
+        std::string text;
+        float maxWidth;
+        TextStyle style;
+    };
+    typedef std::list<CachedText> LruList;
+    
+    struct CacheEntry {
+        std::shared_ptr<const TextLayoutResult> result;
+        LruList::iterator lruPosition;
+    };
+    
+    FontMetrics metrics;
+    size_t cacheCapacity;
+    size_t cacheHits;
+    size_t cacheMisses;
+    LruList lru;
+    std::unordered_map<CacheKey, CacheEntry, CacheKeyHash> cache;
+    
+    // Cache-independent layout work; safe to run on several threads at once
+    std::shared_ptr<TextLayoutResult> computeLayout(const std::string& text, float maxWidth, const TextStyle& style);
+    void layoutParagraph(std::string_view text, size_t offset, float maxWidth, TextLayoutResult& result);
+    
+    // Look up / store memoized results
+    std::shared_ptr<const TextLayoutResult> findCached(const CacheKey& key);
+    void insertCached(const CacheKey& key, std::shared_ptr<const TextLayoutResult> result);
+};
\ No newline at end of file
@@ -0,0 +1,111 @@
+#include "text_markup.h"
+
+// Standard xterm palette for codes 30-37 and 90-97
+static const unsigned char ANSI_PALETTE[16][3] = {
+    {0, 0, 0},       {205, 0, 0},     {0, 205, 0},     {205, 205, 0},
+    {0, 0, 238},     {205, 0, 205},   {0, 205, 205},   {229, 229, 229},
+    {127, 127, 127}, {255, 0, 0},     {0, 255, 0},     {255, 255, 0},
+    {92, 92, 255},   {255, 0, 255},   {0, 255, 255},   {255, 255, 255}
+};
+
+static void setRgb(TextColor& color, int r, int g, int b) {
+    color.r = r / 255.0f;
+    color.g = g / 255.0f;
+    color.b = b / 255.0f;
+}
+
+static void setPaletteColor(TextColor& color, int index) {
+    if (index < 16) {
+        setRgb(color, ANSI_PALETTE[index][0], ANSI_PALETTE[index][1], ANSI_PALETTE[index][2]);
+    } else if (index < 232) {
+        // 6x6x6 color cube
+        static const int levels[6] = {0, 95, 135, 175, 215, 255};
+        int cube = index - 16;
+        setRgb(color, levels[cube / 36], levels[(cube / 6) % 6], levels[cube % 6]);
+    } else {
+        // Grayscale ramp
+        int gray = 8 + (index - 232) * 10;
+        setRgb(color, gray, gray, gray);
+    }
+}
+
+TextColor getPaletteColor(int index) {
+    TextColor color = {0.0f, 0.0f, 0.0f, 1.0f};
+    setPaletteColor(color, index & 0xFF);
+    return color;
+}
+
+size_t getEscapeLength(std::string_view text, size_t pos) {
+    if (pos >= text.size() || text[pos] != TEXT_ESCAPE) {
+        return 0;
+    }
+    if (pos + 1 >= text.size() || text[pos + 1] != '[') {
+        return 1; // Lone escape byte, drop it
+    }
+    
+    size_t i = pos + 2;
+    while (i < text.size() && ((text[i] >= '0' && text[i] <= '9') || text[i] == ';')) {
+        i++;
+    }
+    if (i < text.size() && text[i] >= 0x40 && text[i] <= 0x7E) {
+        i++; // Final byte
+    }
+    return i - pos;
+}
+
+size_t applyEscape(std::string_view text, size_t pos, TextColor& color, const TextColor& defaultColor) {
+    size_t length = getEscapeLength(text, pos);
+    if (length < 3 || text[pos + length - 1] != 'm') {
+        return length; // Not a color command
+    }
+    
+    // Parse the numeric parameters; an empty list means reset
+    int params[16];
+    int count = 0;
+    int value = 0;
+    bool hasValue = false;
+    for (size_t i = pos + 2; i < pos + length - 1; i++) {
+        if (text[i] == ';') {
+            if (count < 16) {
+                params[count++] = value;
+            }
+            value = 0;
+            hasValue = false;
+        } else {
+            value = value * 10 + (text[i] - '0');
+            hasValue = true;
+        }
+    }
+    if ((hasValue || count > 0) && count < 16) {
+        params[count++] = value;
+    }
+    if (count == 0) {
+        params[count++] = 0;
+    }
+    
+    for (int i = 0; i < count; i++) {
+        int code = params[i];
+        if (code == 0) {
+            color = defaultColor;
+        } else if (code == 2) {
+            color.a = defaultColor.a * 0.5f;
+        } else if (code == 22) {
+            color.a = defaultColor.a;
+        } else if (code >= 30 && code <= 37) {
+            setPaletteColor(color, code - 30);
+        } else if (code >= 90 && code <= 97) {
+            setPaletteColor(color, code - 90 + 8);
+        } else if (code == 39) {
+            color.r = defaultColor.r;
+            color.g = defaultColor.g;
+            color.b = defaultColor.b;
+        } else if (code == 38 && i + 2 < count && params[i + 1] == 5) {
+            setPaletteColor(color, params[i + 2] & 0xFF);
+            i += 2;
+        } else if (code == 38 && i + 4 < count && params[i + 1] == 2) {
+            setRgb(color, params[i + 2] & 0xFF, params[i + 3] & 0xFF, params[i + 4] & 0xFF);
+            i += 4;
+        }
+    }
+    return length;
+}
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+struct TextColor {
+    float r, g, b, a;
+};
+
+// Inline color markup uses ANSI SGR escape sequences, the same codes our log
+// sources already emit:
+//   ESC[0m  reset          ESC[30-37m / ESC[90-97m  palette colors
+//   ESC[2m  dim (half alpha) ESC[22m  normal          ESC[39m  default color
+//   ESC[38;5;Nm  256-color palette   ESC[38;2;R;G;Bm  true color
+const char TEXT_ESCAPE = '\x1b';
+
+// Opaque color of an xterm 256-color palette index
+TextColor getPaletteColor(int index);
+
+// Length of the escape sequence starting at pos, or 0 if there isn't one
+size_t getEscapeLength(std::string_view text, size_t pos);
+
+// Apply the escape sequence starting at pos to color; returns its length (0 if none)
+size_t applyEscape(std::string_view text, size_t pos, TextColor& color, const TextColor& defaultColor);
\ No newline at end of file
@@ -1,11 +1,18 @@
 #include "text_renderer.h"
+#include "assets/asset_loader.h"
+#include "text_markup.h"
+#include "utf8.h"
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
 
-TextRenderer::TextRenderer(GraphicsAPI* graphics) 
-    : graphics(graphics), font(nullptr), VBO(0), textTexture(0), screenWidth(0), screenHeight(0) {
+TextRenderer::TextRenderer(GraphicsAPI* graphics, GpuResources* resources, QuadIndexBuffer* quadIndices, JobSystem* jobs) 
+    : graphics(graphics), resources(resources), quadIndices(quadIndices), jobs(jobs), fontResident(false),
+      screenWidth(0), screenHeight(0), projection(Mat4::identity()), drawCalls(0) {
     textColor[0] = 1.0f; // Default to white
     textColor[1] = 1.0f;
     textColor[2] = 1.0f;
+    textColor[3] = 1.0f;
 }
 
 TextRenderer::~TextRenderer() {
@@ -13,153 +20,440 @@ TextRenderer::~TextRenderer() {
 }
 
 bool TextRenderer::initialize(const std::string& fontPath, int fontSize, int windowWidth, int windowHeight) {
+    // Same path as asynchronous loading, finished before returning
+    AssetLoader loader(graphics, resources, jobs);
+    return initialize(loader, fontPath, fontSize, windowWidth, windowHeight) && finishLoading(loader);
+}
+
+bool TextRenderer::initialize(const AssetPack& pack, const std::string& fontName, int fontSize, int windowWidth, int windowHeight) {
+    // Font and shader sources are read in place from the mapped pack
+    AssetLoader loader(graphics, resources, jobs, &pack);
+    return initialize(loader, fontName, fontSize, windowWidth, windowHeight) && finishLoading(loader);
+}
+
+bool TextRenderer::initialize(AssetLoader& loader, const std::string& fontName, int fontSize, int windowWidth, int windowHeight) {
     screenWidth = windowWidth;
     screenHeight = windowHeight;
     
-    // Load font
-    font = TTF_OpenFont(fontPath.c_str(), fontSize);
-    if (!font) {
-        printf("Failed to load font: %s\n", TTF_GetError());
-        return false;
-    }
-    printf("Font loaded successfully\n");
-    
-    // Create shader using graphics abstraction
-    textShader = std::make_unique<Shader>(graphics);
+    // Both requests return immediately; text is drawn as placeholders until the font is resident
+    fontAsset = loader.load<FontAsset>(fontName, fontSize);
+    shaderAsset = loader.load<ShaderAsset>(graphics->getVertexShaderPath("text"), graphics->getFragmentShaderPath("text"));
     
-    // Load appropriate shaders based on graphics API
-    std::string vertexPath = graphics->getVertexShaderPath("text");
-    std::string fragmentPath = graphics->getFragmentShaderPath("text");
-    
-    if (!textShader->loadFromFiles(vertexPath, fragmentPath)) {
+    return createResources();
+}
+
+bool TextRenderer::finishLoading(AssetLoader& loader) {
+    loader.finishAll();
+    if (!shaderAsset->isReady()) {
         printf("Failed to load text shaders\n");
         return false;
     }
+    if (!fontAsset->isReady()) {
+        printf("Failed to load font: %s\n", fontAsset->getName().c_str());
+        return false;
+    }
+    
+    updateFontResidency();
+    return true;
+}
+
+bool TextRenderer::isFontReady() const {
+    return fontResident;
+}
+
+bool TextRenderer::isReady() const {
+    return shaderAsset && shaderAsset->isReady();
+}
+
+bool TextRenderer::createResources() {
+    // Pixel-space vertices are mapped to clip space on the GPU
+    projection = Mat4::ortho(0.0f, (float)screenWidth, (float)screenHeight, 0.0f);
     
     // Create OpenGL resources using graphics API
-    VBO = graphics->createBuffer();
-    textTexture = graphics->createTexture();
+    VBO = resources->createBuffer();
+    
+    // Single white texel for placeholder blocks while the font loads
+    const uint8_t white[4] = {255, 255, 255, 255};
+    placeholderTexture = resources->createTexture();
+    graphics->bindTexture(GL_TEXTURE_2D, resources->get(placeholderTexture));
+    graphics->texImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, white);
+    resources->setSize(placeholderTexture, GpuResources::getTextureBytes(1, 1));
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     
-    // Enable blending for text rendering
+    // Enable blending for text rendering; alpha accumulates separately so text
+    // drawn into a transparent render target comes out premultiplied
     graphics->enable(GL_BLEND);
-    graphics->blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    graphics->blendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
     
     printf("Text renderer initialized successfully\n");
     return true;
 }
 
-void TextRenderer::renderText(const std::string& text, float x, float y) {
-    if (!font) {
-        printf("Font not loaded\n");
-        return;
+void TextRenderer::updateFontResidency() {
+    // Swap only between batches so one draw never mixes placeholder and atlas quads
+    if (!fontResident && batch.empty() && fontAsset && fontAsset->isReady()) {
+        fontResident = true;
+        printf("Font resident, placeholder text replaced\n");
+    }
+}
+
+void TextRenderer::buildTextMesh(TextMesh& mesh) {
+    // Build the quads through the normal path, then move them to their own buffer.
+    // The mesh outlives this batch, so its glyphs must stay in the atlas.
+    flush();
+    float savedColor[4];
+    for (int i = 0; i < 4; i++) {
+        savedColor[i] = textColor[i];
+        textColor[i] = mesh.color[i];
+    }
+    if (fontResident) {
+        fontAsset->getAtlas()->setPinRecord(&mesh.pinnedGlyphs);
+    }
+    renderText(mesh.text, mesh.x, mesh.y);
+    if (fontResident) {
+        fontAsset->getAtlas()->setPinRecord(nullptr);
+    }
+    for (int i = 0; i < 4; i++) {
+        textColor[i] = savedColor[i];
     }
     
-    SDL_Color color = {255, 255, 255, 255}; // White text in SDL surface
-    SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), color);
-    if (!surface) {
-        printf("Failed to render text: %s\n", TTF_GetError());
+    mesh.buffer = resources->createBuffer();
+    mesh.placeholder = !fontResident;
+    mesh.quadCount = (int)batch.size() / QuadIndexBuffer::VERTICES_PER_QUAD;
+    graphics->bindBuffer(GL_ARRAY_BUFFER, resources->get(mesh.buffer));
+    graphics->bufferData(GL_ARRAY_BUFFER, batch.size() * sizeof(TextVertex), batch.data(), GL_STATIC_DRAW);
+    resources->setSize(mesh.buffer, batch.size() * sizeof(TextVertex));
+    batch.clear();
+}
+
+void TextRenderer::releaseTextMesh(TextMesh& mesh) {
+    if (resources) {
+        resources->destroy(mesh.buffer);
+    }
+    if (fontAsset && fontAsset->getAtlas()) {
+        for (uint32_t codepoint : mesh.pinnedGlyphs) {
+            fontAsset->getAtlas()->unpin(codepoint);
+        }
+    }
+    mesh.pinnedGlyphs.clear();
+}
+
+void TextRenderer::renderText(std::string_view text, float x, float y) {
+    if (!fontAsset) {
+        printf("Font not loaded\n");
         return;
     }
     
-    // Convert surface to proper format
-    SDL_Surface* rgba_surface = convertSurface(surface);
-    if (!rgba_surface) {
-        SDL_FreeSurface(surface);
+    TextColor color = {textColor[0], textColor[1], textColor[2], textColor[3]};
+    appendText(text, x, y, color);
+}
+
+void TextRenderer::renderLabels(const Label* labels, size_t count, const LabelText& text, float offsetX, float offsetY) {
+    if (!fontAsset) {
+        printf("Font not loaded\n");
         return;
     }
     
-    // Upload texture using graphics API
-    graphics->bindTexture(GL_TEXTURE_2D, textTexture);
-    graphics->texImage2D(GL_TEXTURE_2D, 0, GL_RGBA, rgba_surface->w, rgba_surface->h, GL_RGBA, GL_UNSIGNED_BYTE, rgba_surface->pixels);
-    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    graphics->texParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    
-    // Calculate normalized coordinates
-    float w = (float)surface->w / screenWidth * 2.0f;
-    float h = (float)surface->h / screenHeight * 2.0f;
-    float x_norm = x / screenWidth * 2.0f - 1.0f;
-    float y_norm = 1.0f - y / screenHeight * 2.0f;
-    
-    // Create quad vertices
-    float vertices[] = {
-        x_norm,     y_norm - h, 0.0f, 1.0f,
-        x_norm + w, y_norm - h, 1.0f, 1.0f,
-        x_norm + w, y_norm,     1.0f, 0.0f,
+    for (size_t i = 0; i < count; i++) {
+        TextColor color = labels[i].color;
+        appendText(text.get(labels[i]), labels[i].x + offsetX, labels[i].y + offsetY, color);
+    }
+}
+
+void TextRenderer::flush() {
+    if (!batch.empty()) {
+        // Upload every queued glyph at once
+        GLuint buffer = resources->get(VBO);
+        graphics->bindBuffer(GL_ARRAY_BUFFER, buffer);
+        graphics->bufferData(GL_ARRAY_BUFFER, batch.size() * sizeof(TextVertex), batch.data(), GL_DYNAMIC_DRAW);
+        resources->setSize(VBO, batch.size() * sizeof(TextVertex));
         
-        x_norm,     y_norm - h, 0.0f, 1.0f,
-        x_norm + w, y_norm,     1.0f, 0.0f,
-        x_norm,     y_norm,     0.0f, 0.0f
-    };
-    
-    // Use shader and setup rendering
-    textShader->use();
-    
-    // Setup vertex array using graphics API abstraction
-    graphics->setupVertexArray(textShader->program, VBO);
-    
-    // Update vertex buffer
-    graphics->bindBuffer(GL_ARRAY_BUFFER, VBO);
-    graphics->bufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_DYNAMIC_DRAW);
-    
-    // Setup vertex attributes using graphics API abstraction
-    graphics->enableVertexAttribute(textShader->program, "aPosition", 2, GL_FLOAT, 4 * sizeof(float), 0);
-    graphics->enableVertexAttribute(textShader->program, "aTexCoord", 2, GL_FLOAT, 4 * sizeof(float), 2 * sizeof(float));
-    
-    // Set uniforms
-    textShader->setVec3("uColor", textColor[0], textColor[1], textColor[2]);
-    textShader->setInt("uTexture", 0);
-    
-    // Bind texture and draw
-    graphics->activeTexture(GL_TEXTURE0);
-    graphics->bindTexture(GL_TEXTURE_2D, textTexture);
+        drawBuffer(buffer, (int)batch.size() / QuadIndexBuffer::VERTICES_PER_QUAD, currentTransform, getBatchTexture());
+        batch.clear();
+        
+        // Glyphs of the drawn batch may now be evicted from the atlas
+        if (fontResident) {
+            fontAsset->getAtlas()->endBatch();
+        }
+    }
+    updateFontResidency();
+}
+
+void TextRenderer::setViewportSize(int width, int height) {
+    screenWidth = width;
+    screenHeight = height;
+    projection = Mat4::ortho(0.0f, (float)width, (float)height, 0.0f);
+}
+
+void TextRenderer::setTransform(const Transform2D& transform) {
+    if (transform != currentTransform) {
+        flush();
+        currentTransform = transform;
+    }
+}
+
+void TextRenderer::resetTransform() {
+    setTransform(Transform2D());
+}
+
+TextMesh TextRenderer::createTextMesh(const std::string& text, float x, float y) {
+    TextMesh mesh;
+    if (!fontAsset) {
+        printf("Font not loaded\n");
+        return mesh;
+    }
+    mesh.text = text;
+    mesh.x = x;
+    mesh.y = y;
+    for (int i = 0; i < 4; i++) {
+        mesh.color[i] = textColor[i];
+    }
+    buildTextMesh(mesh);
+    return mesh;
+}
+
+void TextRenderer::drawTextMesh(TextMesh& mesh, const Transform2D& transform) {
+    // Keep draw order: anything queued before the mesh goes first
+    flush();
+    if (mesh.placeholder && !mesh.buffer.isNull()) {
+        updateFontResidency();
+        if (fontResident) {
+            releaseTextMesh(mesh);
+            buildTextMesh(mesh);
+        }
+    }
     
-    graphics->drawArrays(GL_TRIANGLES, 0, 6);
+    // A stale handle (mesh destroyed elsewhere) resolves to 0 and draws nothing
+    GLuint buffer = resources->get(mesh.buffer);
+    if (!buffer || mesh.quadCount == 0) {
+        return;
+    }
+    GLuint texture = mesh.placeholder ? resources->get(placeholderTexture) : fontAsset->getAtlas()->getTexture();
+    drawBuffer(buffer, mesh.quadCount, transform, texture);
+}
+
+void TextRenderer::destroyTextMesh(TextMesh& mesh) {
+    releaseTextMesh(mesh);
+    mesh = TextMesh();
+}
+
+void TextRenderer::renderTextBlock(const std::string& text, float x, float y, float maxWidth, const TextStyle& style) {
+    if (!fontAsset) {
+        printf("Font not loaded\n");
+        return;
+    }
     
-    // Cleanup
-    graphics->disableVertexAttribute(textShader->program, "aPosition");
-    graphics->disableVertexAttribute(textShader->program, "aTexCoord");
+    TextColor color = {textColor[0], textColor[1], textColor[2], textColor[3]};
+    if (!fontResident) {
+        appendPlaceholderBlock(text, x, y, maxWidth, style, color);
+        return;
+    }
     
-    // Free surfaces
-    if (rgba_surface != surface) {
-        SDL_FreeSurface(rgba_surface);
+    std::shared_ptr<const TextLayoutResult> layout = fontAsset->getLayout()->layout(text, maxWidth, style);
+    for (const TextLine& line : layout->lines) {
+        if (line.length == 0) {
+            continue;
+        }
+        // Color markup carries over from one wrapped line to the next
+        appendText(std::string_view(text).substr(line.start, line.length), x + line.x, y + line.y, color);
+    }
+}
+
+TextSize TextRenderer::measureText(std::string_view text) {
+    if (!fontAsset) {
+        return TextSize{0.0f, 0.0f};
+    }
+    if (!fontResident) {
+        // Monospace estimate so layouts can be sized before the font arrives
+        size_t visible = 0;
+        size_t i = 0;
+        while (i < text.size()) {
+            size_t escape = getEscapeLength(text, i);
+            if (escape) {
+                i += escape;
+            } else {
+                nextCodepoint(text, i);
+                visible++;
+            }
+        }
+        return TextSize{visible * getPlaceholderAdvance(), getPlaceholderLineHeight()};
+    }
+    return fontAsset->getLayout()->measureText(text);
+}
+
+float TextRenderer::getLineHeight() const {
+    if (!fontAsset) {
+        return 0.0f;
     }
-    SDL_FreeSurface(surface);
+    return fontResident ? fontAsset->getLayout()->getMetrics().getLineHeight() : getPlaceholderLineHeight();
 }
 
-void TextRenderer::setColor(float r, float g, float b) {
+void TextRenderer::setColor(float r, float g, float b, float a) {
     textColor[0] = r;
     textColor[1] = g;
     textColor[2] = b;
+    textColor[3] = a;
 }
 
 void TextRenderer::cleanup() {
-    if (VBO && graphics) {
-        graphics->deleteBuffer(VBO);
-        VBO = 0;
+    if (resources) {
+        resources->destroy(VBO);
+        resources->destroy(placeholderTexture);
     }
-    if (textTexture && graphics) {
-        graphics->deleteTexture(textTexture);
-        textTexture = 0;
+    batch.clear();
+    
+    fontResident = false;
+    fontAsset.reset();
+    shaderAsset.reset();
+}
+
+void TextRenderer::appendText(std::string_view text, float x, float y, TextColor& color) {
+    const TextColor defaultColor = {textColor[0], textColor[1], textColor[2], textColor[3]};
+    if (!fontResident) {
+        appendPlaceholder(text, x, y, color, defaultColor);
+        return;
     }
     
-    textShader.reset();
+    FontMetrics& metrics = fontAsset->getLayout()->getMetrics();
+    GlyphAtlas* atlas = fontAsset->getAtlas();
+    float penX = x;
+    uint32_t previous = 0;
+    
+    size_t i = 0;
+    while (i < text.size()) {
+        if (text[i] == TEXT_ESCAPE) {
+            i += applyEscape(text, i, color, defaultColor);
+            continue;
+        }
+        uint32_t c = nextCodepoint(text, i);
+        
+        if (previous) {
+            penX += metrics.getKerning(previous, c);
+        }
+        
+        const GlyphInfo* glyph = atlas->getGlyph(c);
+        if (glyph && c != ' ') {
+            appendQuad(penX + glyph->xOffset, y + glyph->yOffset, (float)glyph->width, (float)glyph->height, *glyph, color);
+        }
+        
+        penX += metrics.getAdvance(c);
+        previous = c;
+    }
+}
+
+void TextRenderer::appendPlaceholder(std::string_view text, float x, float y, TextColor& color, const TextColor& defaultColor) {
+    // Faint block per visible character, sampling the white texel
+    static const GlyphInfo block = {0.0f, 0.0f, 1.0f, 1.0f, 1, 1, 0, 0, true};
+    float advance = getPlaceholderAdvance();
+    float height = fontAsset->getPointSize() * 0.6f;
+    float top = y + fontAsset->getPointSize() * 0.3f;
+    float penX = x;
     
-    if (font) {
-        TTF_CloseFont(font);
-        font = nullptr;
+    size_t i = 0;
+    while (i < text.size()) {
+        if (text[i] == TEXT_ESCAPE) {
+            i += applyEscape(text, i, color, defaultColor);
+            continue;
+        }
+        if (nextCodepoint(text, i) != ' ') {
+            TextColor faint = {color.r, color.g, color.b, color.a * 0.3f};
+            appendQuad(penX + 1.0f, top, advance - 2.0f, height, block, faint);
+        }
+        penX += advance;
     }
 }
 
-SDL_Surface* TextRenderer::convertSurface(SDL_Surface* surface) {
-    if (surface->format->format != SDL_PIXELFORMAT_RGBA32) {
-        SDL_Surface* rgba_surface = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
-        if (!rgba_surface) {
-            printf("Failed to convert surface format: %s\n", SDL_GetError());
-            return nullptr;
+void TextRenderer::appendPlaceholderBlock(const std::string& text, float x, float y, float maxWidth, const TextStyle& style,
+                                          TextColor& color) {
+    // Fixed-width wrapping is close enough for a few frames of placeholders
+    const TextColor defaultColor = {textColor[0], textColor[1], textColor[2], textColor[3]};
+    size_t lineChars = maxWidth > 0.0f ? std::max<size_t>(1, (size_t)(maxWidth / getPlaceholderAdvance())) : text.size() + 1;
+    float lineAdvance = getPlaceholderLineHeight() * style.lineSpacing;
+    
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = std::min(text.find('\n', start), text.size());
+        for (size_t lineStart = start; lineStart < end; lineStart += lineChars) {
+            size_t length = std::min(lineChars, end - lineStart);
+            float width = length * getPlaceholderAdvance();
+            float lineX = x;
+            if (style.align == TextAlign::Center) {
+                lineX += (maxWidth - width) * 0.5f;
+            } else if (style.align == TextAlign::Right) {
+                lineX += maxWidth - width;
+            }
+            appendPlaceholder(std::string_view(text).substr(lineStart, length), lineX, y, color, defaultColor);
+            y += lineAdvance;
         }
-        return rgba_surface;
+        start = end + 1;
+    }
+}
+
+float TextRenderer::getPlaceholderAdvance() const {
+    return fontAsset->getPointSize() * 0.6f;
+}
+
+float TextRenderer::getPlaceholderLineHeight() const {
+    return fontAsset->getPointSize() * 1.2f;
+}
+
+GLuint TextRenderer::getBatchTexture() const {
+    return fontResident ? fontAsset->getAtlas()->getTexture() : resources->get(placeholderTexture);
+}
+
+void TextRenderer::appendQuad(float x, float y, float width, float height, const GlyphInfo& glyph, const TextColor& color) {
+    // Vertices stay in pixel space; the vertex shader applies transform and projection
+    TextVertex topLeft     = {x,         y,          glyph.u0, glyph.v0, color.r, color.g, color.b, color.a};
+    TextVertex topRight    = {x + width, y,          glyph.u1, glyph.v0, color.r, color.g, color.b, color.a};
+    TextVertex bottomRight = {x + width, y + height, glyph.u1, glyph.v1, color.r, color.g, color.b, color.a};
+    TextVertex bottomLeft  = {x,         y + height, glyph.u0, glyph.v1, color.r, color.g, color.b, color.a};
+    
+    // Corner order expected by QuadIndexBuffer
+    batch.push_back(topLeft);
+    batch.push_back(topRight);
+    batch.push_back(bottomRight);
+    batch.push_back(bottomLeft);
+}
+
+void TextRenderer::drawBuffer(GLuint buffer, int quadCount, const Transform2D& transform, GLuint texture) {
+    // Nothing can be drawn until the text shader has compiled
+    if (!isReady()) {
+        return;
+    }
+    Shader* textShader = shaderAsset->getShader();
+    
+    // Use shader and setup rendering
+    textShader->use();
+    
+    // Setup vertex array using graphics API abstraction
+    graphics->setupVertexArray(textShader->getProgram(), buffer);
+    quadIndices->bind();
+    
+    // Set uniforms
+    Mat4 model = transform.toMatrix();
+    textShader->setMat4("uProjection", projection.m);
+    textShader->setMat4("uModel", model.m);
+    textShader->setInt("uTexture", 0);
+    
+    // Bind atlas (or the placeholder texel)
+    graphics->activeTexture(GL_TEXTURE0);
+    graphics->bindTexture(GL_TEXTURE_2D, texture);
+    
+    // 16-bit indices reach MAX_QUADS quads, so longer buffers are drawn in
+    // chunks by moving the attribute base offset
+    for (int first = 0; first < quadCount; first += QuadIndexBuffer::MAX_QUADS) {
+        int base = first * QuadIndexBuffer::VERTICES_PER_QUAD * sizeof(TextVertex);
+        graphics->enableVertexAttribute(textShader->getProgram(), "aPosition", 2, GL_FLOAT, sizeof(TextVertex), base + offsetof(TextVertex, x));
+        graphics->enableVertexAttribute(textShader->getProgram(), "aTexCoord", 2, GL_FLOAT, sizeof(TextVertex), base + offsetof(TextVertex, u));
+        graphics->enableVertexAttribute(textShader->getProgram(), "aColor", 4, GL_FLOAT, sizeof(TextVertex), base + offsetof(TextVertex, r));
+        
+        quadIndices->drawQuads(std::min(quadCount - first, QuadIndexBuffer::MAX_QUADS));
+        drawCalls++;
     }
-    return surface;
+    
+    // Cleanup
+    graphics->disableVertexAttribute(textShader->getProgram(), "aPosition");
+    graphics->disableVertexAttribute(textShader->getProgram(), "aTexCoord");
+    graphics->disableVertexAttribute(textShader->getProgram(), "aColor");
 }
\ No newline at end of file
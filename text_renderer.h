@@ -1,36 +1,179 @@
 #pragma once
 
 #include <SDL2/SDL_ttf.h>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 #include "shader.h"
+#include "shader_asset.h"
+#include "font_asset.h"
+#include "glyph_atlas.h"
+#include "text_layout.h"
+#include "text_markup.h"
+#include "transform.h"
+#include "graphics/gpu_resources.h"
 #include "graphics/graphics_api.h"
+#include "graphics/quad_index_buffer.h"
+
+class AssetLoader;
+class AssetPack;
+class JobSystem;
+
+// Glyph quads baked into a static buffer once; moving, scaling or scrolling
+// it only changes the transform uniform. The source is kept so a mesh built
+// from placeholders can be rebuilt once the font is resident.
+struct TextMesh {
+    BufferHandle buffer;
+    int quadCount = 0;
+    bool placeholder = false; // Built before the font was resident; rebuilt on the next draw after it is
+    std::string text;
+    float x = 0.0f, y = 0.0f;
+    float color[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    std::vector<uint32_t> pinnedGlyphs; // Atlas pins held while the mesh exists
+};
+
+// Text at a position, as stored per entity and drawn in bulk by renderLabels.
+// The characters live in a LabelText shared by many labels, so the component
+// is plain data and a packed array of them holds no pointers to chase.
+struct Label {
+    float x = 0.0f, y = 0.0f;
+    TextColor color = {1.0f, 1.0f, 1.0f, 1.0f};
+    uint32_t textOffset = 0, textLength = 0;
+};
+
+// Characters of many labels back to back. Text is only ever appended; clear
+// it once every label referring to it is gone.
+struct LabelText {
+    std::string characters;
+    
+    void assign(Label& label, std::string_view text) {
+        label.textOffset = (uint32_t)characters.size();
+        label.textLength = (uint32_t)text.size();
+        characters.append(text);
+    }
+    std::string_view get(const Label& label) const {
+        return std::string_view(characters).substr(label.textOffset, label.textLength);
+    }
+    void clear() { characters.clear(); }
+};
 
 class TextRenderer {
 public:
-    TextRenderer(GraphicsAPI* graphics);
+    // jobs is optional and only used to speed up atlas builds
+    TextRenderer(GraphicsAPI* graphics, GpuResources* resources, QuadIndexBuffer* quadIndices, JobSystem* jobs = nullptr);
     ~TextRenderer();
     
-    // Initialize the text renderer
+    // Initialize the text renderer, blocking until the font and shaders are loaded
     bool initialize(const std::string& fontPath, int fontSize, int windowWidth, int windowHeight);
     
-    // Render text at specified position
-    void renderText(const std::string& text, float x, float y);
+    // Initialize from a mapped asset pack; the pack must outlive the renderer
+    bool initialize(const AssetPack& pack, const std::string& fontName, int fontSize, int windowWidth, int windowHeight);
+    
+    // Start loading the font and shaders through the loader and return at once.
+    // Text is drawn as placeholder blocks until the font becomes resident.
+    bool initialize(AssetLoader& loader, const std::string& fontName, int fontSize, int windowWidth, int windowHeight);
+    
+    // True once text is drawn with the real font instead of placeholders
+    bool isFontReady() const;
+    
+    // True once the shaders are ready; text flushed before then is dropped
+    bool isReady() const;
+    
+    // Queue text at specified position; ANSI color escapes change color mid-string
+    void renderText(std::string_view text, float x, float y);
+    
+    // Queue a packed array of labels, such as a component array, in one pass;
+    // the offset moves them all, e.g. from canvas space into a scrolled view
+    void renderLabels(const Label* labels, size_t count, const LabelText& text, float offsetX = 0.0f, float offsetY = 0.0f);
+    
+    // Draw everything queued since the last flush in a single draw call
+    void flush();
+    
+    // Update the projection after a resize; queued vertices stay valid
+    void setViewportSize(int width, int height);
+    
+    // Transform applied to subsequently queued text (flushes if it changes)
+    void setTransform(const Transform2D& transform);
+    void resetTransform();
+    
+    // Retained text for scrolling panels and animated labels, in the current color.
+    // Meshes built before the font is resident are rebuilt when drawn after it is.
+    TextMesh createTextMesh(const std::string& text, float x, float y);
+    void drawTextMesh(TextMesh& mesh, const Transform2D& transform);
+    void destroyTextMesh(TextMesh& mesh);
     
-    // Set text color
-    void setColor(float r, float g, float b);
+    // Render a wrapped, aligned paragraph whose top-left corner is at (x, y)
+    void renderTextBlock(const std::string& text, float x, float y, float maxWidth, const TextStyle& style = TextStyle());
+    
+    // Distance between baselines (an estimate until the font is resident)
+    float getLineHeight() const;
+    
+    // Measure text from cached glyph metrics, without rasterizing
+    TextSize measureText(std::string_view text);
+    
+    // Layout engine bound to the loaded font (null until the font is resident)
+    TextLayout* getLayout() { return fontResident ? fontAsset->getLayout() : nullptr; }
+    
+    // Set default text color and opacity for subsequent text
+    void setColor(float r, float g, float b, float a = 1.0f);
+    
+    // Draw calls issued so far
+    int getDrawCallCount() const { return drawCalls; }
     
     // Cleanup resources
     void cleanup();
     
 private:
+    // Color lives in the vertex so a color change doesn't split the batch
+    struct TextVertex {
+        float x, y;
+        float u, v;
+        float r, g, b, a;
+    };
+    
     GraphicsAPI* graphics;
-    TTF_Font* font;
-    std::unique_ptr<Shader> textShader;
-    GLuint VBO;
-    GLuint textTexture;
+    GpuResources* resources;
+    QuadIndexBuffer* quadIndices;
+    JobSystem* jobs;
+    std::shared_ptr<FontAsset> fontAsset;
+    std::shared_ptr<ShaderAsset> shaderAsset;
+    bool fontResident;
+    TextureHandle placeholderTexture;
+    std::vector<TextVertex> batch;
+    BufferHandle VBO;
     int screenWidth, screenHeight;
-    float textColor[3];
+    Mat4 projection;
+    Transform2D currentTransform;
+    float textColor[4];
+    int drawCalls;
+    
+    // Create buffers and GL state shared by every initialize path
+    bool createResources();
+    
+    // Synchronous initialize: wait for the loader and check the results
+    bool finishLoading(AssetLoader& loader);
+    
+    // Switch from placeholders to the real font once it is ready (between batches only)
+    void updateFontResidency();
+    
+    // (Re)fill a mesh's buffer from its text, position and color
+    void buildTextMesh(TextMesh& mesh);
+    void releaseTextMesh(TextMesh& mesh);
+    
+    // Append glyph quads for a run of text, updating color as escapes are met
+    void appendText(std::string_view text, float x, float y, TextColor& color);
+    void appendQuad(float x, float y, float width, float height, const GlyphInfo& glyph, const TextColor& color);
+    
+    // Stand-in quads with estimated monospace metrics while the font loads
+    void appendPlaceholder(std::string_view text, float x, float y, TextColor& color, const TextColor& defaultColor);
+    void appendPlaceholderBlock(const std::string& text, float x, float y, float maxWidth, const TextStyle& style, TextColor& color);
+    float getPlaceholderAdvance() const;
+    float getPlaceholderLineHeight() const;
+    
+    // Texture matching the quads currently in the batch
+    GLuint getBatchTexture() const;
     
-    // Convert SDL surface to proper format
-    SDL_Surface* convertSurface(SDL_Surface* surface);
+    // Issue the indexed draw for a quad vertex buffer with the given model transform
+    void drawBuffer(GLuint buffer, int quadCount, const Transform2D& transform, GLuint texture);
 };
\ No newline at end of file
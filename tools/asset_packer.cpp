@@ -0,0 +1,143 @@
+#include "../assets/asset_pack.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+// Builds an asset pack from loose files:
+//   asset_packer <output.pak> <file>...
+//   asset_packer --list <input.pak>
+
+struct PackInput {
+    std::string name;
+    std::string contents;
+    AssetPackEntry entry;
+};
+
+static bool readFile(const std::string& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        printf("Failed to open file: %s\n", path.c_str());
+        return false;
+    }
+    
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    out = buffer.str();
+    return true;
+}
+
+static uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+static int writePack(const std::string& outputPath, const std::vector<std::string>& files) {
+    std::vector<PackInput> inputs;
+    for (const std::string& path : files) {
+        PackInput input;
+        input.name = path;
+        if (!readFile(path, input.contents)) {
+            return 1;
+        }
+        inputs.push_back(std::move(input));
+    }
+    
+    // Sort by name hash so the runtime can binary search the table of contents
+    for (PackInput& input : inputs) {
+        input.entry = AssetPackEntry();
+        input.entry.nameHash = AssetPack::hash(input.name);
+        input.entry.contentHash = AssetPack::hash(input.contents.data(), input.contents.size());
+        input.entry.size = input.contents.size();
+    }
+    std::sort(inputs.begin(), inputs.end(), [](const PackInput& a, const PackInput& b) {
+        return a.entry.nameHash < b.entry.nameHash;
+    });
+    
+    // Lay out header, table of contents, names, then aligned payloads
+    AssetPackHeader header;
+    memcpy(header.magic, ASSET_PACK_MAGIC, sizeof(header.magic));
+    header.version = ASSET_PACK_VERSION;
+    header.entryCount = (uint32_t)inputs.size();
+    header.alignment = ASSET_PACK_ALIGNMENT;
+    header.tocOffset = sizeof(AssetPackHeader);
+    header.namesOffset = header.tocOffset + inputs.size() * sizeof(AssetPackEntry);
+    
+    std::string names;
+    for (PackInput& input : inputs) {
+        input.entry.nameOffset = (uint32_t)names.size();
+        input.entry.nameLength = (uint32_t)input.name.size();
+        names += input.name;
+    }
+    
+    uint64_t offset = header.namesOffset + names.size();
+    for (PackInput& input : inputs) {
+        offset = alignUp(offset, ASSET_PACK_ALIGNMENT);
+        input.entry.offset = offset;
+        offset += input.entry.size;
+    }
+    header.fileSize = offset;
+    
+    std::ofstream out(outputPath, std::ios::binary);
+    if (!out.is_open()) {
+        printf("Failed to create pack: %s\n", outputPath.c_str());
+        return 1;
+    }
+    
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const PackInput& input : inputs) {
+        out.write(reinterpret_cast<const char*>(&input.entry), sizeof(input.entry));
+    }
+    out.write(names.data(), names.size());
+    
+    const char padding[ASSET_PACK_ALIGNMENT] = {};
+    for (const PackInput& input : inputs) {
+        uint64_t position = (uint64_t)out.tellp();
+        out.write(padding, input.entry.offset - position);
+        out.write(input.contents.data(), input.contents.size());
+        printf("  %-40s %10llu bytes @ %llu\n", input.name.c_str(),
+               (unsigned long long)input.entry.size, (unsigned long long)input.entry.offset);
+    }
+    
+    if (!out) {
+        printf("Failed to write pack: %s\n", outputPath.c_str());
+        return 1;
+    }
+    
+    printf("Wrote %s (%zu assets, %llu bytes)\n", outputPath.c_str(), inputs.size(), (unsigned long long)header.fileSize);
+    return 0;
+}
+
+static int listPack(const std::string& path) {
+    AssetPack pack;
+    if (!pack.open(path)) {
+        return 1;
+    }
+    
+    for (size_t i = 0; i < pack.getEntryCount(); i++) {
+        const AssetPackEntry& entry = pack.getEntry(i);
+        std::string_view name = pack.getEntryName(i);
+        printf("  %-40.*s %10llu bytes  %016llx\n", (int)name.size(), name.data(),
+               (unsigned long long)entry.size, (unsigned long long)entry.contentHash);
+    }
+    
+    bool valid = pack.verifyAll();
+    printf("Hashes %s\n", valid ? "OK" : "MISMATCH");
+    return valid ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc == 3 && strcmp(argv[1], "--list") == 0) {
+        return listPack(argv[2]);
+    }
+    
+    if (argc < 3) {
+        printf("Usage: %s <output.pak> <file>...\n", argv[0]);
+        printf("       %s --list <input.pak>\n", argv[0]);
+        return 1;
+    }
+    
+    std::vector<std::string> files(argv + 2, argv + argc);
+    return writePack(argv[1], files);
+}
\ No newline at end of file
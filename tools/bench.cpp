@@ -0,0 +1,724 @@
+#include "../assets/asset_pack.h"
+#include "../core/entity_registry.h"
+#include "../core/job_system.h"
+#include "../core/log_buffer.h"
+#include "../core/spatial_grid.h"
+#include "../font_library.h"
+#include "../glyph_rasterizer.h"
+#include "../transform.h"
+#include "../graphics/graphics_software.h"
+#include "../graphics/quad_index_buffer.h"
+#include "../utf8.h"
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+// Engine micro-benchmarks:
+//   bench assets <pack> <file>...   loose file loading vs. mapped asset pack
+//   bench jobs [maxThreads]          job system scaling from 1 to N threads
+//   bench glyphs <font> [size] [maxThreads]   glyph rasterization throughput
+//   bench utf8 [megabytes]           UTF-8 decoding throughput
+//   bench log [seconds]              log panel stream at 10k lines/sec
+//   bench raster [maxThreads] [out.png]   software renderer fill rate, 1 to N threads
+//   bench entities [count] [maxThreads]   entity create/destroy and system iteration
+//   bench culling [count]            viewport queries on a spatial grid vs. testing everything
+
+using BenchClock = std::chrono::steady_clock;
+
+// Heap allocations made by this process, for checking allocation-free paths
+static std::atomic<size_t> allocationCount(0);
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    void* memory = malloc(size);
+    if (!memory) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+static double elapsedMs(BenchClock::time_point start) {
+    return std::chrono::duration<double, std::milli>(BenchClock::now() - start).count();
+}
+
+// Same read path as Shader::loadFile
+static std::string loadLooseFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+// Every byte of a payload, so each path pays for actually reading its data
+static uint64_t sumBytes(const uint8_t* data, size_t size) {
+    uint64_t sum = 0;
+    for (size_t i = 0; i < size; i++) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+static int benchAssets(int argc, char* argv[]) {
+    if (argc < 2) {
+        printf("Usage: bench assets <pack> <file>...\n");
+        return 1;
+    }
+    
+    const std::string packPath = argv[0];
+    std::vector<std::string> files(argv + 1, argv + argc);
+    const int iterations = 200;
+    
+    // Loose files: open + read + copy per asset, like the current loaders
+    uint64_t looseChecksum = 0;
+    auto start = BenchClock::now();
+    for (int i = 0; i < iterations; i++) {
+        for (const std::string& path : files) {
+            std::string contents = loadLooseFile(path);
+            looseChecksum += sumBytes(reinterpret_cast<const uint8_t*>(contents.data()), contents.size());
+        }
+    }
+    double looseMs = elapsedMs(start) / iterations;
+    
+    // Pack: map once, then every lookup is a binary search plus a pointer
+    start = BenchClock::now();
+    AssetPack pack;
+    if (!pack.open(packPath)) {
+        return 1;
+    }
+    double openMs = elapsedMs(start);
+    
+    uint64_t packChecksum = 0;
+    start = BenchClock::now();
+    for (int i = 0; i < iterations; i++) {
+        for (const std::string& path : files) {
+            AssetSpan span = pack.find(path);
+            if (span.empty()) {
+                printf("Missing from pack: %s\n", path.c_str());
+                return 1;
+            }
+            packChecksum += sumBytes(span.data, span.size);
+        }
+    }
+    double packMs = elapsedMs(start) / iterations;
+    
+    // Cold path: reopen the pack every iteration, as a fresh process would
+    uint64_t reopenChecksum = 0;
+    start = BenchClock::now();
+    for (int i = 0; i < iterations; i++) {
+        AssetPack reopened;
+        reopened.open(packPath);
+        for (const std::string& path : files) {
+            AssetSpan span = reopened.find(path);
+            reopenChecksum += sumBytes(span.data, span.size);
+        }
+    }
+    double reopenMs = elapsedMs(start) / iterations;
+    
+    start = BenchClock::now();
+    bool valid = pack.verifyAll();
+    double verifyMs = elapsedMs(start);
+    
+    printf("Assets: %zu files, %d iterations\n", files.size(), iterations);
+    printf("  loose files (read + copy):  %8.3f ms/load\n", looseMs);
+    printf("  pack open (mmap):           %8.3f ms\n", openMs);
+    printf("  pack lookups (zero-copy):   %8.3f ms/load\n", packMs);
+    printf("  pack open + lookups:        %8.3f ms/load\n", reopenMs);
+    printf("  pack hash verification:     %8.3f ms (%s)\n", verifyMs, valid ? "OK" : "MISMATCH");
+    printf("  (every payload byte summed in each path; checksum %llu, %s)\n", (unsigned long long)looseChecksum,
+           looseChecksum == packChecksum && packChecksum == reopenChecksum ? "paths agree" : "PATHS DIFFER");
+    return 0;
+}
+
+static int benchJobs(int argc, char* argv[]) {
+    int maxThreads = argc >= 1 ? atoi(argv[0]) : (int)std::thread::hardware_concurrency();
+    maxThreads = std::max(1, maxThreads);
+    
+    // Hash workload: 64 MB in 64 KB blocks, roughly one glyph page or shader per job
+    const size_t blockSize = 64 * 1024;
+    const size_t blockCount = 1024;
+    std::vector<uint8_t> data(blockSize * blockCount);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t)(i * 2654435761u >> 13);
+    }
+    std::vector<uint64_t> hashes(blockCount);
+    
+    // Tiny jobs stress scheduling overhead rather than compute
+    const int tinyJobs = 100000;
+    
+    printf("Jobs: %zu x %zu KB hash blocks, %d tiny jobs\n", blockCount, blockSize / 1024, tinyJobs);
+    printf("  threads   hash ms  speedup   tiny ms  jobs/ms\n");
+    
+    double baselineMs = 0.0;
+    for (int threads = 1; threads <= maxThreads; threads++) {
+        JobSystem jobs(threads - 1);
+        
+        auto start = BenchClock::now();
+        jobs.parallelFor(blockCount, 4, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                hashes[i] = AssetPack::hash(&data[i * blockSize], blockSize);
+            }
+        });
+        double hashMs = elapsedMs(start);
+        if (threads == 1) {
+            baselineMs = hashMs;
+        }
+        
+        std::atomic<int> executed(0);
+        JobCounter counter;
+        start = BenchClock::now();
+        for (int i = 0; i < tinyJobs; i++) {
+            jobs.run([&executed]() { executed.fetch_add(1, std::memory_order_relaxed); }, &counter);
+        }
+        jobs.wait(counter);
+        double tinyMs = elapsedMs(start);
+        
+        printf("  %7d  %8.2f  %6.2fx  %8.2f  %7.0f\n", threads, hashMs, baselineMs / hashMs, tinyMs, executed / tinyMs);
+    }
+    
+    uint64_t checksum = 0;
+    for (uint64_t value : hashes) {
+        checksum += value;
+    }
+    printf("  (checksum %llu)\n", (unsigned long long)checksum);
+    return 0;
+}
+
+static int benchGlyphs(int argc, char* argv[]) {
+    if (argc < 1) {
+        printf("Usage: bench glyphs <font.ttf> [pointSize] [maxThreads]\n");
+        return 1;
+    }
+    
+    std::string fontData = loadLooseFile(argv[0]);
+    int pointSize = argc >= 2 ? atoi(argv[1]) : 24;
+    int maxThreads = argc >= 3 ? atoi(argv[2]) : (int)std::thread::hardware_concurrency();
+    maxThreads = std::max(1, maxThreads);
+    if (fontData.empty()) {
+        printf("Failed to read font: %s\n", argv[0]);
+        return 1;
+    }
+    
+    if (TTF_Init() == -1) {
+        printf("SDL_ttf initialization failed: %s\n", TTF_GetError());
+        return 1;
+    }
+    
+    // Warm the whole Basic Multilingual Plane coverage of the font, like a language switch would
+    TTF_Font* font = openFontFromMemory(fontData.data(), fontData.size(), pointSize);
+    if (!font) {
+        printf("Failed to load font: %s\n", TTF_GetError());
+        return 1;
+    }
+    std::vector<uint32_t> codepoints;
+    for (uint32_t codepoint = 32; codepoint < 0x10000; codepoint++) {
+        if (TTF_GlyphIsProvided32(font, codepoint)) {
+            codepoints.push_back(codepoint);
+        }
+    }
+    closeFont(font);
+    
+    printf("Glyphs: %zu codepoints at %dpt\n", codepoints.size(), pointSize);
+    printf("  threads        ms   glyphs/sec  speedup\n");
+    
+    double baselineMs = 0.0;
+    for (int threads = 1; threads <= maxThreads; threads++) {
+        JobSystem jobs(threads - 1);
+        GlyphRasterizer rasterizer(fontData.data(), fontData.size(), pointSize);
+        std::vector<GlyphBitmap> bitmaps;
+        
+        auto start = BenchClock::now();
+        rasterizer.rasterize(codepoints, bitmaps, &jobs);
+        double ms = elapsedMs(start);
+        if (threads == 1) {
+            baselineMs = ms;
+        }
+        
+        printf("  %7d  %8.2f  %11.0f  %6.2fx\n", threads, ms, codepoints.size() / (ms / 1000.0), baselineMs / ms);
+    }
+    
+    TTF_Quit();
+    return 0;
+}
+
+static int benchUtf8(int argc, char* argv[]) {
+    size_t megabytes = argc >= 1 ? (size_t)std::max(1, atoi(argv[0])) : 16;
+    
+    // Pure ASCII log text, and a mix of Latin, Cyrillic, CJK and emoji
+    const char* samples[2][2] = {
+        {"ascii", "The quick brown fox jumps over the lazy dog 0123456789. "},
+        {"mixed", "Caf\xC3\xA9 \xD0\x9F\xD1\x80\xD0\xB8\xD0\xB2\xD0\xB5\xD1\x82 "
+                  "\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E \xF0\x9F\x98\x80 ok. "}
+    };
+    
+    printf("UTF-8: %zu MB per run\n", megabytes);
+    printf("  text    bytes/cp  per-codepoint MB/s  bulk MB/s\n");
+    
+    uint64_t checksum = 0;
+    for (const auto& sample : samples) {
+        std::string text;
+        while (text.size() < megabytes * 1024 * 1024) {
+            text += sample[1];
+        }
+        
+        // Decode the way layout and rendering walk text
+        auto start = BenchClock::now();
+        size_t count = 0;
+        size_t pos = 0;
+        while (pos < text.size()) {
+            checksum += nextCodepoint(text, pos);
+            count++;
+        }
+        double stepMs = elapsedMs(start);
+        
+        std::vector<uint32_t> codepoints(text.size());
+        start = BenchClock::now();
+        size_t bulkCount = decodeUtf8(text, codepoints.data());
+        double bulkMs = elapsedMs(start);
+        checksum += bulkCount == count ? codepoints[bulkCount / 2] : 0;
+        
+        double mb = text.size() / (1024.0 * 1024.0);
+        printf("  %-6s  %8.2f  %18.0f  %9.0f\n", sample[0], (double)text.size() / count, mb / (stepMs / 1000.0), mb / (bulkMs / 1000.0));
+    }
+    printf("  (checksum %llu)\n", (unsigned long long)checksum);
+    return 0;
+}
+
+static int benchLog(int argc, char* argv[]) {
+    int seconds = argc >= 1 ? std::max(1, atoi(argv[0])) : 10;
+    
+    // Same shape as the log panel: 100k lines of history in 8 MB, a 40-line
+    // window, and 10k lines/sec arriving as 60 frames of ~167 lines
+    const int linesPerSecond = 10000;
+    const int framesPerSecond = 60;
+    const int visibleLines = 40;
+    LogBuffer buffer(100000, 8 * 1024 * 1024);
+    
+    char line[128];
+    uint64_t checksum = 0;
+    size_t allocationsBefore = allocationCount.load();
+    double appendMs = 0.0;
+    double windowMs = 0.0;
+    int frames = seconds * framesPerSecond;
+    for (int frame = 0; frame < frames; frame++) {
+        auto start = BenchClock::now();
+        int count = linesPerSecond * (frame + 1) / framesPerSecond - linesPerSecond * frame / framesPerSecond;
+        for (int i = 0; i < count; i++) {
+            uint64_t number = buffer.getTotalLines();
+            int length = snprintf(line, sizeof(line), "\x1b[90m%8llu\x1b[0m event worker %llu finished job in %llu us",
+                                  (unsigned long long)number, (unsigned long long)(number % 8), (unsigned long long)(number * 37 % 900));
+            buffer.append(std::string_view(line, length));
+        }
+        appendMs += elapsedMs(start);
+        
+        // What a draw touches: the visible window at the bottom
+        start = BenchClock::now();
+        size_t lineCount = buffer.getLineCount();
+        for (size_t i = lineCount - std::min<size_t>(lineCount, visibleLines); i < lineCount; i++) {
+            checksum += buffer.getLine(i).size();
+        }
+        windowMs += elapsedMs(start);
+    }
+    size_t allocations = allocationCount.load() - allocationsBefore;
+    
+    uint64_t total = buffer.getTotalLines();
+    printf("Log: %llu lines over %d simulated seconds (%d lines/sec)\n", (unsigned long long)total, seconds, linesPerSecond);
+    printf("  append:          %8.1f ns/line  %8.3f ms/frame\n", appendMs * 1e6 / total, appendMs / frames);
+    printf("  visible window:  %8.3f us/frame (%d lines)\n", windowMs * 1000.0 / frames, visibleLines);
+    printf("  retained:        %zu lines\n", buffer.getLineCount());
+    printf("  allocations:     %zu\n", allocations);
+    printf("  (checksum %llu)\n", (unsigned long long)checksum);
+    return allocations == 0 ? 0 : 1;
+}
+
+static int benchRaster(int argc, char* argv[]) {
+    int maxThreads = argc >= 1 ? atoi(argv[0]) : (int)std::thread::hardware_concurrency();
+    maxThreads = std::max(1, maxThreads);
+    const char* outputPath = argc >= 2 ? argv[1] : nullptr;
+    
+    // A 1080p frame shaped like a text-heavy UI: a full-screen sprite backdrop
+    // and 20k glyph quads sampling a 256x256 coverage atlas
+    const int width = 1920, height = 1080;
+    const int glyphCount = 20000;
+    const int frames = 20;
+    std::string textVertex = loadLooseFile("shaders/text_vertex_core.glsl");
+    std::string textFragment = loadLooseFile("shaders/text_fragment_core.glsl");
+    std::string spriteVertex = loadLooseFile("shaders/sprite_vertex_core.glsl");
+    std::string spriteFragment = loadLooseFile("shaders/sprite_fragment_core.glsl");
+    if (textFragment.empty() || spriteFragment.empty()) {
+        printf("Run from the repository root; shaders/ not found\n");
+        return 1;
+    }
+    
+    struct Vertex {
+        float x, y, u, v, r, g, b, a;
+    };
+    std::vector<Vertex> backdrop = {
+        {0, 0, 0, 0, 0.1f, 0.1f, 0.3f, 1}, {width, 0, 1, 0, 0.1f, 0.1f, 0.3f, 1},
+        {width, height, 1, 1, 0.1f, 0.1f, 0.3f, 1}, {0, height, 0, 1, 0.1f, 0.1f, 0.3f, 1}};
+    std::vector<Vertex> glyphs;
+    uint32_t seed = 12345;
+    auto random = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+    for (int i = 0; i < glyphCount; i++) {
+        float x = (float)(random() % (width - 12)), y = (float)(random() % (height - 20));
+        float u = (random() % 16) / 16.0f, v = (random() % 16) / 16.0f;
+        glyphs.push_back({x, y, u, v, 1, 1, 0.6f, 1});
+        glyphs.push_back({x + 12, y, u + 1 / 16.0f, v, 1, 1, 0.6f, 1});
+        glyphs.push_back({x + 12, y + 20, u + 1 / 16.0f, v + 1 / 16.0f, 1, 1, 0.6f, 1});
+        glyphs.push_back({x, y + 20, u, v + 1 / 16.0f, 1, 1, 0.6f, 1});
+    }
+    std::vector<uint8_t> atlas(256 * 256 * 4);
+    for (size_t i = 0; i < atlas.size(); i += 4) {
+        atlas[i] = atlas[i + 1] = atlas[i + 2] = 255;
+        atlas[i + 3] = (uint8_t)((i / 4 * 37) % 256);
+    }
+    Mat4 projection = Mat4::ortho(0, width, height, 0);
+    Mat4 model = Mat4::identity();
+    
+    printf("Software raster: %dx%d, %d glyph quads + backdrop, %d frames\n", width, height, glyphCount, frames);
+    printf("  threads  ms/frame  Mpixels/sec  speedup\n");
+    double baseline = 0.0;
+    for (int threads = 1; threads <= maxThreads; threads++) {
+        std::unique_ptr<JobSystem> jobs = threads > 1 ? std::make_unique<JobSystem>(threads - 1) : nullptr;
+        GraphicsSoftware graphics(width, height, jobs.get());
+        GpuResources resources(&graphics);
+        QuadIndexBuffer quads(&graphics, &resources);
+        quads.initialize();
+        GLuint text = graphics.createProgram(graphics.compileShader(GL_VERTEX_SHADER, textVertex),
+                                             graphics.compileShader(GL_FRAGMENT_SHADER, textFragment));
+        GLuint sprite = graphics.createProgram(graphics.compileShader(GL_VERTEX_SHADER, spriteVertex),
+                                               graphics.compileShader(GL_FRAGMENT_SHADER, spriteFragment));
+        GLuint texture = graphics.createTexture();
+        graphics.bindTexture(GL_TEXTURE_2D, texture);
+        graphics.texImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 256, 256, GL_RGBA, GL_UNSIGNED_BYTE, atlas.data());
+        GLuint backdropBuffer = graphics.createBuffer();
+        graphics.bindBuffer(GL_ARRAY_BUFFER, backdropBuffer);
+        graphics.bufferData(GL_ARRAY_BUFFER, backdrop.size() * sizeof(Vertex), backdrop.data(), GL_STATIC_DRAW);
+        GLuint glyphBuffer = graphics.createBuffer();
+        graphics.bindBuffer(GL_ARRAY_BUFFER, glyphBuffer);
+        graphics.bufferData(GL_ARRAY_BUFFER, glyphs.size() * sizeof(Vertex), glyphs.data(), GL_STATIC_DRAW);
+        
+        auto draw = [&](GLuint program, GLuint buffer, int first, int count) {
+            graphics.useProgram(program);
+            graphics.setupVertexArray(program, buffer);
+            quads.bind();
+            graphics.setUniformMatrix4fv(program, "uProjection", projection.m);
+            graphics.setUniformMatrix4fv(program, "uModel", model.m);
+            graphics.setUniform1i(program, "uTexture", 0);
+            int base = first * QuadIndexBuffer::VERTICES_PER_QUAD * sizeof(Vertex);
+            graphics.enableVertexAttribute(program, "aPosition", 2, GL_FLOAT, sizeof(Vertex), base);
+            graphics.enableVertexAttribute(program, "aTexCoord", 2, GL_FLOAT, sizeof(Vertex), base + 8);
+            graphics.enableVertexAttribute(program, "aColor", 4, GL_FLOAT, sizeof(Vertex), base + 16);
+            quads.drawQuads(count);
+        };
+        
+        auto start = BenchClock::now();
+        for (int frame = 0; frame < frames; frame++) {
+            graphics.clearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            graphics.clear(GL_COLOR_BUFFER_BIT);
+            graphics.enable(GL_BLEND);
+            graphics.blendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            draw(sprite, backdropBuffer, 0, 1);
+            graphics.blendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+            for (int first = 0; first < glyphCount; first += QuadIndexBuffer::MAX_QUADS) {
+                draw(text, glyphBuffer, first, std::min(glyphCount - first, QuadIndexBuffer::MAX_QUADS));
+            }
+        }
+        double frameMs = elapsedMs(start) / frames;
+        if (threads == 1) {
+            baseline = frameMs;
+        }
+        double pixels = (double)width * height + glyphCount * 12.0 * 20.0;
+        printf("  %7d  %8.2f  %11.0f  %6.2fx\n", threads, frameMs, pixels / (frameMs * 1000.0), baseline / frameMs);
+        
+        if (outputPath && threads == maxThreads) {
+            graphics.saveFrame(outputPath);
+        }
+    }
+    return 0;
+}
+
+// Components shaped like the app's sprite stress test
+struct BenchSprite {
+    float x, y, width, height;
+    float r, g, b, a;
+};
+
+struct BenchVelocity {
+    float dx, dy;
+};
+
+// The layout the registry replaces: one heap object per on-screen thing
+struct BenchObject {
+    BenchSprite sprite;
+    BenchVelocity velocity;
+    char otherState[64]; // Name, flags, callbacks; loaded with the object whether used or not
+};
+
+static void moveSprite(BenchVelocity& velocity, BenchSprite& sprite) {
+    sprite.x += velocity.dx * 0.016f;
+    sprite.y += velocity.dy * 0.016f;
+    if (sprite.x < 0.0f || sprite.x > 1000.0f) {
+        velocity.dx = -velocity.dx;
+    }
+    if (sprite.y < 0.0f || sprite.y > 1000.0f) {
+        velocity.dy = -velocity.dy;
+    }
+}
+
+static int benchEntities(int argc, char* argv[]) {
+    size_t count = argc >= 1 ? (size_t)atol(argv[0]) : 200000;
+    int maxThreads = argc >= 2 ? atoi(argv[1]) : (int)std::thread::hardware_concurrency();
+    maxThreads = std::max(1, maxThreads);
+    const int passes = 20;
+    
+    printf("Entities: %zu with sprite + velocity, %d passes per iteration test\n", count, passes);
+    
+    EntityRegistry registry;
+    std::vector<Entity> entities(count);
+    uint32_t seed = 12345;
+    auto random = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+    
+    // Insert: entity plus two components each
+    auto start = BenchClock::now();
+    for (size_t i = 0; i < count; i++) {
+        entities[i] = registry.create();
+        registry.add(entities[i], BenchSprite{(float)(random() % 1000), (float)(random() % 1000), 8, 8, 1, 1, 1, 1});
+        registry.add(entities[i], BenchVelocity{(float)(random() % 400) - 200.0f, (float)(random() % 400) - 200.0f});
+    }
+    double insertMs = elapsedMs(start);
+    
+    // Churn: destroy a random 10% and create replacements, which scrambles array order
+    size_t churn = count / 10;
+    start = BenchClock::now();
+    for (size_t i = 0; i < churn; i++) {
+        size_t victim = random() % count;
+        registry.destroy(entities[victim]);
+        entities[victim] = registry.create();
+        registry.add(entities[victim], BenchSprite{0, 0, 8, 8, 1, 1, 1, 1});
+        registry.add(entities[victim], BenchVelocity{50.0f, -50.0f});
+    }
+    double churnMs = elapsedMs(start);
+    
+    printf("  insert:           %8.1f ns/entity\n", insertMs * 1e6 / count);
+    printf("  destroy + create: %8.1f ns/entity\n", churnMs * 1e6 / churn);
+    
+    // Single array walk: what a renderer reading the sprite array does
+    double checksum = 0.0;
+    start = BenchClock::now();
+    for (int pass = 0; pass < passes; pass++) {
+        registry.each<BenchSprite>([&](Entity, BenchSprite& sprite) {
+            checksum += sprite.x;
+        });
+    }
+    double readMs = elapsedMs(start) / passes;
+    
+    // Two-component system, before and after lining the arrays up
+    start = BenchClock::now();
+    for (int pass = 0; pass < passes; pass++) {
+        registry.eachPair<BenchVelocity, BenchSprite>([](Entity, BenchVelocity& velocity, BenchSprite& sprite) {
+            moveSprite(velocity, sprite);
+        });
+    }
+    double scatteredMs = elapsedMs(start) / passes;
+    
+    start = BenchClock::now();
+    registry.getArray<BenchSprite>().arrangeLike(registry.getArray<BenchVelocity>());
+    double arrangeMs = elapsedMs(start);
+    
+    start = BenchClock::now();
+    for (int pass = 0; pass < passes; pass++) {
+        registry.eachPair<BenchVelocity, BenchSprite>([](Entity, BenchVelocity& velocity, BenchSprite& sprite) {
+            moveSprite(velocity, sprite);
+        });
+    }
+    double arrangedMs = elapsedMs(start) / passes;
+    
+    // Baseline: heap objects visited through pointers in creation order
+    std::vector<std::unique_ptr<BenchObject>> objects(count);
+    for (size_t i = 0; i < count; i++) {
+        objects[i] = std::make_unique<BenchObject>();
+        objects[i]->sprite = BenchSprite{(float)(random() % 1000), (float)(random() % 1000), 8, 8, 1, 1, 1, 1};
+        objects[i]->velocity = BenchVelocity{(float)(random() % 400) - 200.0f, (float)(random() % 400) - 200.0f};
+    }
+    for (size_t i = 0; i < churn; i++) {
+        objects[random() % count] = std::make_unique<BenchObject>();
+    }
+    start = BenchClock::now();
+    for (int pass = 0; pass < passes; pass++) {
+        for (std::unique_ptr<BenchObject>& object : objects) {
+            moveSprite(object->velocity, object->sprite);
+        }
+    }
+    double objectsMs = elapsedMs(start) / passes;
+    
+    printf("  sprite walk:      %8.3f ms  %6.2f ns/entity\n", readMs, readMs * 1e6 / count);
+    printf("  move, scattered:  %8.3f ms  %6.2f ns/entity\n", scatteredMs, scatteredMs * 1e6 / count);
+    printf("  arrange:          %8.3f ms\n", arrangeMs);
+    printf("  move, arranged:   %8.3f ms  %6.2f ns/entity\n", arrangedMs, arrangedMs * 1e6 / count);
+    printf("  heap objects:     %8.3f ms  %6.2f ns/entity\n", objectsMs, objectsMs * 1e6 / count);
+    
+    printf("  threads   move ms  speedup\n");
+    double baselineMs = 0.0;
+    for (int threads = 1; threads <= maxThreads; threads++) {
+        JobSystem jobs(threads - 1);
+        start = BenchClock::now();
+        for (int pass = 0; pass < passes; pass++) {
+            registry.parallelEachPair<BenchVelocity, BenchSprite>(jobs, 4096, [](Entity, BenchVelocity& velocity, BenchSprite& sprite) {
+                moveSprite(velocity, sprite);
+            });
+        }
+        double ms = elapsedMs(start) / passes;
+        if (threads == 1) {
+            baselineMs = ms;
+        }
+        printf("  %7d  %8.3f  %6.2fx\n", threads, ms, baselineMs / ms);
+    }
+    
+    start = BenchClock::now();
+    for (Entity entity : entities) {
+        registry.destroy(entity);
+    }
+    double destroyMs = elapsedMs(start);
+    printf("  destroy all:      %8.1f ns/entity (%zu left)\n", destroyMs * 1e6 / count, registry.getAliveCount());
+    
+    for (std::unique_ptr<BenchObject>& object : objects) {
+        checksum += object->sprite.x;
+    }
+    printf("  (checksum %.0f)\n", checksum);
+    return 0;
+}
+
+static int benchCulling(int argc, char* argv[]) {
+    size_t count = argc >= 1 ? (size_t)atol(argv[0]) : 50000;
+    const int passes = 200;
+    
+    // Label-sized rectangles at the density of a busy window, on a canvas that grows with the count
+    const float viewportWidth = 1000.0f;
+    const float viewportHeight = 1000.0f;
+    float canvasSize = viewportWidth * std::max(1.0f, std::sqrt(count / 2000.0f));
+    printf("Culling: %zu rects on a %.0fx%.0f canvas, %.0fx%.0f viewport\n", count, canvasSize, canvasSize, viewportWidth,
+           viewportHeight);
+    
+    uint32_t seed = 12345;
+    auto random = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    };
+    std::vector<Rect2D> rects(count);
+    for (Rect2D& rect : rects) {
+        rect = Rect2D{(float)(random() % (uint32_t)canvasSize), (float)(random() % (uint32_t)canvasSize), 40.0f + random() % 120, 20.0f};
+    }
+    
+    SpatialGrid grid;
+    auto start = BenchClock::now();
+    for (size_t i = 0; i < count; i++) {
+        grid.update((uint32_t)i, rects[i]);
+    }
+    double insertMs = elapsedMs(start);
+    
+    // Viewports scrolled across the canvas
+    std::vector<Rect2D> viewports(passes);
+    for (Rect2D& viewport : viewports) {
+        float range = std::max(1.0f, canvasSize - viewportWidth);
+        viewport = Rect2D{(float)(random() % (uint32_t)range), (float)(random() % (uint32_t)range), viewportWidth, viewportHeight};
+    }
+    
+    // Baseline: every rect tested against the viewport, which is what drawing everything costs before the draw
+    size_t visible = 0;
+    start = BenchClock::now();
+    for (const Rect2D& viewport : viewports) {
+        for (const Rect2D& rect : rects) {
+            visible += rect.overlaps(viewport);
+        }
+    }
+    double scanMs = elapsedMs(start) / passes;
+    
+    std::vector<uint32_t> results;
+    size_t queried = 0;
+    start = BenchClock::now();
+    for (const Rect2D& viewport : viewports) {
+        results.clear();
+        grid.query(viewport, results);
+        queried += results.size();
+    }
+    double queryMs = elapsedMs(start) / passes;
+    
+    // Every rect nudged each frame, as moving sprites are; most stay within their cells
+    start = BenchClock::now();
+    for (int pass = 0; pass < 20; pass++) {
+        for (size_t i = 0; i < count; i++) {
+            rects[i].x += (i & 1) ? 1.5f : -1.5f;
+            grid.update((uint32_t)i, rects[i]);
+        }
+    }
+    double moveMs = elapsedMs(start) / 20;
+    
+    printf("  insert:         %8.1f ns/rect (%zu cells)\n", insertMs * 1e6 / count, grid.getCellCount());
+    printf("  move:           %8.1f ns/rect\n", moveMs * 1e6 / count);
+    printf("  scan all:       %8.3f ms/query\n", scanMs);
+    printf("  grid query:     %8.3f ms/query  %6.1fx\n", queryMs, scanMs / queryMs);
+    printf("  visible:        %8.1f rects/query (%s)\n", (double)queried / passes, queried == visible ? "matches scan" : "MISMATCH");
+    return queried == visible ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && strcmp(argv[1], "assets") == 0) {
+        return benchAssets(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "jobs") == 0) {
+        return benchJobs(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "glyphs") == 0) {
+        return benchGlyphs(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "utf8") == 0) {
+        return benchUtf8(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "log") == 0) {
+        return benchLog(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "raster") == 0) {
+        return benchRaster(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "entities") == 0) {
+        return benchEntities(argc - 2, argv + 2);
+    }
+    if (argc >= 2 && strcmp(argv[1], "culling") == 0) {
+        return benchCulling(argc - 2, argv + 2);
+    }
+    
+    printf("Usage: %s <benchmark> [args]\n", argv[0]);
+    printf("  assets <pack> <file>...   loose files vs. mapped asset pack\n");
+    printf("  jobs [maxThreads]         job system scaling from 1 to N threads\n");
+    printf("  glyphs <font> [size] [maxThreads]   glyph rasterization throughput\n");
+    printf("  utf8 [megabytes]          UTF-8 decoding throughput\n");
+    printf("  log [seconds]             log panel stream at 10k lines/sec\n");
+    printf("  raster [maxThreads] [out.png]   software renderer fill rate\n");
+    printf("  entities [count] [maxThreads]   entity create/destroy and system iteration\n");
+    printf("  culling [count]           viewport queries on a spatial grid vs. testing everything\n");
+    return 1;
+}
\ No newline at end of file
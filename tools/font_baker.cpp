@@ -0,0 +1,352 @@
+#include "../baked_font.h"
+#include "../font_library.h"
+#include "../glyph_rasterizer.h"
+#include "../core/job_system.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+// Bakes a TTF into a font atlas that TextRenderer loads without FreeType:
+//   font_baker <font.ttf> <output.ejfa> [--sizes 16,24,32] [--charset ascii|latin1|<utf8 file>] [--page 1024]
+
+const int GLYPH_PADDING = 1;
+
+// Kerning is looked up for every pair, so it is limited to Latin scripts where it matters
+const uint32_t KERNING_LIMIT = 0x250;
+
+struct BakedGlyph {
+    BakedGlyphRecord record;
+    std::vector<uint8_t> alpha; // width x height coverage
+};
+
+struct BakedFace {
+    BakedFaceRecord record;
+    std::vector<BakedGlyph> glyphs;
+    std::vector<BakedKerningRecord> kerning;
+};
+
+static bool readFile(const std::string& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        printf("Failed to open file: %s\n", path.c_str());
+        return false;
+    }
+    
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    out = buffer.str();
+    return true;
+}
+
+// Codepoints of a UTF-8 text file; malformed bytes are skipped
+static void addCodepointsFromText(const std::string& text, std::vector<uint32_t>& codepoints) {
+    for (size_t i = 0; i < text.size();) {
+        unsigned char lead = text[i];
+        int length = lead < 0x80 ? 1 : (lead >> 5) == 0x6 ? 2 : (lead >> 4) == 0xE ? 3 : (lead >> 3) == 0x1E ? 4 : 0;
+        if (length == 0 || i + length > text.size()) {
+            i++;
+            continue;
+        }
+        
+        uint32_t codepoint = length == 1 ? lead : lead & (0x7F >> length);
+        for (int k = 1; k < length; k++) {
+            codepoint = codepoint << 6 | (text[i + k] & 0x3F);
+        }
+        if (codepoint >= 32) {
+            codepoints.push_back(codepoint);
+        }
+        i += length;
+    }
+}
+
+static bool parseCharset(const std::string& charset, std::vector<uint32_t>& codepoints) {
+    for (uint32_t codepoint = 32; codepoint < 127; codepoint++) {
+        codepoints.push_back(codepoint);
+    }
+    
+    if (charset == "latin1") {
+        for (uint32_t codepoint = 160; codepoint < 256; codepoint++) {
+            codepoints.push_back(codepoint);
+        }
+    } else if (charset != "ascii") {
+        std::string text;
+        if (!readFile(charset, text)) {
+            return false;
+        }
+        addCodepointsFromText(text, codepoints);
+    }
+    
+    std::sort(codepoints.begin(), codepoints.end());
+    codepoints.erase(std::unique(codepoints.begin(), codepoints.end()), codepoints.end());
+    return true;
+}
+
+// Crop a rasterized glyph to its ink and keep only coverage
+static void trimGlyph(const GlyphBitmap& bitmap, BakedGlyph& glyph) {
+    int minX = bitmap.width, minY = bitmap.height, maxX = -1, maxY = -1;
+    for (int y = 0; y < bitmap.height; y++) {
+        for (int x = 0; x < bitmap.width; x++) {
+            if (bitmap.pixels[((size_t)y * bitmap.width + x) * 4 + 3]) {
+                minX = std::min(minX, x);
+                minY = std::min(minY, y);
+                maxX = std::max(maxX, x);
+                maxY = std::max(maxY, y);
+            }
+        }
+    }
+    if (maxX < 0) {
+        return; // Blank glyph such as space; only the advance matters
+    }
+    
+    glyph.record.width = (uint16_t)(maxX - minX + 1);
+    glyph.record.height = (uint16_t)(maxY - minY + 1);
+    glyph.record.xOffset = (int16_t)minX;
+    glyph.record.yOffset = (int16_t)minY;
+    glyph.alpha.resize((size_t)glyph.record.width * glyph.record.height);
+    for (int y = 0; y < glyph.record.height; y++) {
+        for (int x = 0; x < glyph.record.width; x++) {
+            glyph.alpha[(size_t)y * glyph.record.width + x] = bitmap.pixels[((size_t)(minY + y) * bitmap.width + minX + x) * 4 + 3];
+        }
+    }
+}
+
+static bool bakeFace(const std::string& fontData, int pointSize, const std::vector<uint32_t>& charset, JobSystem& jobs, BakedFace& face) {
+    TTF_Font* font = openFontFromMemory(fontData.data(), fontData.size(), pointSize);
+    if (!font) {
+        printf("Failed to load font: %s\n", TTF_GetError());
+        return false;
+    }
+    
+    std::vector<uint32_t> codepoints;
+    for (uint32_t codepoint : charset) {
+        if (TTF_GlyphIsProvided32(font, codepoint)) {
+            codepoints.push_back(codepoint);
+        }
+    }
+    
+    // Bitmaps in parallel, one font instance per worker
+    GlyphRasterizer rasterizer(fontData.data(), fontData.size(), pointSize);
+    std::vector<GlyphBitmap> bitmaps;
+    if (!rasterizer.rasterize(codepoints, bitmaps, &jobs)) {
+        closeFont(font);
+        return false;
+    }
+    
+    face.record = BakedFaceRecord();
+    face.record.pointSize = (uint32_t)pointSize;
+    face.record.lineHeight = (float)TTF_FontLineSkip(font);
+    face.glyphs.resize(codepoints.size());
+    for (size_t i = 0; i < codepoints.size(); i++) {
+        BakedGlyph& glyph = face.glyphs[i];
+        glyph.record = BakedGlyphRecord();
+        glyph.record.codepoint = codepoints[i];
+        
+        int advance = 0;
+        TTF_GlyphMetrics32(font, codepoints[i], nullptr, nullptr, nullptr, nullptr, &advance);
+        glyph.record.advance = (float)advance;
+        trimGlyph(bitmaps[i], glyph);
+    }
+    
+    if (TTF_GetFontKerning(font)) {
+        // SDL_ttf can't list a font's pairs, so every pair below the limit is asked for.
+        // Codepoints are sorted, which leaves the pairs sorted by left then right.
+        std::vector<uint32_t> kerned;
+        for (uint32_t codepoint : codepoints) {
+            if (codepoint < KERNING_LIMIT) {
+                kerned.push_back(codepoint);
+            }
+        }
+        for (uint32_t left : kerned) {
+            for (uint32_t right : kerned) {
+                int amount = TTF_GetFontKerningSizeGlyphs32(font, left, right);
+                if (amount != 0) {
+                    face.kerning.push_back(BakedKerningRecord{left, right, (float)amount});
+                }
+            }
+        }
+    }
+    
+    closeFont(font);
+    printf("  %dpt: %zu glyphs, %zu kerning pairs\n", pointSize, face.glyphs.size(), face.kerning.size());
+    return true;
+}
+
+// Shelf-pack a face starting at row top; false if it runs off the page
+static bool packFace(BakedFace& face, int pageSize, int& top) {
+    std::vector<BakedGlyph*> order;
+    for (BakedGlyph& glyph : face.glyphs) {
+        order.push_back(&glyph);
+    }
+    std::sort(order.begin(), order.end(), [](const BakedGlyph* a, const BakedGlyph* b) {
+        return a->record.height > b->record.height;
+    });
+    
+    int x = 0, y = top, rowHeight = 0;
+    for (BakedGlyph* glyph : order) {
+        if (glyph->record.width == 0) {
+            continue;
+        }
+        
+        int width = glyph->record.width + GLYPH_PADDING;
+        int height = glyph->record.height + GLYPH_PADDING;
+        if (x + width > pageSize) {
+            x = 0;
+            y += rowHeight;
+            rowHeight = 0;
+        }
+        if (y + height > pageSize || width > pageSize) {
+            return false;
+        }
+        
+        glyph->record.x = (uint16_t)x;
+        glyph->record.y = (uint16_t)y;
+        x += width;
+        rowHeight = std::max(rowHeight, height);
+    }
+    top = y + rowHeight;
+    return true;
+}
+
+static int bake(const std::string& fontPath, const std::string& outputPath, const std::vector<int>& sizes,
+                const std::string& charset, int pageSize) {
+    std::string fontData;
+    if (!readFile(fontPath, fontData)) {
+        return 1;
+    }
+    
+    std::vector<uint32_t> codepoints;
+    if (!parseCharset(charset, codepoints)) {
+        return 1;
+    }
+    
+    if (TTF_Init() == -1) {
+        printf("SDL_ttf initialization failed: %s\n", TTF_GetError());
+        return 1;
+    }
+    
+    JobSystem jobs;
+    printf("Baking %s: %zu codepoints, %d worker threads\n", fontPath.c_str(), codepoints.size(), jobs.getWorkerCount());
+    
+    // Rasterize every size, then place faces on pages; a face never straddles pages
+    std::vector<BakedFace> faces(sizes.size());
+    uint32_t pageCount = 0;
+    int top = 0;
+    for (size_t i = 0; i < sizes.size(); i++) {
+        if (!bakeFace(fontData, sizes[i], codepoints, jobs, faces[i])) {
+            TTF_Quit();
+            return 1;
+        }
+        
+        // Continue below the previous face, or start a fresh page
+        if (pageCount == 0 || !packFace(faces[i], pageSize, top)) {
+            top = 0;
+            if (!packFace(faces[i], pageSize, top)) {
+                printf("%dpt face does not fit a %dx%d page, raise --page\n", sizes[i], pageSize, pageSize);
+                TTF_Quit();
+                return 1;
+            }
+            pageCount++;
+        }
+        faces[i].record.page = pageCount - 1;
+    }
+    TTF_Quit();
+    
+    // Lay out header, faces, glyph and kerning tables, then pages
+    BakedFontHeader header;
+    memcpy(header.magic, BAKED_FONT_MAGIC, sizeof(header.magic));
+    header.version = BAKED_FONT_VERSION;
+    header.faceCount = (uint32_t)faces.size();
+    header.pageCount = pageCount;
+    header.pageWidth = (uint32_t)pageSize;
+    header.pageHeight = (uint32_t)pageSize;
+    header.facesOffset = sizeof(BakedFontHeader);
+    
+    uint64_t offset = header.facesOffset + faces.size() * sizeof(BakedFaceRecord);
+    for (BakedFace& face : faces) {
+        face.record.glyphCount = (uint32_t)face.glyphs.size();
+        face.record.glyphsOffset = offset;
+        offset += face.glyphs.size() * sizeof(BakedGlyphRecord);
+        face.record.kerningCount = (uint32_t)face.kerning.size();
+        face.record.kerningOffset = offset;
+        offset += face.kerning.size() * sizeof(BakedKerningRecord);
+    }
+    header.pagesOffset = offset;
+    
+    std::vector<uint8_t> pages((size_t)pageCount * pageSize * pageSize, 0);
+    for (const BakedFace& face : faces) {
+        uint8_t* page = &pages[(size_t)face.record.page * pageSize * pageSize];
+        for (const BakedGlyph& glyph : face.glyphs) {
+            for (int row = 0; row < glyph.record.height; row++) {
+                memcpy(page + (size_t)(glyph.record.y + row) * pageSize + glyph.record.x,
+                       &glyph.alpha[(size_t)row * glyph.record.width], glyph.record.width);
+            }
+        }
+    }
+    
+    std::ofstream out(outputPath, std::ios::binary);
+    if (!out.is_open()) {
+        printf("Failed to create atlas: %s\n", outputPath.c_str());
+        return 1;
+    }
+    
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (const BakedFace& face : faces) {
+        out.write(reinterpret_cast<const char*>(&face.record), sizeof(face.record));
+    }
+    for (const BakedFace& face : faces) {
+        for (const BakedGlyph& glyph : face.glyphs) {
+            out.write(reinterpret_cast<const char*>(&glyph.record), sizeof(glyph.record));
+        }
+        out.write(reinterpret_cast<const char*>(face.kerning.data()), face.kerning.size() * sizeof(BakedKerningRecord));
+    }
+    out.write(reinterpret_cast<const char*>(pages.data()), pages.size());
+    
+    if (!out) {
+        printf("Failed to write atlas: %s\n", outputPath.c_str());
+        return 1;
+    }
+    
+    printf("Wrote %s (%zu faces, %u pages of %dx%d, %llu bytes)\n", outputPath.c_str(), faces.size(), pageCount,
+           pageSize, pageSize, (unsigned long long)(header.pagesOffset + pages.size()));
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        printf("Usage: %s <font.ttf> <output.ejfa> [--sizes 16,24,32] [--charset ascii|latin1|<utf8 file>] [--page 1024]\n", argv[0]);
+        return 1;
+    }
+    
+    std::vector<int> sizes;
+    std::string charset = "latin1";
+    int pageSize = 1024;
+    for (int i = 3; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--sizes") == 0) {
+            std::stringstream list(argv[i + 1]);
+            std::string size;
+            while (std::getline(list, size, ',')) {
+                sizes.push_back(atoi(size.c_str()));
+            }
+        } else if (strcmp(argv[i], "--charset") == 0) {
+            charset = argv[i + 1];
+        } else if (strcmp(argv[i], "--page") == 0) {
+            pageSize = atoi(argv[i + 1]);
+        } else {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (sizes.empty()) {
+        sizes.push_back(24);
+    }
+    if (pageSize <= 0 || pageSize > 65535) {
+        printf("Invalid page size: %d\n", pageSize);
+        return 1;
+    }
+    
+    return bake(argv[1], argv[2], sizes, charset, pageSize);
+}
\ No newline at end of file
@@ -0,0 +1,290 @@
+#include "../font_library.h"
+#include "../glyph_rasterizer.h"
+#include "../utf8.h"
+#include "../core/image_writer.h"
+#include "../core/job_system.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/resource.h>
+
+// Renders every line of a UTF-8 text file to its own image, without a window or GL context:
+//   label_renderer <font.ttf> <labels.txt> <outputDir> [--size 24] [--threads N] [--format png|tga] [--color RRGGBB]
+// Line n (from 0) is written to <outputDir>/label_<n>.<format>; empty lines are skipped.
+
+using LabelClock = std::chrono::steady_clock;
+
+// Lines held in memory at once; images are written as each one is rendered
+const size_t CHUNK_LINES = 4096;
+
+struct LabelOptions {
+    int pointSize = 24;
+    int threads = 0; // 0 picks hardware threads
+    std::string format = "png";
+    uint8_t color[3] = {255, 255, 255};
+};
+
+// Glyph coverage and advance, rasterized once per worker
+struct CachedGlyph {
+    int width = 0;
+    int height = 0;
+    int advance = 0;
+    std::vector<uint8_t> alpha;
+};
+
+// State owned by one job at a time: the font handle, its glyphs and scratch buffers
+struct LabelWorker {
+    TTF_Font* font = nullptr;
+    bool kerning = false;
+    int lineHeight = 0;
+    std::unordered_map<uint32_t, CachedGlyph> glyphs;
+    std::vector<uint32_t> codepoints;
+    std::vector<uint8_t> pixels;
+    size_t rendered = 0;
+};
+
+static bool readFile(const std::string& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        printf("Failed to open file: %s\n", path.c_str());
+        return false;
+    }
+    
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    out = buffer.str();
+    return true;
+}
+
+// Largest resident set so far; ru_maxrss is in bytes on macOS and kilobytes elsewhere
+static double peakMemoryMb() {
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0.0;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    return usage.ru_maxrss / 1024.0;
+#endif
+}
+
+static const CachedGlyph& getGlyph(LabelWorker& worker, uint32_t codepoint) {
+    auto it = worker.glyphs.find(codepoint);
+    if (it != worker.glyphs.end()) {
+        return it->second;
+    }
+    
+    CachedGlyph& glyph = worker.glyphs[codepoint];
+    TTF_GlyphMetrics32(worker.font, codepoint, nullptr, nullptr, nullptr, nullptr, &glyph.advance);
+    
+    // Same bitmaps the glyph atlas uploads; only coverage is kept
+    GlyphBitmap bitmap;
+    if (GlyphRasterizer::renderGlyph(worker.font, codepoint, bitmap)) {
+        glyph.width = bitmap.width;
+        glyph.height = bitmap.height;
+        glyph.alpha.resize((size_t)bitmap.width * bitmap.height);
+        for (size_t i = 0; i < glyph.alpha.size(); i++) {
+            glyph.alpha[i] = bitmap.pixels[i * 4 + 3];
+        }
+    }
+    return glyph;
+}
+
+// Lay out one line like TextRenderer::appendText (kerning, then the bitmap at the pen) and
+// composite it into worker.pixels; false for a line with nothing to draw
+static bool renderLabel(LabelWorker& worker, const std::string& text, const LabelOptions& options, int& width, int& height) {
+    worker.codepoints.resize(text.size());
+    worker.codepoints.resize(decodeUtf8(text, worker.codepoints.data()));
+    
+    // Measure first so the image is allocated once
+    width = 0;
+    int penX = 0;
+    uint32_t previous = 0;
+    for (uint32_t c : worker.codepoints) {
+        if (previous && worker.kerning) {
+            penX += TTF_GetFontKerningSizeGlyphs32(worker.font, previous, c);
+        }
+        const CachedGlyph& glyph = getGlyph(worker, c);
+        width = std::max(width, penX + glyph.width);
+        penX += glyph.advance;
+        previous = c;
+    }
+    width = std::max(width, penX);
+    height = worker.lineHeight;
+    if (width <= 0 || height <= 0) {
+        return false;
+    }
+    
+    // Straight-alpha text color; overlapping coverage combines as "over"
+    worker.pixels.assign((size_t)width * height * 4, 0);
+    for (size_t i = 0; i < (size_t)width * height; i++) {
+        memcpy(&worker.pixels[i * 4], options.color, 3);
+    }
+    
+    penX = 0;
+    previous = 0;
+    for (uint32_t c : worker.codepoints) {
+        if (previous && worker.kerning) {
+            penX += TTF_GetFontKerningSizeGlyphs32(worker.font, previous, c);
+        }
+        const CachedGlyph& glyph = getGlyph(worker, c);
+        for (int y = 0; y < glyph.height && y < height; y++) {
+            const uint8_t* source = &glyph.alpha[(size_t)y * glyph.width];
+            for (int x = 0; x < glyph.width; x++) {
+                int targetX = penX + x;
+                if (source[x] == 0 || targetX < 0 || targetX >= width) {
+                    continue;
+                }
+                uint8_t& alpha = worker.pixels[((size_t)y * width + targetX) * 4 + 3];
+                alpha = (uint8_t)(source[x] + alpha * (255 - source[x]) / 255);
+            }
+        }
+        penX += glyph.advance;
+        previous = c;
+    }
+    return true;
+}
+
+static int renderLabels(const std::string& fontPath, const std::string& labelsPath, const std::string& outputDir,
+                        const LabelOptions& options) {
+    std::string fontData;
+    if (!readFile(fontPath, fontData)) {
+        return 1;
+    }
+    
+    std::ifstream labels(labelsPath, std::ios::binary);
+    if (!labels.is_open()) {
+        printf("Failed to open labels: %s\n", labelsPath.c_str());
+        return 1;
+    }
+    
+    if (TTF_Init() == -1) {
+        printf("SDL_ttf initialization failed: %s\n", TTF_GetError());
+        return 1;
+    }
+    
+    int threads = options.threads > 0 ? options.threads : (int)std::thread::hardware_concurrency();
+    JobSystem jobs(std::max(1, threads) - 1);
+    
+    // A TTF_Font can't be shared between threads, so every worker opens its own
+    std::vector<LabelWorker> workers(jobs.getThreadCount());
+    bool opened = true;
+    for (LabelWorker& worker : workers) {
+        worker.font = openFontFromMemory(fontData.data(), fontData.size(), options.pointSize);
+        if (!worker.font) {
+            printf("Failed to load font: %s\n", TTF_GetError());
+            opened = false;
+            break;
+        }
+        worker.kerning = TTF_GetFontKerning(worker.font) != 0;
+        worker.lineHeight = TTF_FontHeight(worker.font);
+    }
+    
+    printf("Rendering %s at %dpt on %d threads into %s\n", labelsPath.c_str(), options.pointSize,
+           jobs.getThreadCount(), outputDir.c_str());
+    
+    size_t lineCount = 0;
+    std::atomic<bool> failed(!opened);
+    std::vector<std::string> chunk;
+    auto start = LabelClock::now();
+    
+    while (!failed && labels) {
+        chunk.clear();
+        std::string line;
+        while (chunk.size() < CHUNK_LINES && std::getline(labels, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            chunk.push_back(line);
+        }
+        if (chunk.empty()) {
+            break;
+        }
+        
+        // Each worker pulls the next line, so long and short labels balance out
+        size_t firstLine = lineCount;
+        std::atomic<size_t> next(0);
+        jobs.parallelFor(workers.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t w = begin; w < end; w++) {
+                LabelWorker& worker = workers[w];
+                std::string path;
+                for (size_t i = next++; i < chunk.size() && !failed; i = next++) {
+                    int width = 0, height = 0;
+                    if (!renderLabel(worker, chunk[i], options, width, height)) {
+                        continue;
+                    }
+                    path = outputDir + "/label_" + std::to_string(firstLine + i) + "." + options.format;
+                    if (!writeImage(path, width, height, worker.pixels.data())) {
+                        failed = true;
+                        break;
+                    }
+                    worker.rendered++;
+                }
+            }
+        });
+        lineCount += chunk.size();
+    }
+    double seconds = std::chrono::duration<double>(LabelClock::now() - start).count();
+    
+    size_t rendered = 0, glyphs = 0;
+    for (LabelWorker& worker : workers) {
+        rendered += worker.rendered;
+        glyphs += worker.glyphs.size();
+        closeFont(worker.font);
+    }
+    TTF_Quit();
+    
+    printf("Rendered %zu of %zu lines in %.2f s: %.0f strings/sec, %zu glyphs cached across workers, peak memory %.1f MB\n",
+           rendered, lineCount, seconds, seconds > 0.0 ? rendered / seconds : 0.0, glyphs, peakMemoryMb());
+    return failed ? 1 : 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 4) {
+        printf("Usage: %s <font.ttf> <labels.txt> <outputDir> [--size 24] [--threads N] [--format png|tga] [--color RRGGBB]\n", argv[0]);
+        return 1;
+    }
+    
+    LabelOptions options;
+    for (int i = 4; i < argc; i += 2) {
+        // Every option takes a value
+        if (i + 1 >= argc) {
+            printf("Missing value for option: %s\n", argv[i]);
+            return 1;
+        }
+        if (strcmp(argv[i], "--size") == 0) {
+            options.pointSize = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--threads") == 0) {
+            options.threads = atoi(argv[i + 1]);
+        } else if (strcmp(argv[i], "--format") == 0) {
+            options.format = argv[i + 1];
+        } else if (strcmp(argv[i], "--color") == 0) {
+            unsigned long rgb = strtoul(argv[i + 1], nullptr, 16);
+            options.color[0] = (uint8_t)(rgb >> 16);
+            options.color[1] = (uint8_t)(rgb >> 8);
+            options.color[2] = (uint8_t)rgb;
+        } else {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    if (options.pointSize <= 0) {
+        printf("Invalid point size: %d\n", options.pointSize);
+        return 1;
+    }
+    if (options.format != "png" && options.format != "tga") {
+        printf("Unknown format: %s\n", options.format.c_str());
+        return 1;
+    }
+    
+    return renderLabels(argv[1], argv[2], argv[3], options);
+}
\ No newline at end of file
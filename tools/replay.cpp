@@ -0,0 +1,133 @@
+#include "../core/job_system.h"
+#include "../graphics/graphics_factory.h"
+#include "../graphics/graphics_replay.h"
+#include "../platform/platform_factory.h"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Plays back a capture recorded with `app --capture <file> [frames]` as fast as possible:
+//   replay <capture.ejcap> [--gl] [--threads N] [--out last.png]
+// Without --gl the calls go to the software renderer, so no window or GPU is needed;
+// --gl opens a window and replays on OpenGL with vsync off. --out saves the last
+// software frame. Prints the time of every frame and a per-call breakdown.
+
+struct ReplayOptions {
+    bool gl = false;
+    int threads = 0; // 0 picks hardware threads
+    const char* outputPath = nullptr;
+};
+
+static void printReport(const GraphicsReplay& replay) {
+    const std::vector<double>& frames = replay.getFrameTimes();
+    printf("\n  frame        ms\n");
+    for (size_t i = 0; i < frames.size(); i++) {
+        printf("  %5zu  %8.3f%s\n", i, frames[i], i == 0 ? "  (includes startup)" : "");
+    }
+    
+    // Steady-state statistics leave out the startup frame
+    std::vector<double> sorted(frames.begin() + std::min<size_t>(1, frames.size()), frames.end());
+    if (!sorted.empty()) {
+        std::sort(sorted.begin(), sorted.end());
+        double total = 0.0;
+        for (double ms : sorted) {
+            total += ms;
+        }
+        printf("\n  frames 1-%zu: mean %.3f ms, median %.3f ms, p95 %.3f ms, max %.3f ms\n", sorted.size(),
+               total / sorted.size(), sorted[sorted.size() / 2], sorted[std::min(sorted.size() - 1, sorted.size() * 95 / 100)],
+               sorted.back());
+    }
+    
+    // Calls by total time
+    std::vector<CaptureOp> ops;
+    for (size_t i = 0; i < (size_t)CaptureOp::Count; i++) {
+        if (replay.getCallStats((CaptureOp)i).count) {
+            ops.push_back((CaptureOp)i);
+        }
+    }
+    std::sort(ops.begin(), ops.end(), [&](CaptureOp a, CaptureOp b) {
+        return replay.getCallStats(a).totalMs > replay.getCallStats(b).totalMs;
+    });
+    printf("\n  call                       count    total ms   us/call\n");
+    for (CaptureOp op : ops) {
+        const ReplayCallStats& stats = replay.getCallStats(op);
+        printf("  %-24s %8llu  %10.3f  %8.3f\n", getCaptureOpName(op), (unsigned long long)stats.count, stats.totalMs,
+               stats.totalMs * 1000.0 / stats.count);
+    }
+}
+
+static int replaySoftware(GraphicsReplay& replay, const ReplayOptions& options) {
+    int threads = options.threads > 0 ? options.threads : (int)std::thread::hardware_concurrency();
+    JobSystem jobs(std::max(1, threads) - 1);
+    std::unique_ptr<GraphicsSoftware> graphics = GraphicsFactory::createSoftware(replay.getWindowWidth(), replay.getWindowHeight(), &jobs);
+    printf("Replaying on %s with %d threads\n", graphics->getRendererName().c_str(), jobs.getThreadCount());
+    
+    // The platform sets the window viewport on resize, outside the capture
+    bool played = replay.play(graphics.get(), nullptr, [&](int width, int height) {
+        graphics->setWindowSize(width, height);
+        graphics->viewport(0, 0, width, height);
+    });
+    if (options.outputPath) {
+        graphics->saveFrame(options.outputPath);
+    }
+    return played ? 0 : 1;
+}
+
+static int replayGL(GraphicsReplay& replay) {
+    std::unique_ptr<Platform> platform = PlatformFactory::create();
+    if (!platform->initialize(replay.getWindowWidth(), replay.getWindowHeight(), "Endjinn replay")) {
+        return 1;
+    }
+    SDL_GL_SetSwapInterval(0);
+    
+    // The backend releases its GL objects before the context goes away
+    bool played;
+    {
+        std::unique_ptr<GraphicsAPI> graphics = GraphicsFactory::create();
+        printf("Replaying on %s\n", graphics->getRendererName().c_str());
+        played = replay.play(graphics.get(), [&]() {
+            platform->swapBuffers();
+        }, [&](int width, int height) {
+            platform->setWindowSize(width, height);
+            platform->setViewport(width, height);
+        });
+    }
+    platform->shutdown();
+    return played ? 0 : 1;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printf("Usage: %s <capture.ejcap> [--gl] [--threads N] [--out last.png]\n", argv[0]);
+        return 1;
+    }
+    
+    ReplayOptions options;
+    for (int i = 2; i < argc; i++) {
+        if (strcmp(argv[i], "--gl") == 0) {
+            options.gl = true;
+        } else if (strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            options.threads = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            options.outputPath = argv[++i];
+        } else {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+    
+    GraphicsReplay replay;
+    if (!replay.load(argv[1])) {
+        return 1;
+    }
+    printf("Capture %s: %d frames at %dx%d\n", argv[1], replay.getFrameCount(), replay.getWindowWidth(), replay.getWindowHeight());
+    
+    int result = options.gl ? replayGL(replay) : replaySoftware(replay, options);
+    printReport(replay);
+    return result;
+}
\ No newline at end of file
@@ -0,0 +1,76 @@
+#include "transform.h"
+#include <cmath>
+
+Mat4 Mat4::identity() {
+    Mat4 result = {};
+    result.m[0] = 1.0f;
+    result.m[5] = 1.0f;
+    result.m[10] = 1.0f;
+    result.m[15] = 1.0f;
+    return result;
+}
+
+Mat4 Mat4::ortho(float left, float right, float bottom, float top) {
+    Mat4 result = identity();
+    result.m[0] = 2.0f / (right - left);
+    result.m[5] = 2.0f / (top - bottom);
+    result.m[10] = -1.0f;
+    result.m[12] = -(right + left) / (right - left);
+    result.m[13] = -(top + bottom) / (top - bottom);
+    return result;
+}
+
+Mat4 Mat4::translation(float x, float y) {
+    Mat4 result = identity();
+    result.m[12] = x;
+    result.m[13] = y;
+    return result;
+}
+
+Mat4 Mat4::scale(float x, float y) {
+    Mat4 result = identity();
+    result.m[0] = x;
+    result.m[5] = y;
+    return result;
+}
+
+Mat4 Mat4::rotationZ(float radians) {
+    Mat4 result = identity();
+    float c = std::cos(radians);
+    float s = std::sin(radians);
+    result.m[0] = c;
+    result.m[1] = s;
+    result.m[4] = -s;
+    result.m[5] = c;
+    return result;
+}
+
+Mat4 Mat4::operator*(const Mat4& other) const {
+    Mat4 result;
+    for (int column = 0; column < 4; column++) {
+        for (int row = 0; row < 4; row++) {
+            float sum = 0.0f;
+            for (int k = 0; k < 4; k++) {
+                sum += m[k * 4 + row] * other.m[column * 4 + k];
+            }
+            result.m[column * 4 + row] = sum;
+        }
+    }
+    return result;
+}
+
+Mat4 Transform2D::toMatrix() const {
+    return Mat4::translation(x + originX, y + originY) *
+           Mat4::rotationZ(rotation) *
+           Mat4::scale(scale, scale) *
+           Mat4::translation(-originX, -originY);
+}
+
+bool Transform2D::isIdentity() const {
+    return x == 0.0f && y == 0.0f && scale == 1.0f && rotation == 0.0f;
+}
+
+bool Transform2D::operator==(const Transform2D& other) const {
+    return x == other.x && y == other.y && scale == other.scale && rotation == other.rotation &&
+           originX == other.originX && originY == other.originY;
+}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+
+// Column-major 4x4 matrix, laid out the way glUniformMatrix4fv expects
+struct Mat4 {
+    float m[16];
+    
+    static Mat4 identity();
+    static Mat4 ortho(float left, float right, float bottom, float top);
+    static Mat4 translation(float x, float y);
+    static Mat4 scale(float x, float y);
+    static Mat4 rotationZ(float radians);
+    
+    Mat4 operator*(const Mat4& other) const;
+};
+
+// 2D placement of a batch in pixel space: scale and rotate about the origin
+// point, then translate
+struct Transform2D {
+    float x = 0.0f;
+    float y = 0.0f;
+    float scale = 1.0f;
+    float rotation = 0.0f; // Radians, clockwise on screen
+    float originX = 0.0f;
+    float originY = 0.0f;
+    
+    Mat4 toMatrix() const;
+    bool isIdentity() const;
+    bool operator==(const Transform2D& other) const;
+    bool operator!=(const Transform2D& other) const { return !(*this == other); }
+};
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "utf8.h"
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+uint32_t decodeUtf8Sequence(std::string_view text, size_t& pos) {
+    unsigned char lead = text[pos];
+    int length;
+    uint32_t codepoint;
+    uint32_t minimum;
+    if ((lead & 0xE0) == 0xC0) {
+        length = 2;
+        codepoint = lead & 0x1F;
+        minimum = 0x80;
+    } else if ((lead & 0xF0) == 0xE0) {
+        length = 3;
+        codepoint = lead & 0x0F;
+        minimum = 0x800;
+    } else if ((lead & 0xF8) == 0xF0) {
+        length = 4;
+        codepoint = lead & 0x07;
+        minimum = 0x10000;
+    } else {
+        pos++; // Stray continuation byte or invalid lead
+        return UTF8_REPLACEMENT;
+    }
+    
+    if (pos + length > text.size()) {
+        pos++;
+        return UTF8_REPLACEMENT;
+    }
+    for (int i = 1; i < length; i++) {
+        unsigned char next = text[pos + i];
+        if ((next & 0xC0) != 0x80) {
+            pos++;
+            return UTF8_REPLACEMENT;
+        }
+        codepoint = codepoint << 6 | (next & 0x3F);
+    }
+    
+    // Reject overlong forms, surrogates and values past Unicode
+    if (codepoint < minimum || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+        pos++;
+        return UTF8_REPLACEMENT;
+    }
+    pos += length;
+    return codepoint;
+}
+
+size_t asciiPrefixLength(const char* data, size_t size) {
+    size_t i = 0;
+#if defined(__SSE2__)
+    // movemask collects the high bit of each byte
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        if (_mm_movemask_epi8(chunk) != 0) {
+            break;
+        }
+    }
+#endif
+    for (; i + 8 <= size; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        if (word & 0x8080808080808080ull) {
+            break;
+        }
+    }
+    while (i < size && (unsigned char)data[i] < 0x80) {
+        i++;
+    }
+    return i;
+}
+
+size_t decodeUtf8(std::string_view text, uint32_t* out) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    size_t size = text.size();
+    size_t count = 0;
+    size_t pos = 0;
+    while (pos < size) {
+        // A full ASCII word starts a run worth scanning and widening in one
+        // loop; mixed text falls through per codepoint, so short runs between
+        // multi-byte characters don't pay for the scan
+        if (pos + 8 <= size) {
+            uint64_t word;
+            memcpy(&word, bytes + pos, sizeof(word));
+            if ((word & 0x8080808080808080ull) == 0) {
+                size_t run = 8 + asciiPrefixLength(text.data() + pos + 8, size - pos - 8);
+                for (size_t i = 0; i < run; i++) {
+                    out[count + i] = bytes[pos + i];
+                }
+                count += run;
+                pos += run;
+                continue;
+            }
+        }
+        
+        if (bytes[pos] < 0x80) {
+            out[count++] = bytes[pos++];
+        } else {
+            out[count++] = decodeUtf8Sequence(text, pos);
+        }
+    }
+    return count;
+}
+
+size_t countCodepoints(std::string_view text) {
+    size_t count = 0;
+    for (unsigned char c : text) {
+        count += (c & 0xC0) != 0x80;
+    }
+    return count;
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+const uint32_t UTF8_REPLACEMENT = 0xFFFD;
+
+// Multi-byte path of nextCodepoint; invalid or truncated sequences decode as
+// U+FFFD and consume one byte so decoding always makes progress
+uint32_t decodeUtf8Sequence(std::string_view text, size_t& pos);
+
+// Decode the codepoint at pos and advance past it. ASCII stays on the inline
+// branch, so Latin text costs the same as the old byte loops.
+inline uint32_t nextCodepoint(std::string_view text, size_t& pos) {
+    unsigned char c = text[pos];
+    if (c < 0x80) {
+        pos++;
+        return c;
+    }
+    return decodeUtf8Sequence(text, pos);
+}
+
+// Number of leading ASCII bytes, checked 16 (SSE2) or 8 (word) bytes at a time
+size_t asciiPrefixLength(const char* data, size_t size);
+
+// Bulk decode into out, which needs room for text.size() codepoints; ASCII
+// runs are widened a word at a time. Returns the codepoint count.
+size_t decodeUtf8(std::string_view text, uint32_t* out);
+
+// Codepoints in text without decoding them (continuation bytes are skipped)
+size_t countCodepoints(std::string_view text);
\ No newline at end of file